@@ -2,12 +2,75 @@
 #include <cppfig/cppfig.h>
 #include <cppfig/json.h>
 
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
 #include <cstdlib>
 #include <filesystem>
+#include <memory>
+#include <new>
 #include <numbers>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace {
+
+/// @brief Heap allocations made by the current thread (see @c ReportAllocations).
+thread_local std::uint64_t t_allocations = 0;
+
+}  // namespace
+
+// Counting allocation hook: every benchmark can report allocations per
+// iteration without an external profiler.  The aligned forms are replaced
+// too, since they do not go through the plain ones (the cache-line-aligned
+// stripe and metrics types allocate through them); the array and nothrow
+// forms forward to these.
+auto operator new(std::size_t size) -> void*
+{
+    ++t_allocations;
+    if (void* pointer = std::malloc(size != 0 ? size : 1)) {
+        return pointer;
+    }
+    throw std::bad_alloc();
+}
+
+auto operator new(std::size_t size, std::align_val_t alignment) -> void*
+{
+    ++t_allocations;
+    const auto align = static_cast<std::size_t>(alignment);
+    // aligned_alloc requires a size that is a multiple of the alignment
+    const std::size_t rounded = (std::max<std::size_t>(size, 1) + align - 1) / align * align;
+    if (void* pointer = std::aligned_alloc(align, rounded)) {
+        return pointer;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* pointer) noexcept { std::free(pointer); }
+
+void operator delete(void* pointer, std::size_t /*size*/) noexcept { std::free(pointer); }
+
+void operator delete(void* pointer, std::align_val_t /*alignment*/) noexcept { std::free(pointer); }
+
+void operator delete(void* pointer, std::size_t /*size*/, std::align_val_t /*alignment*/) noexcept { std::free(pointer); }
 
 namespace cppfig::bench {
 
+/// @brief Returns the allocation count of the calling thread, to pass to @c ReportAllocations.
+auto AllocationsSoFar() -> std::uint64_t { return t_allocations; }
+
+/// @brief Reports the allocations made by the calling thread since @p start as "allocs/op".
+///
+/// Call right after the timed loop; counts of all benchmark threads are
+/// summed and divided by the total number of iterations.
+void ReportAllocations(benchmark::State& state, std::uint64_t start)
+{
+    state.counters["allocs/op"] = benchmark::Counter(static_cast<double>(t_allocations - start), benchmark::Counter::kAvgIterations);
+}
+
 namespace settings {
 
     struct StringSetting {
@@ -38,7 +101,7 @@ namespace settings {
         static constexpr std::string_view path = "benchmark.validated";
         using value_type = int;
         static auto default_value() -> int { return 50; }
-        static auto validator() -> Validator<int> { return Range(0, 100); }
+        static auto validator() { return Range(0, 100); }
     };
 
     struct EnvOverrideSetting {
@@ -158,6 +221,55 @@ BENCHMARK_DEFINE_F(BenchmarkFixture, GetInt)(benchmark::State& state)
 }
 BENCHMARK_REGISTER_F(BenchmarkFixture, GetInt);
 
+BENCHMARK_DEFINE_F(BenchmarkFixture, GetIntCached)(benchmark::State& state)
+{
+    const std::string path = CreateTempFile();
+    Configuration<MediumSchema> config(path);
+    (void)config.Load();
+    auto cached = config.Cached<settings::IntSetting>();
+
+    for (auto _ : state) {
+        auto value = *cached;
+        benchmark::DoNotOptimize(value);
+    }
+
+    RemoveFile(path);
+}
+BENCHMARK_REGISTER_F(BenchmarkFixture, GetIntCached);
+
+BENCHMARK_DEFINE_F(BenchmarkFixture, GetEnvOverride)(benchmark::State& state)
+{
+    const std::string path = CreateTempFile();
+    setenv("BENCHMARK_ENV_SETTING", "from_env", 1);
+    Configuration<LargeSchema> config(path);
+    (void)config.Load();
+
+    for (auto _ : state) {
+        auto value = config.Get<settings::EnvOverrideSetting>();
+        benchmark::DoNotOptimize(value);
+    }
+
+    unsetenv("BENCHMARK_ENV_SETTING");
+    RemoveFile(path);
+}
+BENCHMARK_REGISTER_F(BenchmarkFixture, GetEnvOverride);
+
+BENCHMARK_DEFINE_F(BenchmarkFixture, GetStringCached)(benchmark::State& state)
+{
+    const std::string path = CreateTempFile();
+    Configuration<SmallSchema> config(path);
+    (void)config.Load();
+    auto cached = config.Cached<settings::StringSetting>();
+
+    for (auto _ : state) {
+        const auto& value = *cached;
+        benchmark::DoNotOptimize(&value);
+    }
+
+    RemoveFile(path);
+}
+BENCHMARK_REGISTER_F(BenchmarkFixture, GetStringCached);
+
 BENCHMARK_DEFINE_F(BenchmarkFixture, GetDouble)(benchmark::State& state)
 {
     const std::string path = CreateTempFile();
@@ -203,6 +315,22 @@ BENCHMARK_DEFINE_F(BenchmarkFixture, GetValidated)(benchmark::State& state)
 }
 BENCHMARK_REGISTER_F(BenchmarkFixture, GetValidated);
 
+BENCHMARK_DEFINE_F(BenchmarkFixture, GetByPath)(benchmark::State& state)
+{
+    const std::string path = CreateTempFile();
+    Configuration<LargeSchema> config(path);
+    (void)config.Load();
+    const IConfigurationProviderVirtual& virtual_config = config;
+
+    for (auto _ : state) {
+        auto value = virtual_config.GetByPath("database.connection.port");
+        benchmark::DoNotOptimize(value);
+    }
+
+    RemoveFile(path);
+}
+BENCHMARK_REGISTER_F(BenchmarkFixture, GetByPath);
+
 BENCHMARK_DEFINE_F(BenchmarkFixture, SetString)(benchmark::State& state)
 {
     const std::string path = CreateTempFile();
@@ -251,6 +379,73 @@ BENCHMARK_DEFINE_F(BenchmarkFixture, SetValidated)(benchmark::State& state)
 }
 BENCHMARK_REGISTER_F(BenchmarkFixture, SetValidated);
 
+BENCHMARK_DEFINE_F(BenchmarkFixture, SetBatchIndividually)(benchmark::State& state)
+{
+    const std::string path = CreateTempFile();
+    Configuration<LargeSchema, ConfSerializer, MultiThreadedPolicy> config(path);
+    (void)config.Load();
+
+    int counter = 0;
+    for (auto _ : state) {
+        ++counter;
+        (void)config.Set<settings::IntSetting>(counter);
+        (void)config.Set<settings::DatabasePort>(counter);
+        (void)config.Set<settings::CacheSize>(counter);
+        (void)config.Set<settings::DatabaseHost>("db.example.com");
+        (void)config.Set<settings::LogLevel>("debug");
+        (void)config.Set<settings::CacheEnabled>(counter % 2 == 0);
+    }
+
+    RemoveFile(path);
+}
+BENCHMARK_REGISTER_F(BenchmarkFixture, SetBatchIndividually);
+
+BENCHMARK_DEFINE_F(BenchmarkFixture, SetBatchTransaction)(benchmark::State& state)
+{
+    const std::string path = CreateTempFile();
+    Configuration<LargeSchema, ConfSerializer, MultiThreadedPolicy> config(path);
+    (void)config.Load();
+
+    int counter = 0;
+    for (auto _ : state) {
+        ++counter;
+        auto status = config.Transaction()
+                          .Set<settings::IntSetting>(counter)
+                          .Set<settings::DatabasePort>(counter)
+                          .Set<settings::CacheSize>(counter)
+                          .Set<settings::DatabaseHost>("db.example.com")
+                          .Set<settings::LogLevel>("debug")
+                          .Set<settings::CacheEnabled>(counter % 2 == 0)
+                          .Commit();
+        benchmark::DoNotOptimize(status);
+    }
+
+    RemoveFile(path);
+}
+BENCHMARK_REGISTER_F(BenchmarkFixture, SetBatchTransaction);
+
+/// @brief Thread 0 keeps setting cache.size_mb while the other threads read database.connection.port.
+template <typename Policy>
+void GetWhileSettingOtherSection(benchmark::State& state)
+{
+    static Configuration<LargeSchema, ConfSerializer, Policy> config(
+        (std::filesystem::temp_directory_path() / "cppfig_benchmark_sharded.conf").string());
+
+    int counter = 0;
+    for (auto _ : state) {
+        if (state.thread_index() == 0) {
+            auto status = config.template Set<settings::CacheSize>(++counter);
+            benchmark::DoNotOptimize(status);
+        }
+        else {
+            auto port = config.template Get<settings::DatabasePort>();
+            benchmark::DoNotOptimize(port);
+        }
+    }
+}
+BENCHMARK_TEMPLATE(GetWhileSettingOtherSection, MultiThreadedPolicy)->Threads(4);
+BENCHMARK_TEMPLATE(GetWhileSettingOtherSection, ShardedPolicy<>)->Threads(4);
+
 BENCHMARK_DEFINE_F(BenchmarkFixture, LoadSmallSchema)(benchmark::State& state)
 {
     const std::string path = CreateTempFile();
@@ -314,6 +509,85 @@ BENCHMARK_DEFINE_F(BenchmarkFixture, LoadLargeSchema)(benchmark::State& state)
 }
 BENCHMARK_REGISTER_F(BenchmarkFixture, LoadLargeSchema);
 
+BENCHMARK_DEFINE_F(BenchmarkFixture, LoadSnapshotLargeSchema)(benchmark::State& state)
+{
+    const std::string path = CreateTempFile();
+    const std::string snapshot_path = path + ".bin";
+
+    // Create initial file and its snapshot
+    {
+        Configuration<LargeSchema> config(path);
+        (void)config.LoadSnapshot(snapshot_path);
+    }
+
+    for (auto _ : state) {
+        Configuration<LargeSchema> config(path);
+        auto status = config.LoadSnapshot(snapshot_path);
+        benchmark::DoNotOptimize(status);
+    }
+
+    RemoveFile(snapshot_path);
+    RemoveFile(path);
+}
+BENCHMARK_REGISTER_F(BenchmarkFixture, LoadSnapshotLargeSchema);
+
+BENCHMARK_DEFINE_F(BenchmarkFixture, LayeredGetInt)(benchmark::State& state)
+{
+    // Eight layers, each overriding the previous one
+    std::vector<ConfigLayer> layers;
+    for (int layer = 0; layer < 8; ++layer) {
+        auto values = Value::Object();
+        values.SetAtPath(settings::IntSetting::path, layer);
+        layers.push_back(ConfigLayer::Values("layer" + std::to_string(layer), std::move(values)));
+    }
+    LayeredConfiguration<MediumSchema> config(std::move(layers));
+    (void)config.Load();
+
+    for (auto _ : state) {
+        auto value = config.Get<settings::IntSetting>();
+        benchmark::DoNotOptimize(value);
+    }
+}
+BENCHMARK_REGISTER_F(BenchmarkFixture, LayeredGetInt);
+
+BENCHMARK_DEFINE_F(BenchmarkFixture, LayeredLoadFragments)(benchmark::State& state)
+{
+    auto directory = std::filesystem::path(CreateTempFile()).replace_extension(".d");
+    std::filesystem::create_directories(directory);
+    for (int fragment = 0; fragment < 32; ++fragment) {
+        auto values = Value::Object();
+        values.SetAtPath("fragment" + std::to_string(fragment) + ".database.host", "localhost");
+        values.SetAtPath(settings::IntSetting::path, fragment);
+        (void)WriteFile<ConfSerializer>((directory / (std::to_string(10 + fragment) + ".conf")).string(), values);
+    }
+
+    const auto policy = state.range(0) != 0 ? ExecutionPolicy::kParallel : ExecutionPolicy::kSequential;
+    LayeredConfiguration<LargeSchema> config({ ConfigLayer::Directory(directory.string()) });
+    for (auto _ : state) {
+        auto status = config.Load(policy);
+        benchmark::DoNotOptimize(status);
+    }
+
+    std::filesystem::remove_all(directory);
+}
+BENCHMARK_REGISTER_F(BenchmarkFixture, LayeredLoadFragments)->Arg(0)->Arg(1);
+
+BENCHMARK_DEFINE_F(BenchmarkFixture, ReloadUnchangedLargeSchema)(benchmark::State& state)
+{
+    const std::string path = CreateTempFile();
+
+    Configuration<LargeSchema, ConfSerializer, MultiThreadedPolicy> config(path);
+    (void)config.Load();
+
+    for (auto _ : state) {
+        auto status = config.Reload();
+        benchmark::DoNotOptimize(status);
+    }
+
+    RemoveFile(path);
+}
+BENCHMARK_REGISTER_F(BenchmarkFixture, ReloadUnchangedLargeSchema);
+
 BENCHMARK_DEFINE_F(BenchmarkFixture, SaveSmallSchema)(benchmark::State& state)
 {
     const std::string path = CreateTempFile();
@@ -438,6 +712,97 @@ BENCHMARK_DEFINE_F(BenchmarkFixture, DiffWithChanges)(benchmark::State& state)
 }
 BENCHMARK_REGISTER_F(BenchmarkFixture, DiffWithChanges);
 
+BENCHMARK_DEFINE_F(BenchmarkFixture, ConfSerializerParse)(benchmark::State& state)
+{
+    std::string conf_str;
+    for (int section = 0; section < 100; ++section) {
+        const std::string prefix = "section" + std::to_string(section) + ".group.";
+        conf_str += prefix + "name = value" + std::to_string(section) + "\n";
+        conf_str += prefix + "port = " + std::to_string(8000 + section) + "\n";
+        conf_str += prefix + "ratio = 0.75\n";
+        conf_str += prefix + "enabled = true\n";
+    }
+
+    for (auto _ : state) {
+        auto result = ConfSerializer::ParseString(conf_str);
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(conf_str.size()));
+}
+BENCHMARK_REGISTER_F(BenchmarkFixture, ConfSerializerParse);
+
+BENCHMARK_DEFINE_F(BenchmarkFixture, ConfSerializerParseList)(benchmark::State& state)
+{
+    std::string conf_str = "upstream.weights = [";
+    for (int i = 0; i < 1000; ++i) {
+        conf_str += (i == 0 ? "" : ", ") + std::to_string(i * 7);
+    }
+    conf_str += "]\n";
+
+    for (auto _ : state) {
+        auto result = ConfSerializer::ParseString(conf_str);
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(conf_str.size()));
+}
+BENCHMARK_REGISTER_F(BenchmarkFixture, ConfSerializerParseList);
+
+BENCHMARK_DEFINE_F(BenchmarkFixture, VectorDeserialize)(benchmark::State& state)
+{
+    std::vector<std::int64_t> weights(1000);
+    for (std::size_t i = 0; i < weights.size(); ++i) {
+        weights[i] = static_cast<std::int64_t>(i * 7);
+    }
+    const Value value = ConfigTraits<std::vector<std::int64_t>>::Serialize(weights);
+
+    for (auto _ : state) {
+        auto result = ConfigTraits<std::vector<std::int64_t>>::Deserialize(value);
+        benchmark::DoNotOptimize(result);
+    }
+}
+BENCHMARK_REGISTER_F(BenchmarkFixture, VectorDeserialize);
+
+BENCHMARK_DEFINE_F(BenchmarkFixture, ConfSerializerStringify)(benchmark::State& state)
+{
+    auto value = Value::Object();
+    for (int section = 0; section < 100; ++section) {
+        const std::string prefix = "section" + std::to_string(section) + ".group.";
+        value.SetAtPath(prefix + "name", "value" + std::to_string(section));
+        value.SetAtPath(prefix + "port", 8000 + section);
+        value.SetAtPath(prefix + "ratio", 0.75);
+        value.SetAtPath(prefix + "enabled", true);
+    }
+
+    std::size_t bytes = 0;
+    for (auto _ : state) {
+        auto result = ConfSerializer::Stringify(value);
+        bytes = result.size();
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(bytes));
+}
+BENCHMARK_REGISTER_F(BenchmarkFixture, ConfSerializerStringify);
+
+BENCHMARK_DEFINE_F(BenchmarkFixture, BinarySerializerParse)(benchmark::State& state)
+{
+    auto values = Value::Object();
+    for (int section = 0; section < 100; ++section) {
+        const std::string prefix = "section" + std::to_string(section) + ".group.";
+        values.SetAtPath(prefix + "name", "value" + std::to_string(section));
+        values.SetAtPath(prefix + "port", 8000 + section);
+        values.SetAtPath(prefix + "ratio", 0.75);
+        values.SetAtPath(prefix + "enabled", true);
+    }
+    const std::string binary_str = BinarySerializer::Stringify(values);
+
+    for (auto _ : state) {
+        auto result = BinarySerializer::ParseBuffer(binary_str);
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(binary_str.size()));
+}
+BENCHMARK_REGISTER_F(BenchmarkFixture, BinarySerializerParse);
+
 BENCHMARK_DEFINE_F(BenchmarkFixture, JsonSerializerParse)(benchmark::State& state)
 {
     const std::string json_str = R"({
@@ -493,6 +858,59 @@ BENCHMARK_DEFINE_F(BenchmarkFixture, ValueGetAtPath)(benchmark::State& state)
 }
 BENCHMARK_REGISTER_F(BenchmarkFixture, ValueGetAtPath);
 
+BENCHMARK_DEFINE_F(BenchmarkFixture, ValueFindAtPath)(benchmark::State& state)
+{
+    auto value = Value::Object();
+    value.SetAtPath("database.connection.host", Value("localhost"));
+    value.SetAtPath("database.connection.port", Value(5432));
+    const std::string path = "database.connection.host";
+
+    for (auto _ : state) {
+        const Value* result = value.FindAtPath(path);
+        benchmark::DoNotOptimize(result);
+    }
+}
+BENCHMARK_REGISTER_F(BenchmarkFixture, ValueFindAtPath);
+
+namespace {
+
+    /// @brief Builds a 20k-leaf tree (200 sections of 100 keys), the size of a large schema.
+    auto MakeLargeTree() -> Value
+    {
+        auto value = Value::Object();
+        for (int section = 0; section < 200; ++section) {
+            for (int key = 0; key < 100; ++key) {
+                value.SetAtPath("section" + std::to_string(section) + ".key" + std::to_string(key), Value(key));
+            }
+        }
+        return value;
+    }
+
+}  // namespace
+
+BENCHMARK_DEFINE_F(BenchmarkFixture, ValueFindAtPathLargeTree)(benchmark::State& state)
+{
+    const Value value = MakeLargeTree();
+    const std::string path = "section123.key45";
+
+    for (auto _ : state) {
+        const Value* result = value.FindAtPath(path);
+        benchmark::DoNotOptimize(result);
+    }
+}
+BENCHMARK_REGISTER_F(BenchmarkFixture, ValueFindAtPathLargeTree);
+
+BENCHMARK_DEFINE_F(BenchmarkFixture, ValueCopyLargeTree)(benchmark::State& state)
+{
+    const Value value = MakeLargeTree();
+
+    for (auto _ : state) {
+        Value copy = value;
+        benchmark::DoNotOptimize(copy);
+    }
+}
+BENCHMARK_REGISTER_F(BenchmarkFixture, ValueCopyLargeTree);
+
 BENCHMARK_DEFINE_F(BenchmarkFixture, ValueSetAtPath)(benchmark::State& state)
 {
     auto value = Value::Object();
@@ -554,6 +972,457 @@ BENCHMARK_DEFINE_F(BenchmarkFixture, TraitsDeserializeString)(benchmark::State&
 }
 BENCHMARK_REGISTER_F(BenchmarkFixture, TraitsDeserializeString);
 
+// ---------------------------------------------------------------------------
+// Scaling sweeps
+// ---------------------------------------------------------------------------
+
+namespace generated {
+
+    /// @brief Null-padded storage of a generated setting path.
+    struct PathStorage {
+        std::array<char, 160> text {};
+        std::size_t length = 0;
+    };
+
+    /// @brief Path of generated setting @p index at @p depth: "s<index / 100>.l1.l2...k<index>".
+    constexpr auto MakePath(std::size_t index, std::size_t depth) -> PathStorage
+    {
+        PathStorage path;
+        auto append_number = [&path](std::size_t number) {
+            std::array<char, 20> digits {};
+            std::size_t count = 0;
+            do {
+                digits[count++] = static_cast<char>('0' + (number % 10));
+                number /= 10;
+            } while (number != 0);
+            while (count != 0) {
+                path.text[path.length++] = digits[--count];
+            }
+        };
+        for (std::size_t level = 0; level + 1 < depth; ++level) {
+            path.text[path.length++] = level == 0 ? 's' : 'l';
+            append_number(level == 0 ? index / 100 : level);
+            path.text[path.length++] = '.';
+        }
+        path.text[path.length++] = 'k';
+        append_number(index);
+        return path;
+    }
+
+    /// @brief Runtime twin of @c MakePath.
+    auto PathString(std::size_t index, std::size_t depth) -> std::string
+    {
+        const PathStorage path = MakePath(index, depth);
+        return { path.text.data(), path.length };
+    }
+
+    template <std::size_t I>
+    struct IntSetting {
+        static constexpr PathStorage storage = MakePath(I, 2);
+        static constexpr std::string_view path { storage.text.data(), storage.length };
+        using value_type = int;
+        static auto default_value() -> int { return static_cast<int>(I); }
+    };
+
+    template <std::size_t... I>
+    auto MakeSchema(std::index_sequence<I...> /*indices*/) -> ConfigSchema<IntSetting<I>...>;
+
+    /// @brief Schema of @p N int settings spread over sections of 100.
+    ///
+    /// Typed schemas stop at 128 settings: compile time grows quickly with
+    /// the pack size and std::tuple hits the template instantiation depth
+    /// below a thousand.  Larger configurations are covered by the runtime
+    /// sweeps below.
+    template <std::size_t N>
+    using Schema = decltype(MakeSchema(std::make_index_sequence<N> {}));
+
+    /// @brief A .conf document of @p count int settings at @p depth.
+    auto MakeConf(std::size_t count, std::size_t depth = 2) -> std::string
+    {
+        auto values = Value::Object();
+        for (std::size_t i = 0; i < count; ++i) {
+            values.SetAtPath(PathString(i, depth), Value(static_cast<std::int64_t>(i)));
+        }
+        return ConfSerializer::Stringify(values);
+    }
+
+}  // namespace generated
+
+template <std::size_t N>
+void ConstructSchemaScaling(benchmark::State& state)
+{
+    const std::string path = (std::filesystem::temp_directory_path() / "cppfig_benchmark_construct.conf").string();
+    const auto allocations = AllocationsSoFar();
+    for (auto _ : state) {
+        Configuration<generated::Schema<N>> config(path);
+        benchmark::DoNotOptimize(config);
+    }
+    ReportAllocations(state, allocations);
+}
+BENCHMARK_TEMPLATE(ConstructSchemaScaling, 8);
+BENCHMARK_TEMPLATE(ConstructSchemaScaling, 32);
+BENCHMARK_TEMPLATE(ConstructSchemaScaling, 128);
+
+template <std::size_t N>
+void LoadSchemaScaling(benchmark::State& state)
+{
+    const std::string path = (std::filesystem::temp_directory_path() / ("cppfig_benchmark_load" + std::to_string(N) + ".conf")).string();
+    {
+        Configuration<generated::Schema<N>> config(path);
+        (void)config.Load();
+    }
+
+    const auto allocations = AllocationsSoFar();
+    for (auto _ : state) {
+        Configuration<generated::Schema<N>> config(path);
+        auto status = config.Load();
+        benchmark::DoNotOptimize(status);
+    }
+    ReportAllocations(state, allocations);
+    std::filesystem::remove(path);
+}
+BENCHMARK_TEMPLATE(LoadSchemaScaling, 8);
+BENCHMARK_TEMPLATE(LoadSchemaScaling, 32);
+BENCHMARK_TEMPLATE(LoadSchemaScaling, 128);
+
+template <std::size_t N>
+void GetSchemaScaling(benchmark::State& state)
+{
+    Configuration<generated::Schema<N>> config((std::filesystem::temp_directory_path() / "cppfig_benchmark_get.conf").string());
+
+    const auto allocations = AllocationsSoFar();
+    for (auto _ : state) {
+        auto value = config.template Get<generated::IntSetting<N / 2>>();
+        benchmark::DoNotOptimize(value);
+    }
+    ReportAllocations(state, allocations);
+}
+BENCHMARK_TEMPLATE(GetSchemaScaling, 8);
+BENCHMARK_TEMPLATE(GetSchemaScaling, 32);
+BENCHMARK_TEMPLATE(GetSchemaScaling, 128);
+
+/// @brief Parses a .conf file of state.range(0) settings (10 to 100k).
+void ConfParseScaling(benchmark::State& state)
+{
+    const std::string conf = generated::MakeConf(static_cast<std::size_t>(state.range(0)));
+
+    const auto allocations = AllocationsSoFar();
+    for (auto _ : state) {
+        auto result = ConfSerializer::ParseString(conf);
+        benchmark::DoNotOptimize(result);
+    }
+    ReportAllocations(state, allocations);
+    state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(conf.size()));
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(ConfParseScaling)->RangeMultiplier(10)->Range(10, 100'000)->Complexity();
+
+/// @brief Reloads a changed file of state.range(0) settings under a fixed schema.
+void ReloadFileScaling(benchmark::State& state)
+{
+    const std::string path = (std::filesystem::temp_directory_path() / "cppfig_benchmark_reload_scaling.conf").string();
+    const auto count = static_cast<std::size_t>(state.range(0));
+    std::array<Value, 2> versions {};
+    for (std::size_t version = 0; version < versions.size(); ++version) {
+        auto parsed = ConfSerializer::ParseString(generated::MakeConf(count));
+        versions[version] = *std::move(parsed);
+        versions[version].SetAtPath(settings::IntSetting::path, Value(static_cast<int>(version)));
+    }
+    (void)WriteFile<ConfSerializer>(path, versions[0]);
+    Configuration<MediumSchema, ConfSerializer, MultiThreadedPolicy> config(path);
+    (void)config.Reload();
+
+    std::size_t version = 0;
+    for (auto _ : state) {
+        state.PauseTiming();
+        version ^= 1U;
+        (void)WriteFile<ConfSerializer>(path, versions[version]);
+        state.ResumeTiming();
+        auto status = config.Reload();
+        benchmark::DoNotOptimize(status);
+    }
+    state.SetComplexityN(state.range(0));
+    std::filesystem::remove(path);
+}
+BENCHMARK(ReloadFileScaling)->RangeMultiplier(10)->Range(10, 100'000)->Complexity();
+
+/// @brief Looks up a leaf at depth state.range(0) in a tree of 10k leaves.
+void FindAtPathDepth(benchmark::State& state)
+{
+    const auto depth = static_cast<std::size_t>(state.range(0));
+    auto tree = Value::Object();
+    for (std::size_t i = 0; i < 10'000; ++i) {
+        tree.SetAtPath(generated::PathString(i, depth), Value(static_cast<std::int64_t>(i)));
+    }
+    const std::string path = generated::PathString(4321, depth);
+
+    for (auto _ : state) {
+        const Value* result = tree.FindAtPath(path);
+        benchmark::DoNotOptimize(result);
+    }
+}
+BENCHMARK(FindAtPathDepth)->RangeMultiplier(2)->Range(1, 16);
+
+/// @brief Parses a .conf file of 10k settings at depth state.range(0).
+void ConfParseDepth(benchmark::State& state)
+{
+    const std::string conf = generated::MakeConf(10'000, static_cast<std::size_t>(state.range(0)));
+
+    for (auto _ : state) {
+        auto result = ConfSerializer::ParseString(conf);
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(conf.size()));
+}
+BENCHMARK(ConfParseDepth)->RangeMultiplier(2)->Range(1, 16);
+
+// ---------------------------------------------------------------------------
+// Contention
+// ---------------------------------------------------------------------------
+
+namespace {
+
+    auto MaxBenchmarkThreads() -> int { return static_cast<int>(std::max(4U, std::thread::hardware_concurrency())); }
+
+}  // namespace
+
+/// @brief Every thread reads benchmark.int and writes it on state.range(0) percent of its iterations.
+template <typename Policy>
+void GetMixedReadWrite(benchmark::State& state)
+{
+    static Configuration<LargeSchema, ConfSerializer, Policy> config(
+        (std::filesystem::temp_directory_path() / "cppfig_benchmark_mixed.conf").string());
+    const auto write_percent = state.range(0);
+
+    std::int64_t counter = 0;
+    const auto allocations = AllocationsSoFar();
+    for (auto _ : state) {
+        if (++counter % 100 < write_percent) {
+            auto status = config.template Set<settings::IntSetting>(static_cast<int>(counter));
+            benchmark::DoNotOptimize(status);
+        }
+        else {
+            auto value = config.template Get<settings::IntSetting>();
+            benchmark::DoNotOptimize(value);
+        }
+    }
+    ReportAllocations(state, allocations);
+}
+BENCHMARK_TEMPLATE(GetMixedReadWrite, MultiThreadedPolicy)->Arg(0)->Arg(1)->Arg(10)->Arg(50)->ThreadRange(1, MaxBenchmarkThreads());
+BENCHMARK_TEMPLATE(GetMixedReadWrite, ShardedPolicy<>)->Arg(0)->Arg(1)->Arg(10)->Arg(50)->ThreadRange(1, MaxBenchmarkThreads());
+BENCHMARK_TEMPLATE(GetMixedReadWrite, SnapshotPolicy)->Arg(0)->Arg(1)->Arg(10)->Arg(50)->ThreadRange(1, MaxBenchmarkThreads());
+
+/// @brief Every thread reads a setting served by its environment variable.
+template <typename Policy>
+void GetEnvOverrideThreaded(benchmark::State& state)
+{
+    static const bool environment_set = [] { return setenv("BENCHMARK_ENV_SETTING", "from_env", 1) == 0; }();
+    static Configuration<LargeSchema, ConfSerializer, Policy> config(
+        (std::filesystem::temp_directory_path() / "cppfig_benchmark_env.conf").string());
+    benchmark::DoNotOptimize(environment_set);
+
+    for (auto _ : state) {
+        auto value = config.template Get<settings::EnvOverrideSetting>();
+        benchmark::DoNotOptimize(value);
+    }
+}
+BENCHMARK_TEMPLATE(GetEnvOverrideThreaded, MultiThreadedPolicy)->ThreadRange(1, MaxBenchmarkThreads());
+BENCHMARK_TEMPLATE(GetEnvOverrideThreaded, SnapshotPolicy)->ThreadRange(1, MaxBenchmarkThreads());
+
+/// @brief Thread 0 rewrites and reloads the file while the other threads read.
+///
+/// Iteration times mix both roles; the "reads" counter is the read
+/// throughput of the reader threads while reloads are in flight.
+template <typename Policy>
+void GetDuringReload(benchmark::State& state)
+{
+    static const std::string path = (std::filesystem::temp_directory_path() / "cppfig_benchmark_reload_load.conf").string();
+    static const std::array<Value, 2> versions = [] {
+        std::array<Value, 2> result {};
+        for (std::size_t version = 0; version < result.size(); ++version) {
+            auto parsed = ConfSerializer::ParseString(generated::MakeConf(1'000));
+            result[version] = *std::move(parsed);
+            result[version].SetAtPath(settings::IntSetting::path, Value(static_cast<int>(version)));
+        }
+        (void)WriteFile<ConfSerializer>(path, result[0]);
+        return result;
+    }();
+    static Configuration<LargeSchema, ConfSerializer, Policy> config(path);
+
+    std::size_t version = 0;
+    std::int64_t reads = 0;
+    for (auto _ : state) {
+        if (state.thread_index() == 0) {
+            version ^= 1U;
+            (void)WriteFile<ConfSerializer>(path, versions[version]);
+            auto status = config.Reload();
+            benchmark::DoNotOptimize(status);
+        }
+        else {
+            auto value = config.template Get<settings::IntSetting>();
+            benchmark::DoNotOptimize(value);
+            ++reads;
+        }
+    }
+    state.counters["reads"] = benchmark::Counter(static_cast<double>(reads), benchmark::Counter::kIsRate);
+}
+BENCHMARK_TEMPLATE(GetDuringReload, MultiThreadedPolicy)->Threads(2)->Threads(4);
+BENCHMARK_TEMPLATE(GetDuringReload, SnapshotPolicy)->Threads(2)->Threads(4);
+
+// ---------------------------------------------------------------------------
+// Custom types, parse failures, instrumentation and fleets
+// ---------------------------------------------------------------------------
+
+/// @brief Structured setting converted through nlohmann::json ADL.
+struct TlsProfile {
+    std::string certificate;
+    std::string key;
+    std::vector<std::string> ciphers;
+    int min_version = 0;
+};
+
+void to_json(nlohmann::json& json, const TlsProfile& profile)  // NOLINT(readability-identifier-naming)
+{
+    json = nlohmann::json { { "certificate", profile.certificate }, { "key", profile.key },
+                            { "ciphers", profile.ciphers }, { "min_version", profile.min_version } };
+}
+
+void from_json(const nlohmann::json& json, TlsProfile& profile)  // NOLINT(readability-identifier-naming)
+{
+    json.at("certificate").get_to(profile.certificate);
+    json.at("key").get_to(profile.key);
+    json.at("ciphers").get_to(profile.ciphers);
+    json.at("min_version").get_to(profile.min_version);
+}
+
+}  // namespace cppfig::bench
+
+template <>
+struct cppfig::ConfigTraits<cppfig::bench::TlsProfile> : cppfig::ConfigTraitsFromJsonAdl<cppfig::bench::TlsProfile> { };
+
+namespace cppfig::bench {
+
+namespace settings {
+
+    struct Tls {
+        static constexpr std::string_view path = "server.tls";
+        using value_type = TlsProfile;
+        static auto default_value() -> TlsProfile
+        {
+            return { "/etc/ssl/server.pem", "/etc/ssl/server.key",
+                     { "TLS_AES_128_GCM_SHA256", "TLS_AES_256_GCM_SHA384", "TLS_CHACHA20_POLY1305_SHA256" }, 3 };
+        }
+    };
+
+}  // namespace settings
+
+using CustomSchema = ConfigSchema<settings::IntSetting, settings::Tls>;
+
+BENCHMARK_DEFINE_F(BenchmarkFixture, CustomTypeDeserialize)(benchmark::State& state)
+{
+    const Value value = ConfigTraits<TlsProfile>::Serialize(settings::Tls::default_value());
+
+    const auto allocations = AllocationsSoFar();
+    for (auto _ : state) {
+        auto result = ConfigTraits<TlsProfile>::Deserialize(value);
+        benchmark::DoNotOptimize(result);
+    }
+    ReportAllocations(state, allocations);
+}
+BENCHMARK_REGISTER_F(BenchmarkFixture, CustomTypeDeserialize);
+
+BENCHMARK_DEFINE_F(BenchmarkFixture, GetCustomType)(benchmark::State& state)
+{
+    const std::string path = CreateTempFile();
+    Configuration<CustomSchema> config(path);
+    (void)config.Load();
+
+    const auto allocations = AllocationsSoFar();
+    for (auto _ : state) {
+        auto value = config.Get<settings::Tls>();
+        benchmark::DoNotOptimize(value);
+    }
+    ReportAllocations(state, allocations);
+    RemoveFile(path);
+}
+BENCHMARK_REGISTER_F(BenchmarkFixture, GetCustomType);
+
+BENCHMARK_DEFINE_F(BenchmarkFixture, LoadAndFirstGetCustomType)(benchmark::State& state)
+{
+    const std::string path = CreateTempFile();
+    {
+        Configuration<CustomSchema> config(path);
+        (void)config.Load();
+    }
+
+    for (auto _ : state) {
+        Configuration<CustomSchema> config(path);
+        auto status = config.Load();
+        auto value = config.Get<settings::Tls>();
+        benchmark::DoNotOptimize(status);
+        benchmark::DoNotOptimize(value);
+    }
+    RemoveFile(path);
+}
+BENCHMARK_REGISTER_F(BenchmarkFixture, LoadAndFirstGetCustomType);
+
+BENCHMARK_DEFINE_F(BenchmarkFixture, GetInvalidFileValue)(benchmark::State& state)
+{
+    const std::string path = CreateTempFile();
+    {
+        auto values = Value::Object();
+        values.SetAtPath(settings::IntSetting::path, Value("not_an_int"));
+        (void)WriteFile<ConfSerializer>(path, values);
+    }
+    Configuration<MediumSchema> config(path);
+    (void)config.Load();
+
+    for (auto _ : state) {
+        auto value = config.Get<settings::IntSetting>();
+        benchmark::DoNotOptimize(value);
+    }
+    RemoveFile(path);
+}
+BENCHMARK_REGISTER_F(BenchmarkFixture, GetInvalidFileValue);
+
+BENCHMARK_DEFINE_F(BenchmarkFixture, GetIntInstrumented)(benchmark::State& state)
+{
+    const std::string path = CreateTempFile();
+    Configuration<MediumSchema, ConfSerializer, SingleThreadedPolicy, MetricsInstrumentation> config(path);
+    (void)config.Load();
+
+    for (auto _ : state) {
+        auto value = config.Get<settings::IntSetting>();
+        benchmark::DoNotOptimize(value);
+    }
+    RemoveFile(path);
+}
+BENCHMARK_REGISTER_F(BenchmarkFixture, GetIntInstrumented);
+
+/// @brief Loads 64 configurations of the large schema, sequentially (0) or with LoadAll in parallel (1).
+BENCHMARK_DEFINE_F(BenchmarkFixture, LoadAllTenants)(benchmark::State& state)
+{
+    const auto directory = std::filesystem::path(CreateTempFile()).replace_extension(".tenants");
+    std::filesystem::create_directories(directory);
+
+    std::vector<std::unique_ptr<Configuration<LargeSchema>>> configs;
+    std::vector<IConfigurationProviderVirtual*> providers;
+    for (int tenant = 0; tenant < 64; ++tenant) {
+        configs.push_back(std::make_unique<Configuration<LargeSchema>>((directory / (std::to_string(tenant) + ".conf")).string()));
+        providers.push_back(configs.back().get());
+    }
+    (void)LoadAll(providers);
+
+    const auto policy = state.range(0) != 0 ? ExecutionPolicy::kParallel : ExecutionPolicy::kSequential;
+    for (auto _ : state) {
+        auto errors = LoadAll(providers, policy);
+        benchmark::DoNotOptimize(errors);
+    }
+
+    std::filesystem::remove_all(directory);
+}
+BENCHMARK_REGISTER_F(BenchmarkFixture, LoadAllTenants)->Arg(0)->Arg(1)->UseRealTime();
+
 }  // namespace cppfig::bench
 
 BENCHMARK_MAIN();
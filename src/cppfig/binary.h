@@ -0,0 +1,473 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <istream>
+#include <span>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "cppfig/status.h"
+#include "cppfig/value.h"
+
+namespace cppfig {
+
+/// @brief Identifies what a binary snapshot was taken from.
+///
+/// A snapshot is only trusted when its stamp matches the stamp computed for
+/// the current schema and text file; see @c Configuration::LoadSnapshot.
+struct SnapshotStamp {
+    std::uint64_t schema_hash = 0;   ///< @c ConfigSchema::hash of the writing schema.
+    std::uint64_t source_size = 0;   ///< Size in bytes of the text file the values came from.
+    std::uint64_t source_mtime = 0;  ///< Modification time of that file (file clock ticks).
+
+    /// @brief Computes the stamp of the file at @p path for a schema with @p schema_hash.
+    [[nodiscard]] static auto ForFile(std::uint64_t schema_hash, const std::string& path) -> StatusOr<SnapshotStamp>
+    {
+        namespace fs = std::filesystem;
+
+        std::error_code error_code;
+        const auto size = fs::file_size(path, error_code);
+        if (error_code) {
+            return NotFoundError("Could not stat file: " + path);
+        }
+        const auto mtime = fs::last_write_time(path, error_code);
+        if (error_code) {
+            return NotFoundError("Could not stat file: " + path);
+        }
+        return SnapshotStamp {
+            .schema_hash = schema_hash,
+            .source_size = size,
+            .source_mtime = static_cast<std::uint64_t>(mtime.time_since_epoch().count()),
+        };
+    }
+
+    auto operator==(const SnapshotStamp&) const -> bool = default;
+};
+
+namespace detail {
+
+    /// @brief Fixed-width little-endian field access for the binary format.
+    ///
+    /// Fields are assembled byte by byte, which compilers turn into a single
+    /// load or store on little-endian targets.
+    template <typename T>
+    void PutLittleEndian(char* out, T value)
+    {
+        for (std::size_t i = 0; i < sizeof(T); ++i) {
+            out[i] = static_cast<char>(static_cast<std::uint8_t>(value >> (8 * i)));
+        }
+    }
+
+    template <typename T>
+    [[nodiscard]] auto GetLittleEndian(const char* in) -> T
+    {
+        T value = 0;
+        for (std::size_t i = 0; i < sizeof(T); ++i) {
+            value |= static_cast<T>(static_cast<T>(static_cast<std::uint8_t>(in[i])) << (8 * i));
+        }
+        return value;
+    }
+
+}  // namespace detail
+
+/// @brief Compact binary serializer for fast startup.
+///
+/// Stores a Value tree in a versioned, length-prefixed layout that is
+/// decoded in one linear pass, without tokenizing or type inference:
+/// @code
+/// header   magic "CPFB", u16 version, u16 header size, SnapshotStamp,
+///          u32 node count, u32 string table size           (40 bytes)
+/// nodes    node count × 24-byte records, in pre-order
+/// strings  keys and string values, each stored once
+/// @endcode
+/// Every node record holds its type, the offset and length of its key in
+/// the string table, a count (object members, array elements or string
+/// length) and an 8-byte payload (integer, double bits or string offset).
+/// The members of an object and the elements of an array follow it
+/// directly.  Contiguous integer and double arrays (see @c Value::Integers)
+/// are a single node whose elements are one block of 8-byte values in the
+/// string table, decoded with one bulk copy.  All fields are little-endian.
+///
+/// The format is meant for machine-written snapshots rather than hand
+/// editing: input that is truncated, inconsistent or of another version is
+/// rejected with @c kInvalidArgument.
+struct BinarySerializer {
+    using data_type = Value;
+
+    static constexpr std::string_view k_magic = "CPFB";
+    static constexpr std::uint16_t k_version = 2;
+    static constexpr std::size_t k_header_size = 40;
+    static constexpr std::size_t k_node_size = 24;
+    /// @brief Deepest object or array nesting accepted when decoding.
+    static constexpr std::size_t k_max_depth = 256;
+
+    /// @brief Parses a binary stream into a Value tree.
+    static auto Parse(std::istream& is) -> StatusOr<Value>
+    {
+        std::string buffer;
+        std::array<char, 4096> chunk {};
+        while (is.read(chunk.data(), chunk.size()) || is.gcount() > 0) {
+            buffer.append(chunk.data(), static_cast<std::size_t>(is.gcount()));
+        }
+        return ParseBuffer(buffer);
+    }
+
+    /// @brief Parses a contiguous binary buffer into a Value tree (used by @c ReadFile).
+    static auto ParseBuffer(std::string_view buffer) -> StatusOr<Value>
+    {
+        auto layout = ReadLayout(buffer);
+        if (!layout.ok()) {
+            return layout.status();
+        }
+
+        Decoder decoder { *layout, 0 };
+        Value result;
+        auto status = decoder.Decode(result, 0);
+        if (!status.ok()) {
+            return status;
+        }
+        if (decoder.next != layout->node_count) {
+            return InvalidArgumentError("Corrupt binary configuration: trailing nodes");
+        }
+        return result;
+    }
+
+    /// @brief Returns the stamp recorded in a binary buffer, validating only its header.
+    static auto ReadStamp(std::string_view buffer) -> StatusOr<SnapshotStamp>
+    {
+        auto layout = ReadLayout(buffer);
+        if (!layout.ok()) {
+            return layout.status();
+        }
+        return layout->stamp;
+    }
+
+    /// @brief Converts a Value tree to its binary form with an empty stamp.
+    static auto Stringify(const Value& value) -> std::string { return Stringify(value, {}); }
+
+    /// @brief Converts a Value tree to its binary form, recording @p stamp in the header.
+    static auto Stringify(const Value& value, const SnapshotStamp& stamp) -> std::string
+    {
+        Encoder encoder;
+        encoder.Encode(value, {});
+
+        std::string out(k_header_size, '\0');
+        out.replace(0, k_magic.size(), k_magic);
+        detail::PutLittleEndian<std::uint16_t>(&out[4], k_version);
+        detail::PutLittleEndian<std::uint16_t>(&out[6], static_cast<std::uint16_t>(k_header_size));
+        detail::PutLittleEndian<std::uint64_t>(&out[8], stamp.schema_hash);
+        detail::PutLittleEndian<std::uint64_t>(&out[16], stamp.source_size);
+        detail::PutLittleEndian<std::uint64_t>(&out[24], stamp.source_mtime);
+        detail::PutLittleEndian<std::uint32_t>(&out[32], static_cast<std::uint32_t>(encoder.node_count));
+        detail::PutLittleEndian<std::uint32_t>(&out[36], static_cast<std::uint32_t>(encoder.strings.size()));
+        out.reserve(out.size() + encoder.nodes.size() + encoder.strings.size());
+        out += encoder.nodes;
+        out += encoder.strings;
+        return out;
+    }
+
+private:
+    enum class NodeType : std::uint8_t {
+        kNull = 0,
+        kFalse,
+        kTrue,
+        kInteger,
+        kDouble,
+        kString,
+        kObject,
+        kArray,
+        kIntegerArray,
+        kDoubleArray,
+    };
+
+    /// @brief Validated header fields and the node and string sections they describe.
+    struct Layout {
+        SnapshotStamp stamp;
+        std::size_t node_count = 0;
+        std::string_view nodes;
+        std::string_view strings;
+    };
+
+    static auto ReadLayout(std::string_view buffer) -> StatusOr<Layout>
+    {
+        if (buffer.size() < k_header_size || buffer.substr(0, k_magic.size()) != k_magic) {
+            return InvalidArgumentError("Not a binary configuration");
+        }
+        const char* header = buffer.data();
+        const auto version = detail::GetLittleEndian<std::uint16_t>(header + 4);
+        if (version != k_version) {
+            return InvalidArgumentError("Unsupported binary configuration version " + std::to_string(version));
+        }
+        const auto header_size = detail::GetLittleEndian<std::uint16_t>(header + 6);
+        if (header_size != k_header_size) {
+            return InvalidArgumentError("Corrupt binary configuration: bad header size");
+        }
+
+        Layout layout;
+        layout.stamp.schema_hash = detail::GetLittleEndian<std::uint64_t>(header + 8);
+        layout.stamp.source_size = detail::GetLittleEndian<std::uint64_t>(header + 16);
+        layout.stamp.source_mtime = detail::GetLittleEndian<std::uint64_t>(header + 24);
+        layout.node_count = detail::GetLittleEndian<std::uint32_t>(header + 32);
+        const std::size_t string_bytes = detail::GetLittleEndian<std::uint32_t>(header + 36);
+
+        const std::size_t node_bytes = layout.node_count * k_node_size;
+        if (layout.node_count == 0 || buffer.size() != k_header_size + node_bytes + string_bytes) {
+            return InvalidArgumentError("Corrupt binary configuration: size mismatch");
+        }
+        layout.nodes = buffer.substr(k_header_size, node_bytes);
+        layout.strings = buffer.substr(k_header_size + node_bytes);
+        return layout;
+    }
+
+    struct Decoder {
+        const Layout& layout;
+        std::size_t next;
+
+        /// @brief Returns the @p length bytes at @p offset of the string table, if in bounds.
+        [[nodiscard]] auto String(std::size_t offset, std::size_t length, std::string_view& out) const -> bool
+        {
+            if (offset > layout.strings.size() || length > layout.strings.size() - offset) {
+                return false;
+            }
+            out = layout.strings.substr(offset, length);
+            return true;
+        }
+
+        /// @brief Decodes the node at @c next (and its members) into @p out.
+        [[nodiscard]] auto Decode(Value& out, std::size_t depth) -> Status
+        {
+            if (next >= layout.node_count) {
+                return InvalidArgumentError("Corrupt binary configuration: missing nodes");
+            }
+            const char* node = layout.nodes.data() + (next++ * k_node_size);
+            const auto count = detail::GetLittleEndian<std::uint32_t>(node + 12);
+            const auto payload = detail::GetLittleEndian<std::uint64_t>(node + 16);
+
+            switch (static_cast<NodeType>(static_cast<std::uint8_t>(node[0]))) {
+            case NodeType::kNull:
+                out = Value();
+                return OkStatus();
+            case NodeType::kFalse:
+                out = Value(false);
+                return OkStatus();
+            case NodeType::kTrue:
+                out = Value(true);
+                return OkStatus();
+            case NodeType::kInteger:
+                out = Value(std::bit_cast<std::int64_t>(payload));
+                return OkStatus();
+            case NodeType::kDouble:
+                out = Value(std::bit_cast<double>(payload));
+                return OkStatus();
+            case NodeType::kString: {
+                std::string_view text;
+                if (!String(payload, count, text)) {
+                    return InvalidArgumentError("Corrupt binary configuration: string out of bounds");
+                }
+                out = Value(text);
+                return OkStatus();
+            }
+            case NodeType::kArray:
+                return DecodeArray(out, count, depth);
+            case NodeType::kIntegerArray: {
+                Value::IntegerArrayType integers;
+                if (!Block(payload, count, integers)) {
+                    return InvalidArgumentError("Corrupt binary configuration: array out of bounds");
+                }
+                out = Value::Array(std::move(integers));
+                return OkStatus();
+            }
+            case NodeType::kDoubleArray: {
+                Value::DoubleArrayType doubles;
+                if (!Block(payload, count, doubles)) {
+                    return InvalidArgumentError("Corrupt binary configuration: array out of bounds");
+                }
+                out = Value::Array(std::move(doubles));
+                return OkStatus();
+            }
+            case NodeType::kObject:
+                return DecodeObject(out, count, depth);
+            }
+            return InvalidArgumentError("Corrupt binary configuration: unknown node type");
+        }
+
+        /// @brief Copies the @p count 8-byte elements at @p offset of the string table into @p out, if in bounds.
+        template <typename T>
+        [[nodiscard]] auto Block(std::uint64_t offset, std::size_t count, std::vector<T>& out) const -> bool
+        {
+            std::string_view bytes;
+            if (!String(offset, count * sizeof(T), bytes)) {
+                return false;
+            }
+            out.resize(count);
+            if constexpr (std::endian::native == std::endian::little) {
+                std::memcpy(out.data(), bytes.data(), bytes.size());
+            }
+            else {
+                for (std::size_t i = 0; i < count; ++i) {
+                    out[i] = std::bit_cast<T>(detail::GetLittleEndian<std::uint64_t>(bytes.data() + (i * sizeof(T))));
+                }
+            }
+            return true;
+        }
+
+        [[nodiscard]] auto DecodeArray(Value& out, std::size_t count, std::size_t depth) -> Status
+        {
+            if (depth >= k_max_depth) {
+                return InvalidArgumentError("Corrupt binary configuration: nesting too deep");
+            }
+            if (count > layout.node_count - next) {
+                return InvalidArgumentError("Corrupt binary configuration: missing nodes");
+            }
+
+            Value::ArrayType elements(count);
+            for (auto& element : elements) {
+                auto status = Decode(element, depth + 1);
+                if (!status.ok()) {
+                    return status;
+                }
+            }
+            out = Value::Array(std::move(elements));
+            return OkStatus();
+        }
+
+        [[nodiscard]] auto DecodeObject(Value& out, std::size_t count, std::size_t depth) -> Status
+        {
+            if (depth >= k_max_depth) {
+                return InvalidArgumentError("Corrupt binary configuration: nesting too deep");
+            }
+            if (count > layout.node_count - next) {
+                return InvalidArgumentError("Corrupt binary configuration: missing nodes");
+            }
+
+            out = Value::Object();
+            auto& items = out.Items();
+            for (std::size_t i = 0; i < count; ++i) {
+                if (next >= layout.node_count) {
+                    return InvalidArgumentError("Corrupt binary configuration: missing nodes");
+                }
+                const char* member = layout.nodes.data() + (next * k_node_size);
+                std::string_view key;
+                if (!String(detail::GetLittleEndian<std::uint32_t>(member + 4), detail::GetLittleEndian<std::uint32_t>(member + 8), key)) {
+                    return InvalidArgumentError("Corrupt binary configuration: key out of bounds");
+                }
+                auto [iter, inserted] = items.try_emplace(std::string(key));
+                if (!inserted) {
+                    return InvalidArgumentError("Corrupt binary configuration: duplicate key '" + std::string(key) + "'");
+                }
+                auto status = Decode(iter->second, depth + 1);
+                if (!status.ok()) {
+                    return status;
+                }
+            }
+            return OkStatus();
+        }
+    };
+
+    struct Encoder {
+        std::string nodes;
+        std::string strings;
+        std::size_t node_count = 0;
+        /// @brief Offset of every string already in the table (views into the encoded tree).
+        std::unordered_map<std::string_view, std::uint32_t> offsets;
+
+        auto Intern(std::string_view text) -> std::uint32_t
+        {
+            auto [iter, inserted] = offsets.try_emplace(text, static_cast<std::uint32_t>(strings.size()));
+            if (inserted) {
+                strings += text;
+            }
+            return iter->second;
+        }
+
+        void Encode(const Value& value, std::string_view key)
+        {
+            NodeType type = NodeType::kNull;
+            std::uint32_t count = 0;
+            std::uint64_t payload = 0;
+            if (value.IsBoolean()) {
+                type = value.Get<bool>() ? NodeType::kTrue : NodeType::kFalse;
+            }
+            else if (value.IsInteger()) {
+                type = NodeType::kInteger;
+                payload = std::bit_cast<std::uint64_t>(value.Get<std::int64_t>());
+            }
+            else if (value.IsDouble()) {
+                type = NodeType::kDouble;
+                payload = std::bit_cast<std::uint64_t>(value.Get<double>());
+            }
+            else if (value.IsString()) {
+                type = NodeType::kString;
+                count = static_cast<std::uint32_t>(value.AsStringView().size());
+                payload = Intern(value.AsStringView());
+            }
+            else if (!value.Integers().empty()) {
+                type = NodeType::kIntegerArray;
+                count = static_cast<std::uint32_t>(value.Size());
+                payload = AppendBlock(value.Integers());
+            }
+            else if (!value.Doubles().empty()) {
+                type = NodeType::kDoubleArray;
+                count = static_cast<std::uint32_t>(value.Size());
+                payload = AppendBlock(value.Doubles());
+            }
+            else if (value.IsArray()) {
+                type = NodeType::kArray;
+                count = static_cast<std::uint32_t>(value.Size());
+            }
+            else if (value.IsObject()) {
+                type = NodeType::kObject;
+                count = static_cast<std::uint32_t>(value.Items().size());
+            }
+
+            std::array<char, k_node_size> node {};
+            node[0] = static_cast<char>(type);
+            if (!key.empty()) {
+                detail::PutLittleEndian<std::uint32_t>(&node[4], Intern(key));
+                detail::PutLittleEndian<std::uint32_t>(&node[8], static_cast<std::uint32_t>(key.size()));
+            }
+            detail::PutLittleEndian<std::uint32_t>(&node[12], count);
+            detail::PutLittleEndian<std::uint64_t>(&node[16], payload);
+            nodes.append(node.data(), node.size());
+            ++node_count;
+
+            if (type == NodeType::kObject) {
+                for (const auto& [member_key, member] : value.Items()) {
+                    Encode(member, member_key);
+                }
+            }
+            else if (type == NodeType::kArray) {
+                value.ForEachElement([this](const Value& element) { Encode(element, {}); });
+            }
+        }
+
+        /// @brief Appends @p elements to the string table as 8-byte little-endian values; returns their offset.
+        template <typename T>
+        auto AppendBlock(std::span<const T> elements) -> std::uint32_t
+        {
+            const auto offset = static_cast<std::uint32_t>(strings.size());
+            strings.resize(strings.size() + elements.size_bytes());
+            char* out = strings.data() + offset;
+            if constexpr (std::endian::native == std::endian::little) {
+                std::memcpy(out, elements.data(), elements.size_bytes());
+            }
+            else {
+                for (std::size_t i = 0; i < elements.size(); ++i) {
+                    detail::PutLittleEndian<std::uint64_t>(out + (i * sizeof(T)), std::bit_cast<std::uint64_t>(elements[i]));
+                }
+            }
+            return offset;
+        }
+    };
+};
+
+}  // namespace cppfig
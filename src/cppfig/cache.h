@@ -0,0 +1,85 @@
+#pragma once
+
+#include <concepts>
+#include <cstdint>
+
+#include "cppfig/setting.h"
+
+namespace cppfig {
+
+/// @brief Concept for configuration providers that stamp their state with a generation counter.
+///
+/// The generation must change whenever any value observable through
+/// @c Get<S>() may have changed.
+template <typename Config>
+concept HasGeneration = requires(const Config& config) {
+    { config.Generation() } -> std::convertible_to<std::uint64_t>;
+};
+
+/// @brief Concept for configuration providers that count @c CachedSetting reads of setting S.
+template <typename Config, typename S>
+concept RecordsCacheAccess = requires(const Config& config) { config.template RecordCacheAccess<S>(true); };
+
+/// @brief Cached accessor for a single setting of a configuration.
+///
+/// Holds the resolved value of @p S together with the configuration
+/// generation it was resolved at.  Reading the handle costs one relaxed
+/// atomic load and a compare; the value is only re-resolved (through
+/// @c Get<S>(), including environment overrides) after a @c Set or @c Load
+/// bumped the generation.
+///
+/// A handle is not itself synchronized: give each thread its own handle.
+/// The handle must not outlive the configuration it was created from.
+///
+/// Usage:
+/// @code
+/// auto port = config.Cached<settings::ServerPort>();
+/// while (running) {
+///     Serve(*port);  // re-resolved only after config.Set / config.Load
+/// }
+/// @endcode
+///
+/// @tparam Config The configuration provider type.
+/// @tparam S The setting type.
+template <HasGeneration Config, IsSetting S>
+class CachedSetting {
+public:
+    using value_type = typename S::value_type;
+
+    /// @brief Creates a handle and resolves the current value.
+    explicit CachedSetting(const Config& config)
+        : config_(&config)
+        , generation_(config.Generation())
+        , value_(config.template Get<S>())
+    {
+    }
+
+    /// @brief Returns the current value, re-resolving it if the configuration changed.
+    [[nodiscard]] auto Get() -> const value_type&
+    {
+        const std::uint64_t generation = config_->Generation();
+        const bool hit = generation == generation_;
+        if (!hit) [[unlikely]] {
+            // Read the generation (an acquire load) before the value: the value
+            // is then at least as new as the generation it is cached under,
+            // and a concurrent write at worst causes one extra refresh.
+            generation_ = generation;
+            value_ = config_->template Get<S>();
+        }
+        if constexpr (RecordsCacheAccess<Config, S>) {
+            config_->template RecordCacheAccess<S>(hit);
+        }
+        return value_;
+    }
+
+    [[nodiscard]] auto operator*() -> const value_type& { return Get(); }
+
+    [[nodiscard]] auto operator->() -> const value_type* { return &Get(); }
+
+private:
+    const Config* config_;
+    std::uint64_t generation_;
+    value_type value_;
+};
+
+}  // namespace cppfig
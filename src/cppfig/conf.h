@@ -1,7 +1,11 @@
 #pragma once
 
+#include <array>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
 #include <istream>
-#include <sstream>
+#include <system_error>
 #include <string>
 #include <string_view>
 #include <utility>
@@ -29,25 +33,82 @@ namespace cppfig {
 ///
 /// Type inference during parsing:
 /// - `true`/`false`/`yes`/`no`/`on`/`off` → bool
-/// - All-digit strings (optional leading `-`) → int64
+/// - All-digit strings (optional leading `-` or `+`) → int64
 /// - Numeric with decimal point or exponent → double
 /// - Quoted strings (`"..."`) → string (quotes stripped)
+/// - Bracketed lists (`[a, "b, c", [1, 2]]`) → array, each element inferred
+///   by these rules; quoted elements escape `"` and `\` with a backslash
 /// - Everything else → string
+///
+/// The text of every list value is kept alongside the tree (see the
+/// two-argument @c ParseBuffer), so string settings still read a bracketed
+/// value such as `name = [prod]` as written, as they did before lists existed.
+///
+/// Arrays of objects cannot be expressed in this format; their object
+/// elements (and null elements) are written as empty strings.
 struct ConfSerializer {
     using data_type = Value;
 
     /// @brief Parses a `.conf` stream into a Value tree.
     static auto Parse(std::istream& is) -> StatusOr<Value>
+    {
+        std::string buffer;
+        std::array<char, 4096> chunk {};
+        while (is.read(chunk.data(), chunk.size()) || is.gcount() > 0) {
+            buffer.append(chunk.data(), static_cast<std::size_t>(is.gcount()));
+        }
+        return ParseBuffer(buffer);
+    }
+
+    /// @brief Parses a `.conf` string into a Value tree.
+    static auto ParseString(std::string_view str) -> StatusOr<Value> { return ParseBuffer(str); }
+
+    /// @brief Parses a contiguous `.conf` buffer into a Value tree (used by @c ReadFile).
+    ///
+    /// Lines are tokenized as string_view slices of @p str; only keys and
+    /// string values that end up in the tree are copied.
+    static auto ParseBuffer(std::string_view str) -> StatusOr<Value> { return ParseLines(str, nullptr); }
+
+    /// @brief Parses a `.conf` buffer, also recording the text of every list value.
+    ///
+    /// @p list_texts receives, at the path of each value read as a list, the
+    /// value's text exactly as written (e.g. `[1.50]`).
+    static auto ParseBuffer(std::string_view str, Value& list_texts) -> StatusOr<Value>
+    {
+        return ParseLines(str, &list_texts);
+    }
+
+    /// @brief Converts a Value tree to flat `key = value` lines.
+    ///
+    /// Lines are appended to one string reserved up front; leaf paths are
+    /// built in a single prefix buffer during the depth-first walk.
+    static auto Stringify(const Value& data) -> std::string
+    {
+        std::string out;
+        out.reserve(EstimateSize(data, 0));
+        std::string path;
+        AppendLeaves(data, path, out);
+        return out;
+    }
+
+private:
+    /// @brief Parses @p str line by line; records list texts in @p list_texts when not null.
+    static auto ParseLines(std::string_view str, Value* list_texts) -> StatusOr<Value>
     {
         Value result = Value::Object();
-        std::string line;
+        TreeBuilder builder(result);
         int line_number = 0;
 
-        while (std::getline(is, line)) {
+        std::size_t line_begin = 0;
+        while (line_begin < str.size()) {
+            auto line_end = str.find('\n', line_begin);
+            if (line_end == std::string_view::npos) {
+                line_end = str.size();
+            }
+            const auto trimmed = Trim(str.substr(line_begin, line_end - line_begin));
+            line_begin = line_end + 1;
             ++line_number;
 
-            auto trimmed = Trim(line);
-
             // Skip empty lines and comments
             if (trimmed.empty() || trimmed[0] == '#') {
                 continue;
@@ -55,58 +116,124 @@ struct ConfSerializer {
 
             // key = value
             auto eq_pos = trimmed.find('=');
-            if (eq_pos == std::string::npos) {
+            if (eq_pos == std::string_view::npos) {
                 return InvalidArgumentError("conf parse error: missing '=' on line " + std::to_string(line_number));
             }
 
-            std::string key = Trim(trimmed.substr(0, eq_pos));
-            std::string value_str = Trim(trimmed.substr(eq_pos + 1));
-
-            result.SetAtPath(key, InferValue(value_str));
+            const auto key = Trim(trimmed.substr(0, eq_pos));
+            const auto text = Trim(trimmed.substr(eq_pos + 1));
+            Value value = InferValue(text);
+            if (list_texts != nullptr && value.IsArray() && !key.empty()) {
+                list_texts->SetAtPath(key, Value(std::string(text)));
+            }
+            builder.Insert(key, std::move(value));
         }
 
         return result;
     }
 
-    /// @brief Parses a `.conf` string into a Value tree.
-    static auto ParseString(std::string_view str) -> StatusOr<Value>
-    {
-        std::istringstream stream { std::string(str) };
-        return Parse(stream);
-    }
+    /// @brief Inserts dot-path keys into a tree, reusing the nodes of the previous key's parent.
+    ///
+    /// Keeps the chain of object nodes from the root to the parent of the
+    /// last inserted key.  A new key only walks the segments that differ
+    /// from that chain, so consecutive keys of the same section cost a
+    /// single map insertion.  Only the tail of the chain is ever mutated,
+    /// so the nodes it holds stay valid.  Semantics match
+    /// @c Value::SetAtPath (intermediate non-objects are replaced).
+    class TreeBuilder {
+    public:
+        explicit TreeBuilder(Value& root)
+            : chain_ { &root }
+        {
+        }
 
-    /// @brief Converts a Value tree to flat `key = value` lines.
-    static auto Stringify(const Value& data) -> std::string
-    {
-        std::vector<std::pair<std::string, const Value*>> leaves;
-        CollectLeaves(data, "", leaves);
+        void Insert(std::string_view key, Value value)
+        {
+            if (key.empty()) {
+                return;
+            }
+
+            const auto leaf_pos = key.rfind('.');
+            if (leaf_pos == std::string_view::npos) {
+                Truncate(0);
+                (*chain_.back())[key] = std::move(value);
+                return;
+            }
+
+            const auto parent = key.substr(0, leaf_pos);
+            std::size_t depth = 0;
+            bool diverged = false;
+            std::size_t begin = 0;
+            while (true) {
+                const auto end = parent.find('.', begin);
+                const auto segment = parent.substr(begin, end == std::string_view::npos ? std::string_view::npos : end - begin);
+
+                if (!diverged && depth < segments_.size() && segments_[depth] == segment) {
+                    ++depth;
+                }
+                else {
+                    if (!diverged) {
+                        Truncate(depth);
+                        diverged = true;
+                    }
+                    Value& child = (*chain_.back())[segment];
+                    if (!child.IsObject()) {
+                        child = Value::Object();
+                    }
+                    chain_.push_back(&child);
+                    segments_.push_back(segment);
+                    ++depth;
+                }
+
+                if (end == std::string_view::npos) {
+                    break;
+                }
+                begin = end + 1;
+            }
+            if (!diverged) {
+                Truncate(depth);
+            }
 
-        std::ostringstream stream;
-        for (const auto& [path, val] : leaves) {
-            stream << path << " = " << ValueToString(*val) << '\n';
+            (*chain_.back())[key.substr(leaf_pos + 1)] = std::move(value);
         }
 
-        return stream.str();
-    }
+    private:
+        void Truncate(std::size_t depth)
+        {
+            segments_.resize(depth);
+            chain_.resize(depth + 1);
+        }
+
+        std::vector<Value*> chain_;              ///< chain_[i] is the node after i segments.
+        std::vector<std::string_view> segments_;  ///< Segments of the cached parent path.
+    };
 
-private:
     /// @brief Trims leading/trailing whitespace.
-    static auto Trim(std::string_view sv) -> std::string
+    static constexpr auto Trim(std::string_view sv) -> std::string_view
     {
         auto start = sv.find_first_not_of(" \t\r\n");
         if (start == std::string_view::npos) {
-            return "";
+            return {};
         }
         auto end = sv.find_last_not_of(" \t\r\n");
-        return std::string(sv.substr(start, end - start + 1));
+        return sv.substr(start, end - start + 1);
+    }
+
+    /// @brief Drops a leading '+' (accepted by the format, rejected by std::from_chars).
+    static constexpr auto StripPlus(std::string_view str) -> std::string_view
+    {
+        if (str.size() > 1 && str.front() == '+' && str[1] != '-' && str[1] != '+') {
+            str.remove_prefix(1);
+        }
+        return str;
     }
 
     /// @brief Infers the Value type from a raw string.
-    static auto InferValue(const std::string& str) -> Value
+    static auto InferValue(std::string_view str) -> Value
     {
         // Quoted string
         if (str.size() >= 2 && str.front() == '"' && str.back() == '"') {
-            return { str.substr(1, str.size() - 2) };
+            return { std::string(str.substr(1, str.size() - 2)) };
         }
 
         // Empty → empty string
@@ -114,6 +241,17 @@ private:
             return { std::string("") };
         }
 
+        // List
+        if (str.front() == '[') {
+            Value::ArrayType elements;
+            const bool balanced = detail::ForEachListElement(str, [&elements](std::string_view element) {
+                elements.push_back(detail::IsQuotedListElement(element) ? Value(detail::UnquoteListElement(element)) : InferValue(element));
+            });
+            if (balanced) {
+                return Value::Array(std::move(elements));
+            }
+        }
+
         // Boolean
         if (str == "true" || str == "yes" || str == "on") {
             return { true };
@@ -122,74 +260,101 @@ private:
             return { false };
         }
 
+        const auto number = StripPlus(str);
+
         // Integer
-        try {
-            std::size_t pos = 0;
-            auto int_val = std::stoll(str, &pos);
-            if (pos == str.size()) {
-                return { static_cast<std::int64_t>(int_val) };
-            }
-        }
-        catch (...) {
+        std::int64_t int_val = 0;
+        auto [int_end, int_error] = std::from_chars(number.data(), number.data() + number.size(), int_val);
+        if (int_error == std::errc() && int_end == number.data() + number.size()) {
+            return { int_val };
         }
 
         // Double (only if it contains a decimal point or exponent)
-        if (str.find('.') != std::string::npos || str.find('e') != std::string::npos || str.find('E') != std::string::npos) {
-            try {
-                std::size_t pos = 0;
-                auto double_val = std::stod(str, &pos);
-                if (pos == str.size()) {
-                    return { double_val };
-                }
-            }
-            catch (...) {
+        if (str.find_first_of(".eE") != std::string_view::npos) {
+            double double_val = 0.0;
+            auto [double_end, double_error] = std::from_chars(number.data(), number.data() + number.size(), double_val);
+            if (double_error == std::errc() && double_end == number.data() + number.size()) {
+                return { double_val };
             }
         }
 
         // Unquoted string
-        return { str };
+        return { std::string(str) };
     }
 
-    /// @brief Converts a leaf Value to its string representation.
-    static auto ValueToString(const Value& val) -> std::string
+    /// @brief Upper bound for a rendered number, used when reserving the output.
+    static constexpr std::size_t k_number_size = 24;
+
+    /// @brief Estimates the rendered size of the lines under @p node, whose path has @p path_size characters.
+    static auto EstimateSize(const Value& node, std::size_t path_size) -> std::size_t
     {
-        if (val.IsNull()) {
-            return "";
+        if (node.IsObject()) {
+            std::size_t size = 0;
+            for (const auto& [key, val] : node.Items()) {
+                size += EstimateSize(val, path_size + (path_size == 0 ? 0 : 1) + key.size());
+            }
+            return size;
         }
+        // "path = value\n", with room for quotes around strings
+        std::size_t value_size = k_number_size;
+        if (node.IsString()) {
+            value_size = node.AsStringView().size() + 2;
+        }
+        else if (node.IsArray()) {
+            value_size = node.Size() * k_number_size;
+        }
+        return path_size + 4 + value_size;
+    }
+
+    /// @brief Appends one line per leaf under @p node; @p path holds the node's path and is restored on return.
+    static void AppendLeaves(const Value& node, std::string& path, std::string& out)
+    {
+        if (node.IsObject()) {
+            const auto prefix_size = path.size();
+            for (const auto& [key, val] : node.Items()) {
+                if (prefix_size != 0) {
+                    path.push_back('.');
+                }
+                path.append(key);
+                AppendLeaves(val, path, out);
+                path.resize(prefix_size);
+            }
+            return;
+        }
+        out.append(path);
+        out.append(" = ");
+        AppendScalar(out, node);
+        out.push_back('\n');
+    }
+
+    /// @brief Appends the string representation of a leaf Value.
+    static void AppendScalar(std::string& out, const Value& val)
+    {
         if (val.IsBoolean()) {
-            return val.Get<bool>() ? "true" : "false";
+            out.append(val.Get<bool>() ? "true" : "false");
         }
-        if (val.IsInteger()) {
-            return std::to_string(val.Get<std::int64_t>());
+        else if (val.IsInteger()) {
+            detail::AppendInteger(out, val.Get<std::int64_t>());
         }
-        if (val.IsDouble()) {
-            std::ostringstream stream;
-            stream << val.Get<double>();
-            return stream.str();
+        else if (val.IsDouble()) {
+            detail::AppendDouble(out, val.Get<double>());
         }
-        if (val.IsString()) {
+        else if (val.IsString()) {
             const auto& str = val.Get<std::string>();
             // Quote if the string contains special characters or is empty
-            bool needs_quoting = str.empty() || str.front() == ' ' || str.back() == ' ' || str.front() == '"' || str.find_first_of("=#\n\r") != std::string::npos;
+            bool needs_quoting = str.empty() || str.front() == ' ' || str.back() == ' ' || str.front() == '"' || str.front() == '['
+                                 || str.find_first_of("=#\n\r") != std::string::npos;
             if (needs_quoting) {
-                return "\"" + str + "\"";
+                out.push_back('"');
+                out.append(str);
+                out.push_back('"');
             }
-            return str;
-        }
-        return "";
-    }
-
-    /// @brief Recursively collects all leaf (path, Value*) pairs.
-    static void CollectLeaves(const Value& node, const std::string& prefix, std::vector<std::pair<std::string, const Value*>>& leaves)
-    {
-        if (node.IsObject()) {
-            for (const auto& [key, val] : node.Items()) {
-                std::string path = prefix.empty() ? key : prefix + "." + key;
-                CollectLeaves(val, path, leaves);
+            else {
+                out.append(str);
             }
         }
-        else {
-            leaves.emplace_back(prefix, &node);
+        else if (val.IsArray()) {
+            detail::AppendListLiteral(out, val);
         }
     }
 };
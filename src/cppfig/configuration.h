@@ -1,18 +1,34 @@
 #pragma once
 
-#include <cstdlib>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
 #include <filesystem>
+#include <memory>
+#include <optional>
 #include <string>
 #include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
+#include "cppfig/binary.h"
+#include "cppfig/cache.h"
 #include "cppfig/conf.h"
 #include "cppfig/diff.h"
+#include "cppfig/execution.h"
+#include "cppfig/instrumentation.h"
 #include "cppfig/interface.h"
 #include "cppfig/logging.h"
+#include "cppfig/schema.h"
 #include "cppfig/serializer.h"
 #include "cppfig/setting.h"
+#include "cppfig/slots.h"
+#include "cppfig/subscription.h"
 #include "cppfig/thread_policy.h"
 #include "cppfig/traits.h"
+#include "cppfig/transaction.h"
 #include "cppfig/value.h"
 
 namespace cppfig {
@@ -21,11 +37,17 @@ namespace cppfig {
 ///
 /// This class manages configuration values with:
 /// - Compile-time type-safe access via setting types
-/// - Environment variable overrides
+/// - Typed slot storage (one indexed slot per setting, resolved on load)
+/// - Generation-stamped cached accessors (@c Cached<S>())
+/// - Typed change subscriptions (@c Subscribe<S>())
+/// - All-or-nothing batched updates (@c Transaction())
+/// - Environment variable overrides (snapshotted on construction and @c Load)
 /// - Validation
 /// - Automatic file creation with defaults
 /// - Schema migration (adding new settings)
+/// - Atomic saves that are skipped when nothing changed (@c IsDirty, @c DirtyPaths)
 /// - Optional thread safety via a pluggable ThreadPolicy
+/// - Optional access counters and load/save timings via an InstrumentationPolicy
 ///
 /// Thread Safety:
 /// By default, the class uses @c SingleThreadedPolicy (zero overhead).
@@ -38,14 +60,23 @@ namespace cppfig {
 /// // Thread-safe (reader-writer locking):
 /// cppfig::Configuration<MySchema, cppfig::JsonSerializer, cppfig::MultiThreadedPolicy>
 ///     config("config.json");
+///
+/// // Thread-safe, read-mostly (lock-free reads of immutable snapshots):
+/// cppfig::Configuration<MySchema, cppfig::JsonSerializer, cppfig::SnapshotPolicy>
+///     config("config.json");
 /// @endcode
 ///
 /// With @c MultiThreadedPolicy:
 /// - Multiple threads may call @c Get concurrently (shared/reader lock).
 /// - Calls to @c Set, @c Load mutate internal state under an exclusive/writer lock.
-/// - @c Save, @c Diff, @c ValidateAll acquire a shared/reader lock.
+/// - @c Diff, @c ValidateAll acquire a shared/reader lock.
+/// - @c Save holds the shared lock only to take a copy-on-write reference
+///   to the file values; it serializes and writes without it.
 /// - Validation in @c Set is performed *before* acquiring the exclusive lock.
 ///
+/// With @c SnapshotPolicy, readers (@c Get, @c Save, @c Diff, @c ValidateAll)
+/// never lock; @c Set and @c Load publish a new snapshot of the whole state.
+///
 /// Usage:
 /// @code
 /// // Define settings
@@ -78,11 +109,15 @@ namespace cppfig {
 /// @tparam Schema The ConfigSchema type defining all settings.
 /// @tparam SerializerT The serializer to use (defaults to ConfSerializer).
 /// @tparam ThreadPolicy The threading policy (defaults to SingleThreadedPolicy).
-template <typename Schema, Serializer SerializerT = ConfSerializer, typename ThreadPolicy = SingleThreadedPolicy>
-class Configuration : public IConfigurationProvider<Configuration<Schema, SerializerT, ThreadPolicy>, Schema>,
+/// @tparam InstrumentationPolicy The instrumentation policy (defaults to NoInstrumentation).
+template <typename Schema, Serializer SerializerT = ConfSerializer, typename ThreadPolicy = SingleThreadedPolicy,
+          typename InstrumentationPolicy = NoInstrumentation>
+class Configuration : public IConfigurationProvider<Configuration<Schema, SerializerT, ThreadPolicy, InstrumentationPolicy>, Schema>,
                       public IConfigurationProviderVirtual {
 public:
     using serializer_type = SerializerT;
+    using thread_policy = ThreadPolicy;
+    using instrumentation_policy = InstrumentationPolicy;
     using data_type = Value;
 
     /// @brief Creates a configuration manager with a file path.
@@ -90,9 +125,8 @@ public:
     /// @param file_path Path to the configuration file.
     explicit Configuration(std::string file_path)
         : file_path_(std::move(file_path))
-        , file_values_(Value::Object())
+        , state_(MakeInitialState())
     {
-        BuildDefaults();
     }
 
     /// @brief Gets the value for a setting type.
@@ -102,48 +136,55 @@ public:
     /// 2. File value (if present)
     /// 3. Default value
     ///
-    /// Thread safety: acquires a shared (reader) lock when reading file values.
+    /// All three steps are pre-resolved by construction, @c Load, @c Set and
+    /// @c RefreshEnvironment, so this never touches the process environment
+    /// or the Value tree.  A value that fails to parse is reported once per
+    /// @c Generation(), not on every read.
+    ///
+    /// Thread safety: acquires a shared (reader) lock when reading the slot
+    /// (lock-free under @c SnapshotPolicy, only the setting's stripe under
+    /// @c ShardedPolicy).
     template <IsSetting S>
         requires(Schema::template has_setting<S>)
     [[nodiscard]] auto GetImpl() const -> typename S::value_type
     {
         using value_type = typename S::value_type;
 
-        // 1. Check environment variable (no lock needed — no mutable state accessed)
-        constexpr auto env_override = GetEnvOverride<S>();
-        if constexpr (!env_override.empty()) {
-            if (const char* env_value = std::getenv(std::string(env_override).c_str())) {
-                auto parsed = ConfigTraits<value_type>::FromString(env_value);
-                if (parsed.has_value()) {
-                    return *parsed;
+        return ReadSetting<S>([this](const State& state) -> value_type {
+            constexpr auto index = Schema::template index_of<S>;
+
+            // 1. Environment variable snapshot
+            if constexpr (HasEnvOverride<S>) {
+                if (const value_type* env_value = state.environment.template Find<S>()) {
+                    metrics_.RecordGet(index, SlotSource::kEnvironment);
+                    return *env_value;
+                }
+                if (state.environment.template Source<S>() == SlotSource::kInvalid
+                    && env_warnings_.First(index, Generation())) {
+                    constexpr std::string_view env_override = S::env_override;
+                    const std::string_view text = state.environment.template InvalidText<S>();
+                    Logger::WarnF("Failed to parse environment variable %.*s='%.*s', using fallback",
+                                  static_cast<int>(env_override.size()), env_override.data(),
+                                  static_cast<int>(text.size()), text.data());
                 }
-                Logger::WarnF("Failed to parse environment variable %.*s='%s', using fallback",
-                              static_cast<int>(env_override.size()), env_override.data(), env_value);
             }
-        }
 
-        // 2. Check file value (shared lock — concurrent readers allowed)
-        {
-            typename ThreadPolicy::shared_lock lock(mutex_);
-            auto file_result = file_values_.GetAtPath(S::path);
-            if (file_result.ok()) {
-                auto parsed = ConfigTraits<value_type>::Deserialize(*file_result);
-                if (parsed.has_value()) {
-                    return *parsed;
-                }
+            // 2./3. Pre-resolved file value or default
+            const SlotSource source = state.slots.template Source<S>();
+            metrics_.RecordGet(index, source);
+            if (source == SlotSource::kInvalid && file_warnings_.First(index, Generation())) {
                 Logger::WarnF("Failed to parse file value for '%.*s', using default",
                               static_cast<int>(S::path.size()), S::path.data());
             }
-        }
-
-        // 3. Return default value (immutable after construction — no lock needed)
-        return S::default_value();
+            return state.slots.template Get<S>();
+        });
     }
 
     /// @brief Sets the value for a setting type.
     ///
     /// Thread safety: validation runs without holding any lock; the actual
-    /// mutation of internal state acquires an exclusive (writer) lock.
+    /// mutation of internal state acquires an exclusive (writer) lock (under
+    /// @c ShardedPolicy, of the setting's stripe and the Value tree only).
     template <IsSetting S>
         requires(Schema::template has_setting<S>)
     auto SetImpl(typename S::value_type value) -> Status
@@ -151,38 +192,268 @@ public:
         using value_type = typename S::value_type;
 
         // Validate the value *before* acquiring the exclusive lock
-        auto validator = GetSettingValidator<S>();
+        const auto& validator = GetSettingValidator<S>();
         auto validation = validator(value);
         if (!validation) {
             return InvalidArgumentError(validation.error_message);
         }
 
         // Set the value under exclusive lock
-        typename ThreadPolicy::unique_lock lock(mutex_);
         auto serialized = ConfigTraits<value_type>::Serialize(value);
-        file_values_.SetAtPath(S::path, serialized);
+        WriteSetting<S>([&](State& state) {
+            state.SetFileValue(S::path, serialized);
+            state.slots.template Assign<S>(std::move(value), SlotSource::kFile);
+        });
+        metrics_.RecordSet(Schema::template index_of<S>);
 
         return OkStatus();
     }
 
+    /// @brief Gets the effective value of the setting at @p path, as @c Get would return it.
+    ///
+    /// @p path is mapped to its slot through @c ConfigSchema::FindIndex, so
+    /// the lookup never walks the Value tree.  Returns @c kNotFound for a
+    /// path that is not in the schema.
+    ///
+    /// Thread safety: as @c Get.
+    [[nodiscard]] auto GetByPath(std::string_view path) const -> StatusOr<Value> override
+    {
+        const auto index = Schema::FindIndex(path);
+        if (!index.has_value()) {
+            return NotFoundError("Unknown setting: " + std::string(path));
+        }
+        return kPathGetters[*index](*this);
+    }
+
+    /// @brief Sets the setting at @p path from a Value, as @c Set would.
+    ///
+    /// Returns @c kNotFound for a path that is not in the schema and
+    /// @c kInvalidArgument when @p value does not convert to the setting's
+    /// type or fails its validator.
+    ///
+    /// Thread safety: as @c Set.
+    auto SetByPath(std::string_view path, const Value& value) -> Status override
+    {
+        const auto index = Schema::FindIndex(path);
+        if (!index.has_value()) {
+            return NotFoundError("Unknown setting: " + std::string(path));
+        }
+        return kPathSetters[*index](*this, value);
+    }
+
+    /// @brief Starts a batch of updates that @c Transaction::Commit applies atomically.
+    ///
+    /// Thread safety: staging takes no lock; @c Commit validates without a
+    /// lock and takes the exclusive (writer) lock once for the whole batch.
+    [[nodiscard]] auto Transaction() -> cppfig::Transaction<Configuration> { return cppfig::Transaction<Configuration>(*this); }
+
     /// @brief Loads configuration from the file.
     ///
+    /// Also re-reads the environment variable overrides.
+    ///
     /// Thread safety: acquires an exclusive (writer) lock for the entire
-    /// operation because it mutates @c file_values_.
+    /// operation because it mutates the file values.
     [[nodiscard]] auto LoadImpl() -> Status
     {
-        typename ThreadPolicy::unique_lock lock(mutex_);
-        return LoadUnlocked();
+        const auto start = recorder_type::StartTimer();
+        change_set changed;
+        Status status = OkStatus();
+        {
+            typename ThreadPolicy::unique_lock save_lock(save_mutex_);
+            std::optional<Value> on_disk;
+            std::optional<SnapshotStamp> on_disk_stamp;
+            auto load = [this, &on_disk, &on_disk_stamp, lap = start](State& state) mutable {
+                state.environment.ResolveAll();
+                auto load_status = LoadUnlocked(state, on_disk, on_disk_stamp, lap);
+                state.fingerprint = state.file_values.Hash();
+                return load_status;
+            };
+            status = WriteStateLocked(load, changed);
+            if (on_disk.has_value()) {
+                saved_values_ = std::move(on_disk);
+                saved_stamp_ = on_disk_stamp;
+            }
+        }
+        metrics_.RecordOperation(MetricsOperation::kLoad, start, status.ok());
+        Notify(changed);
+        return status;
+    }
+
+    /// @brief Re-reads the configuration file without blocking readers during I/O.
+    ///
+    /// Unlike @c Load, the file is read, parsed, resolved and validated
+    /// before any lock is taken; the new state is then swapped in with a
+    /// single move (a pointer exchange under @c SnapshotPolicy).  A file that
+    /// fails to parse or validate leaves the current state untouched.  The
+    /// file must already exist: @c Reload never creates, migrates or saves it.
+    /// When the file's @c Fingerprint and the environment overrides match the
+    /// current state, nothing is resolved, validated, swapped or notified and
+    /// @c Reload returns OK.
+    ///
+    /// Thread safety: holds the exclusive (writer) lock only for the swap.
+    [[nodiscard]] auto Reload() -> Status
+    {
+        const auto start = recorder_type::StartTimer();
+        auto status = ReloadTimed(start);
+        metrics_.RecordOperation(MetricsOperation::kLoad, start, status.ok());
+        return status;
+    }
+
+    /// @brief Loads the file values from a binary snapshot, falling back to @c Load.
+    ///
+    /// The snapshot at @p snapshot_path (see @c SaveSnapshot) is used only
+    /// if it was written by a schema with the same @c ConfigSchema::hash and
+    /// the configuration file still has the size and modification time it
+    /// had then; the snapshot is then decoded without parsing the text file.
+    /// Otherwise (missing, stale or corrupt snapshot) the configuration is
+    /// loaded with @c Load and a fresh snapshot is written for the next start;
+    /// failing to write it is logged but does not fail the load.
+    ///
+    /// Thread safety: as @c Load.
+    [[nodiscard]] auto LoadSnapshot(const std::string& snapshot_path) -> Status
+    {
+        SnapshotStamp stamp;
+        auto snapshot = ReadSnapshot(snapshot_path, stamp);
+        if (!snapshot.ok()) {
+            Logger::InfoF("Snapshot '%s' not used (%s), loading '%s'", snapshot_path.c_str(),
+                          std::string(snapshot.status().message()).c_str(), file_path_.c_str());
+            auto status = LoadImpl();
+            if (!status.ok()) {
+                return status;
+            }
+            auto snapshot_status = SaveSnapshot(snapshot_path);
+            if (!snapshot_status.ok()) {
+                Logger::WarnF("Failed to write snapshot '%s': %s", snapshot_path.c_str(),
+                              std::string(snapshot_status.message()).c_str());
+            }
+            return OkStatus();
+        }
+
+        change_set changed;
+        {
+            typename ThreadPolicy::unique_lock save_lock(save_mutex_);
+            auto install = [&snapshot](State& state) {
+                state.environment.ResolveAll();
+                state.file_values = *snapshot;
+                state.slots.ResolveAll(state.file_values);
+                state.fingerprint = state.file_values.Hash();
+            };
+            WriteStateLocked(install, changed);
+            saved_values_ = *std::move(snapshot);
+            saved_stamp_ = stamp;
+        }
+        Notify(changed);
+        return OkStatus();
+    }
+
+    /// @brief Writes the file values as last loaded or saved to a binary snapshot at @p snapshot_path.
+    ///
+    /// The snapshot mirrors the configuration file, not unsaved changes; it
+    /// is stamped with the schema hash and the file's size and modification
+    /// time so that @c LoadSnapshot can tell when it went stale.  The stamp
+    /// is the one taken when the values were read or written; if the file
+    /// no longer matches it (it was changed by someone else since), nothing
+    /// is written and an error is returned.
+    ///
+    /// Thread safety: serialized with @c Save; does not block readers.
+    [[nodiscard]] auto SaveSnapshot(const std::string& snapshot_path) const -> Status
+    {
+        typename ThreadPolicy::unique_lock save_lock(save_mutex_);
+        if (!saved_values_.has_value() || !saved_stamp_.has_value()) {
+            return NotFoundError("Configuration has not been loaded or saved: " + file_path_);
+        }
+        auto stamp = SnapshotStamp::ForFile(Schema::hash, file_path_);
+        if (!stamp.ok()) {
+            return stamp.status();
+        }
+        if (*stamp != *saved_stamp_) {
+            return InvalidArgumentError("Configuration file changed since it was last loaded or saved: " + file_path_);
+        }
+        return detail::WriteFileAtomically(snapshot_path, BinarySerializer::Stringify(*saved_values_, *saved_stamp_));
+    }
+
+    /// @brief Re-reads the environment variable overrides of all settings.
+    ///
+    /// The environment is snapshotted at construction and on every @c Load;
+    /// call this after changing the process environment in between.
+    ///
+    /// Thread safety: acquires an exclusive (writer) lock.  @c std::getenv
+    /// must not race with @c setenv in other threads.
+    void RefreshEnvironment()
+    {
+        WriteState([](State& state) { state.environment.ResolveAll(); });
     }
 
     /// @brief Saves the current configuration to the file.
     ///
-    /// Thread safety: acquires a shared (reader) lock because it only reads
-    /// @c file_values_ (file I/O is serialized by the OS for the same path).
+    /// Does nothing when the file values are unchanged since the file was
+    /// last loaded, reloaded or saved (and the file still exists).  Otherwise
+    /// the file is replaced atomically through a temporary file, so a crash
+    /// mid-save never leaves a truncated configuration behind.
+    ///
+    /// Thread safety: the file values are shared out of the state under a
+    /// shared (reader) lock (a copy-on-write reference, not a deep copy);
+    /// serialization and file I/O run without holding it.  Concurrent saves
+    /// are serialized.
     [[nodiscard]] auto SaveImpl() const -> Status
     {
-        typename ThreadPolicy::shared_lock lock(mutex_);
-        return SaveUnlocked();
+        const auto start = recorder_type::StartTimer();
+        auto lap = start;
+        Status status = OkStatus();
+        {
+            typename ThreadPolicy::unique_lock save_lock(save_mutex_);
+            Value current = ReadState([](const State& state) { return state.file_values; });
+            // The file must also be untouched since it was last read or written
+            const bool unchanged = saved_values_.has_value() && *saved_values_ == current && saved_stamp_.has_value()
+                && StampFile() == saved_stamp_;
+            metrics_.RecordPhase(MetricsOperation::kSave, MetricsPhase::kDiff, lap);
+            if (!unchanged) {
+                status = WriteValues(current, MetricsOperation::kSave, lap);
+                if (status.ok()) {
+                    saved_values_ = std::move(current);
+                    saved_stamp_ = StampFile();
+                }
+            }
+        }
+        metrics_.RecordOperation(MetricsOperation::kSave, start, status.ok());
+        return status;
+    }
+
+    /// @brief Returns whether the file values changed since the file was last loaded, reloaded or saved.
+    ///
+    /// A configuration that never touched its file is dirty.
+    ///
+    /// Thread safety: holds the save lock exclusively (serialized with
+    /// @c Save and @c SaveSnapshot) and reads the state under a shared
+    /// (reader) lock; does not block readers.
+    [[nodiscard]] auto IsDirty() const -> bool
+    {
+        typename ThreadPolicy::unique_lock save_lock(save_mutex_);
+        if (!saved_values_.has_value()) {
+            return true;
+        }
+        return ReadState([this](const State& state) { return state.file_values != *saved_values_; });
+    }
+
+    /// @brief Returns the schema paths whose file value changed since the last load, reload or save.
+    ///
+    /// Paths are returned in schema order.  Before the file was ever loaded
+    /// or saved, every schema path is reported.
+    ///
+    /// Thread safety: as @c IsDirty.
+    [[nodiscard]] auto DirtyPaths() const -> std::vector<std::string_view>
+    {
+        std::vector<std::string_view> paths;
+        paths.reserve(Schema::size);
+        Schema::ForEachSetting([&paths]<typename S>() { paths.push_back(S::path); });
+
+        typename ThreadPolicy::unique_lock save_lock(save_mutex_);
+        if (!saved_values_.has_value()) {
+            return paths;
+        }
+        const Value current = ReadState([](const State& state) { return state.file_values; });
+        std::erase_if(paths, [this, &current](std::string_view path) { return !PathDiffers(*saved_values_, current, path); });
+        return paths;
     }
 
     /// @brief Returns the diff between file values and defaults.
@@ -190,8 +461,7 @@ public:
     /// Thread safety: acquires a shared (reader) lock.
     [[nodiscard]] auto DiffImpl() const -> ConfigDiff
     {
-        typename ThreadPolicy::shared_lock lock(mutex_);
-        return DiffFileFromDefaults(defaults_, file_values_);
+        return ReadState([this](const State& state) { return DiffFileFromDefaults(SharedDefaults(), state.file_values); });
     }
 
     /// @brief Validates all current values against their validators.
@@ -199,8 +469,118 @@ public:
     /// Thread safety: acquires a shared (reader) lock.
     [[nodiscard]] auto ValidateAllImpl() const -> Status
     {
-        typename ThreadPolicy::shared_lock lock(mutex_);
-        return ValidateAllUnlocked();
+        return ReadState([](const State& state) { return ValidateAllUnlocked(state); });
+    }
+
+    /// @brief Validates all current values and returns every failure.
+    ///
+    /// Unlike @c ValidateAll(), validation does not stop at the first error:
+    /// each failing setting contributes one InvalidArgument status
+    /// ("path: message"), in schema order; an empty vector means every value
+    /// is valid.  With @c ExecutionPolicy::kParallel the schema is split into
+    /// contiguous shards validated on worker threads, which pays off when
+    /// validators are expensive (regex or lookup predicates) or schemas hold
+    /// thousands of settings.  Each shard holds at least 64 settings, so
+    /// smaller schemas are validated inline.  Values come from the typed
+    /// slot cache, so no path walk or deserialization takes place.
+    ///
+    /// Thread safety: acquires a shared (reader) lock for the whole validation.
+    [[nodiscard]] auto ValidateAll(ExecutionPolicy policy) const -> std::vector<Status>
+    {
+        return ReadState([policy](const State& state) {
+            std::vector<Status> results(Schema::size);
+            const auto validate = [&state, &results](std::size_t begin, std::size_t end) {
+                for (std::size_t index = begin; index < end; ++index) {
+                    results[index] = kSlotValidators[index](state);
+                }
+            };
+            detail::ForEachShard(Schema::size, policy, detail::k_min_settings_per_shard, validate);
+            std::erase_if(results, [](const Status& status) { return status.ok(); });
+            return results;
+        });
+    }
+
+    /// @brief Registers a callback fired whenever the value of setting S changes.
+    ///
+    /// Changes are detected on @c Set, @c Load, @c Reload and
+    /// @c RefreshEnvironment by diffing only the paths of subscribed
+    /// settings.  Callbacks receive the new value and are dispatched after the
+    /// configuration lock is released, so they may safely call back into the
+    /// configuration.  A write that leaves the effective value unchanged
+    /// (e.g. a file change masked by an environment override) fires nothing.
+    ///
+    /// Thread safety: callbacks run on the writing thread; concurrent writes
+    /// may dispatch in either order.
+    template <IsSetting S>
+        requires(Schema::template has_setting<S>)
+    auto Subscribe(ChangeCallback<S> callback) -> SubscriptionId
+    {
+        typename ThreadPolicy::unique_lock lock(subscribers_mutex_);
+        auto id = subscribers_.template Add<S>(std::move(callback));
+        subscriber_count_.store(subscribers_.Size(), std::memory_order_release);
+        return id;
+    }
+
+    /// @brief Removes a subscription; returns false if @p id is unknown.
+    auto Unsubscribe(SubscriptionId id) -> bool
+    {
+        typename ThreadPolicy::unique_lock lock(subscribers_mutex_);
+        const bool removed = subscribers_.Remove(id);
+        subscriber_count_.store(subscribers_.Size(), std::memory_order_release);
+        return removed;
+    }
+
+    /// @brief Returns a cached accessor for setting S.
+    ///
+    /// The handle re-resolves its value only when @c Generation() changed
+    /// since its last read.  See @c CachedSetting.
+    template <IsSetting S>
+        requires(Schema::template has_setting<S>)
+    [[nodiscard]] auto Cached() const -> CachedSetting<Configuration, S>
+    {
+        return CachedSetting<Configuration, S>(*this);
+    }
+
+    /// @brief Returns the current state generation.
+    ///
+    /// Incremented by every @c Set and @c Load, after the new state is published.
+    ///
+    /// Thread safety: an acquire load pairing with the release increment —
+    /// a thread that sees a generation also sees the state published before
+    /// it.  Never locks (a plain load on x86).
+    [[nodiscard]] auto Generation() const -> std::uint64_t { return generation_.load(std::memory_order_acquire); }
+
+    /// @brief Returns a copy of the counters recorded by @c MetricsInstrumentation.
+    ///
+    /// Thread safety: lock-free; counters are read with relaxed loads.
+    [[nodiscard]] auto Metrics() const -> MetricsSnapshot
+        requires(InstrumentationPolicy::enabled)
+    {
+        return metrics_.Snapshot(Schema::GetPaths());
+    }
+
+    /// @brief Counts a read of setting S through a @c CachedSetting (hit: served without re-resolving).
+    template <IsSetting S>
+        requires(Schema::template has_setting<S>)
+    void RecordCacheAccess(bool hit) const
+    {
+        metrics_.RecordCache(Schema::template index_of<S>, hit);
+    }
+
+    /// @brief Returns a 64-bit structural hash of the current file values.
+    ///
+    /// Two states with equal file values have equal fingerprints; any change
+    /// alters it except with probability about 2^-64.  The fingerprint is
+    /// computed once per @c Load or @c Reload and updated incrementally by
+    /// @c Set and transactions, so this call is O(1).  Environment overrides
+    /// are not included.  Fingerprints must not be persisted (see
+    /// @c Value::Hash).  @c Reload uses it to return early when the file is
+    /// unchanged.
+    ///
+    /// Thread safety: acquires a shared (reader) lock.
+    [[nodiscard]] auto Fingerprint() const -> std::uint64_t
+    {
+        return ReadState([](const State& state) { return state.fingerprint; });
     }
 
     /// @brief Returns the file path.
@@ -210,15 +590,26 @@ public:
 
     /// @brief Returns the current file values.
     ///
-    /// @warning The returned reference is *not* protected after the call returns.
+    /// @warning The returned reference is *not* protected after the call returns
+    ///          (under @c SnapshotPolicy it is invalidated by the next write).
     ///          In multi-threaded code, prefer @c Get<Setting>() for safe access.
-    [[nodiscard]] auto GetFileValues() const -> const Value& { return file_values_; }
+    [[nodiscard]] auto GetFileValues() const -> const Value&
+    {
+        if constexpr (IsSnapshotPolicy<ThreadPolicy>) {
+            return state_.Acquire()->file_values;
+        }
+        else {
+            return state_.file_values;
+        }
+    }
 
     /// @brief Returns the default values.
     ///
-    /// Thread safety: @c defaults_ is immutable after construction — safe to call
-    /// concurrently without synchronization.
-    [[nodiscard]] auto GetDefaults() const -> const Value& { return defaults_; }
+    /// The tree is built once per @c Schema and shared by every instance.
+    ///
+    /// Thread safety: the tree is immutable — safe to call concurrently
+    /// without synchronization.
+    [[nodiscard]] auto GetDefaults() const -> const Value& { return SharedDefaults(); }
 
     [[nodiscard]] auto Load() -> Status override { return LoadImpl(); }
 
@@ -231,55 +622,490 @@ public:
     [[nodiscard]] auto GetDiffString() const -> std::string override { return DiffImpl().ToString(); }
 
 private:
+    friend class cppfig::Transaction<Configuration>;
+
+    using recorder_type = typename InstrumentationPolicy::template recorder<Schema::size>;
+    using timer_type = typename recorder_type::timer;
+
+    /// @brief Starts timing a lock acquisition; free unless instrumented under a locking policy.
+    [[nodiscard]] static auto StartLockTimer()
+    {
+        if constexpr (InstrumentationPolicy::enabled && !std::is_same_v<ThreadPolicy, SingleThreadedPolicy>) {
+            return recorder_type::StartTimer();
+        }
+        else {
+            return detail::NullTimer {};
+        }
+    }
+
+    /// @brief Mutable configuration state guarded by the thread policy.
+    struct State {
+        Value file_values;
+        SlotTable<Schema> slots;
+        EnvironmentTable<Schema> environment;
+        std::uint64_t fingerprint = 0;  ///< @c file_values.Hash(), kept in sync by every write.
+
+        /// @brief Sets the file value at @p path, updating the fingerprint incrementally.
+        void SetFileValue(std::string_view path, const Value& value) { file_values.SetAtPath(path, value, fingerprint); }
+    };
+
+    /// @brief Storage of the state: in place for locking policies, a snapshot cell otherwise.
+    template <typename Policy>
+    struct StateStorage {
+        using type = State;
+    };
+
+    template <IsSnapshotPolicy Policy>
+    struct StateStorage<Policy> {
+        using type = typename Policy::template snapshot_type<State>;
+    };
+
+    /// @brief Stripe locks of the policy: a @c StripeSet for sharded policies, empty otherwise.
+    template <typename Policy>
+    struct StripeStorage {
+        using type = detail::NoStripes;
+    };
+
+    template <IsShardedPolicy Policy>
+    struct StripeStorage<Policy> {
+        using type = typename Policy::stripe_set;
+    };
+
+    using stripe_storage = typename StripeStorage<ThreadPolicy>::type;
+
+    /// @brief Stripe guarding @p S under a sharded policy, from the hash of its top-level section.
+    template <typename S>
+    static constexpr std::size_t stripe_of = detail::Fnv1a(S::path.substr(0, S::path.find('.'))) % stripe_storage::size;
+
+    /// @brief Runs @p fn with read access to the state.
+    template <typename Fn>
+    auto ReadState(Fn&& fn) const -> decltype(auto)
+    {
+        if constexpr (IsSnapshotPolicy<ThreadPolicy>) {
+            return state_.Read(std::forward<Fn>(fn));
+        }
+        else {
+            const auto wait = StartLockTimer();
+            typename stripe_storage::template all_lock<typename ThreadPolicy::shared_lock> stripes(stripes_);
+            typename ThreadPolicy::shared_lock lock(mutex_);
+            metrics_.RecordLockWait(wait);
+            return std::forward<Fn>(fn)(state_);
+        }
+    }
+
+    /// @brief Runs @p fn with read access to the slot and environment override of @p S.
+    ///
+    /// Under a sharded policy only the stripe of @p S is locked, so @p fn must
+    /// not touch the Value tree or any other setting.
+    template <typename S, typename Fn>
+    auto ReadSetting(Fn&& fn) const -> decltype(auto)
+    {
+        if constexpr (IsShardedPolicy<ThreadPolicy>) {
+            const auto wait = StartLockTimer();
+            typename ThreadPolicy::shared_lock lock(stripes_[stripe_of<S>]);
+            metrics_.RecordLockWait(wait);
+            return std::forward<Fn>(fn)(state_);
+        }
+        else {
+            return ReadState(std::forward<Fn>(fn));
+        }
+    }
+
+    /// @brief Runs @p fn with write access to the slot of @p S and the Value tree.
+    ///
+    /// Under a sharded policy only the stripe of @p S and the tree lock are
+    /// held, so @p fn must not touch any other setting.  Subscribers of @p S
+    /// are notified after the locks are released.
+    template <typename S, typename Fn>
+    void WriteSetting(Fn&& fn)
+    {
+        if constexpr (IsShardedPolicy<ThreadPolicy>) {
+            const bool track_changes = HasSubscribers();
+            change_set changed;
+            {
+                const auto wait = StartLockTimer();
+                typename ThreadPolicy::unique_lock stripe(stripes_[stripe_of<S>]);
+                typename ThreadPolicy::unique_lock lock(mutex_);
+                metrics_.RecordLockWait(wait);
+                std::optional<Value> previous;
+                if (track_changes) {
+                    previous.emplace(state_.file_values);
+                }
+                fn(state_);
+                BumpGeneration();
+                if (previous.has_value() && state_.environment.template Source<S>() != SlotSource::kEnvironment
+                    && PathDiffers(*previous, state_.file_values, S::path)) {
+                    changed[Schema::template index_of<S>] = true;
+                }
+            }
+            Notify(changed);
+        }
+        else {
+            WriteState(std::forward<Fn>(fn));
+        }
+    }
+
+    using change_set = typename SubscriptionTable<Schema>::change_set;
+
+    /// @brief Runs @p fn with exclusive write access to the state.
+    ///
+    /// Under a snapshot policy, @p fn mutates a private copy which is then
+    /// published as the new snapshot.  The generation is bumped once the new
+    /// state is visible to readers.  Subscribers of the settings whose value
+    /// changed are notified after the lock is released.
+    template <typename Fn>
+    auto WriteState(Fn&& fn) -> decltype(auto)
+    {
+        change_set changed;
+        if constexpr (std::is_void_v<std::invoke_result_t<Fn&, State&>>) {
+            WriteStateLocked(fn, changed);
+            Notify(changed);
+        }
+        else {
+            auto result = WriteStateLocked(fn, changed);
+            Notify(changed);
+            return result;
+        }
+    }
+
+    /// @brief Body of @c WriteState run under the exclusive lock; records changed settings in @p changed.
+    template <typename Fn>
+    auto WriteStateLocked(Fn& fn, change_set& changed) -> std::invoke_result_t<Fn&, State&>
+    {
+        const bool track_changes = HasSubscribers();
+        const auto wait = StartLockTimer();
+        typename stripe_storage::template all_lock<typename ThreadPolicy::unique_lock> stripes(stripes_);
+        typename ThreadPolicy::unique_lock lock(mutex_);
+        metrics_.RecordLockWait(wait);
+        if constexpr (IsSnapshotPolicy<ThreadPolicy>) {
+            auto previous = state_.Acquire();
+            auto next = std::make_shared<State>(*previous);
+            auto publish = [&] {
+                if (track_changes) {
+                    changed = ChangedSettings(*previous, *next);
+                }
+                state_.Publish(std::move(next));
+                BumpGeneration();
+            };
+            if constexpr (std::is_void_v<std::invoke_result_t<Fn&, State&>>) {
+                fn(*next);
+                publish();
+            }
+            else {
+                auto result = fn(*next);
+                publish();
+                return result;
+            }
+        }
+        else {
+            std::optional<State> previous;
+            if (track_changes) {
+                previous.emplace(state_);
+            }
+            auto finish = [&] {
+                if (previous.has_value()) {
+                    changed = ChangedSettings(*previous, state_);
+                }
+                BumpGeneration();
+            };
+            if constexpr (std::is_void_v<std::invoke_result_t<Fn&, State&>>) {
+                fn(state_);
+                finish();
+            }
+            else {
+                auto result = fn(state_);
+                finish();
+                return result;
+            }
+        }
+    }
+
+    /// @brief Replaces the whole state with @p next under the exclusive lock.
+    ///
+    /// Under a snapshot policy the critical section is a pointer exchange;
+    /// the change set is computed afterwards from the two immutable snapshots.
+    /// Returns the changed settings; the caller notifies their subscribers.
+    [[nodiscard]] auto ReplaceState(State next) -> change_set
+    {
+        const bool track_changes = HasSubscribers();
+        change_set changed;
+        if constexpr (IsSnapshotPolicy<ThreadPolicy>) {
+            auto snapshot = std::make_shared<const State>(std::move(next));
+            std::shared_ptr<const State> previous;
+            {
+                const auto wait = StartLockTimer();
+                typename ThreadPolicy::unique_lock lock(mutex_);
+                metrics_.RecordLockWait(wait);
+                previous = state_.Acquire();
+                state_.Publish(snapshot);
+                BumpGeneration();
+            }
+            if (track_changes) {
+                changed = ChangedSettings(*previous, *snapshot);
+            }
+        }
+        else {
+            const auto wait = StartLockTimer();
+            typename stripe_storage::template all_lock<typename ThreadPolicy::unique_lock> stripes(stripes_);
+            typename ThreadPolicy::unique_lock lock(mutex_);
+            metrics_.RecordLockWait(wait);
+            std::swap(state_, next);
+            BumpGeneration();
+            if (track_changes) {
+                changed = ChangedSettings(next, state_);
+            }
+        }
+        // The previous state is destroyed by `next` after the lock is released
+        return changed;
+    }
+
+    /// @brief Applies the validated values staged by a Transaction under one exclusive lock.
+    ///
+    /// @param pending One optional value per schema slot; set values are moved out.
+    template <typename Pending>
+    void ApplyTransaction(Pending& pending)
+    {
+        // Serialize outside the lock
+        std::array<std::optional<Value>, Schema::size> serialized;
+        Schema::ForEachSetting([&pending, &serialized]<typename S>() {
+            constexpr auto index = Schema::template index_of<S>;
+            if (const auto& value = std::get<index>(pending)) {
+                serialized[index] = ConfigTraits<typename S::value_type>::Serialize(*value);
+            }
+        });
+
+        WriteState([&pending, &serialized](State& state) {
+            Schema::ForEachSetting([&]<typename S>() {
+                constexpr auto index = Schema::template index_of<S>;
+                auto& value = std::get<index>(pending);
+                if (value.has_value()) {
+                    state.SetFileValue(S::path, *serialized[index]);
+                    state.slots.template Assign<S>(std::move(*value), SlotSource::kFile);
+                }
+            });
+        });
+        for (std::size_t index = 0; index < Schema::size; ++index) {
+            if (serialized[index].has_value()) {
+                metrics_.RecordSet(index);
+            }
+        }
+    }
+
+    [[nodiscard]] auto HasSubscribers() const -> bool { return subscriber_count_.load(std::memory_order_acquire) != 0; }
+
+    /// @brief Returns the subscribed settings whose effective value differs between two states.
+    ///
+    /// A setting changed when its environment override changed, or when no
+    /// override applies and its file value was added, removed or modified.
+    [[nodiscard]] auto ChangedSettings(const State& before, const State& after) const -> change_set
+    {
+        change_set subscribed;
+        {
+            typename ThreadPolicy::unique_lock lock(subscribers_mutex_);
+            subscribed = subscribers_.Subscribed();
+        }
+
+        change_set changed;
+        Schema::ForEachSetting([&]<typename S>() {
+            constexpr auto index = Schema::template index_of<S>;
+            if (!subscribed[index]) {
+                return;
+            }
+            const bool env_active = after.environment.template Source<S>() == SlotSource::kEnvironment;
+            if (!after.environment.template SameOverride<S>(before.environment)) {
+                changed[index] = true;
+            }
+            else if (!env_active && PathDiffers(before.file_values, after.file_values, S::path)) {
+                changed[index] = true;
+            }
+        });
+        return changed;
+    }
+
+    /// @brief Invokes the callbacks of every setting in @p changed with its current value.
+    ///
+    /// Must be called without holding the state lock.
+    void Notify(const change_set& changed) const
+    {
+        if (changed.none()) {
+            return;
+        }
+        Schema::ForEachSetting([this, &changed]<typename S>() {
+            if (!changed[Schema::template index_of<S>]) {
+                return;
+            }
+            std::vector<ChangeCallback<S>> callbacks;
+            {
+                typename ThreadPolicy::unique_lock lock(subscribers_mutex_);
+                callbacks = subscribers_.template Callbacks<S>();
+            }
+            if (callbacks.empty()) {
+                return;
+            }
+            const auto value = GetImpl<S>();
+            for (const auto& callback : callbacks) {
+                callback(value);
+            }
+        });
+    }
+
+    void BumpGeneration() { generation_.fetch_add(1, std::memory_order_release); }
+
+    /// @brief Creates the initial state (file values empty, slots at defaults, environment snapshotted).
+    [[nodiscard]] static auto MakeInitialState() -> typename StateStorage<ThreadPolicy>::type
+    {
+        State state { Value::Object(), {}, {}, 0 };
+        state.fingerprint = state.file_values.Hash();
+        state.environment.ResolveAll();
+        if constexpr (IsSnapshotPolicy<ThreadPolicy>) {
+            return typename StateStorage<ThreadPolicy>::type(std::make_shared<const State>(std::move(state)));
+        }
+        else {
+            return state;
+        }
+    }
+
     /// @brief Loads configuration from the file (caller must hold exclusive lock).
-    [[nodiscard]] auto LoadUnlocked() -> Status
+    ///
+    /// Stores the file values as they are on disk afterwards in @p on_disk,
+    /// and the stamp of the file they match in @p on_disk_stamp.  Phase
+    /// timings are recorded from @p lap on.
+    [[nodiscard]] auto LoadUnlocked(State& state, std::optional<Value>& on_disk, std::optional<SnapshotStamp>& on_disk_stamp,
+                                    timer_type& lap) const -> Status
     {
         namespace fs = std::filesystem;
 
-        if (!fs::exists(file_path_)) {
+        const bool exists = fs::exists(file_path_);
+        metrics_.RecordPhase(MetricsOperation::kLoad, MetricsPhase::kIo, lap);
+        if (!exists) {
             // File doesn't exist - create with defaults
             Logger::InfoF("Configuration file '%s' not found, creating with defaults", file_path_.c_str());
-            file_values_ = defaults_;
-            return SaveUnlocked();
+            state.file_values = SharedDefaults();
+            state.slots.ResolveAll(state.file_values);
+            auto status = WriteValues(state.file_values, MetricsOperation::kLoad, lap);
+            if (status.ok()) {
+                on_disk = state.file_values;
+                on_disk_stamp = StampFile();
+            }
+            return status;
         }
 
-        // Load existing file
-        auto result = ReadFile<SerializerT>(file_path_);
+        // Load existing file (stamped before it is read, see StampFile)
+        on_disk_stamp = StampFile();
+        auto result = ReadValues(MetricsOperation::kLoad, lap);
         if (!result.ok()) {
             return result.status();
         }
 
-        file_values_ = *result;
+        state.file_values = *std::move(result);
+        state.slots.ResolveAll(state.file_values);
+        on_disk = state.file_values;
 
-        // Check for schema migration (new settings in defaults not in file)
-        auto diff = DiffDefaultsFromFile(defaults_, file_values_);
-        auto added = diff.Added();
+        // Check for schema migration: a setting whose slot fell back to its
+        // default has no file value, so only those paths need a closer look
+        change_set missing;
+        Schema::ForEachSetting([&state, &missing]<typename S>() {
+            missing[Schema::template index_of<S>] = !state.slots.template HasFileValue<S>()
+                && detail::IsMissingPath(state.file_values, S::path);
+        });
+        metrics_.RecordPhase(MetricsOperation::kLoad, MetricsPhase::kDiff, lap);
 
-        if (!added.empty()) {
+        if (missing.any()) {
             Logger::Warn("New settings detected in schema, adding to configuration file:");
-            for (const auto& entry : added) {
-                Logger::WarnF("  - %s = %s", entry.path.c_str(), entry.new_value.c_str());
-                // Copy the default value directly from the defaults tree
-                auto default_val = defaults_.GetAtPath(entry.path);
-                if (default_val.ok()) {
-                    file_values_.SetAtPath(entry.path, *default_val);
+            Schema::ForEachSetting([this, &state, &missing]<typename S>() {
+                if (!missing[Schema::template index_of<S>]) {
+                    return;
                 }
-            }
+                // Copy the default value directly from the defaults tree
+                const Value* default_val = SharedDefaults().FindAtPath(S::path);
+                Logger::WarnF("  - %.*s = %s", static_cast<int>(S::path.size()), S::path.data(), default_val->Dump().c_str());
+                state.file_values.SetAtPath(S::path, *default_val);
+                state.slots.template Resolve<S>(state.file_values);
+            });
 
             // Save the updated configuration
-            auto save_status = SaveUnlocked();
+            auto save_status = WriteValues(state.file_values, MetricsOperation::kLoad, lap);
             if (!save_status.ok()) {
                 Logger::ErrorF("Failed to save migrated configuration: %s",
                                std::string(save_status.message()).c_str());
                 return save_status;
             }
+            on_disk = state.file_values;
+            on_disk_stamp = StampFile();
         }
 
         return OkStatus();
     }
 
-    /// @brief Saves the current configuration to the file (caller must hold at least a shared lock).
-    [[nodiscard]] auto SaveUnlocked() const -> Status
+    /// @brief Reads the snapshot at @p snapshot_path if its stamp matches the schema and the current file.
+    ///
+    /// On success @p matched holds that stamp.
+    [[nodiscard]] auto ReadSnapshot(const std::string& snapshot_path, SnapshotStamp& matched) const -> StatusOr<Value>
+    {
+        auto stamp = SnapshotStamp::ForFile(Schema::hash, file_path_);
+        if (!stamp.ok()) {
+            return stamp.status();
+        }
+        auto contents = detail::FileContents::Open(snapshot_path);
+        if (!contents.ok()) {
+            return contents.status();
+        }
+        auto recorded = BinarySerializer::ReadStamp(contents->View());
+        if (!recorded.ok()) {
+            return recorded.status();
+        }
+        if (*recorded != *stamp) {
+            return InvalidArgumentError("Snapshot is stale: " + snapshot_path);
+        }
+        matched = *stamp;
+        return BinarySerializer::ParseBuffer(contents->View());
+    }
+
+    /// @brief Returns the stamp of the configuration file, or nullopt if it cannot be stat'ed.
+    ///
+    /// Taken before a file is read, so that a concurrent rewrite leaves a
+    /// stamp that no longer matches, and right after a file is written.
+    [[nodiscard]] auto StampFile() const -> std::optional<SnapshotStamp>
+    {
+        auto stamp = SnapshotStamp::ForFile(Schema::hash, file_path_);
+        return stamp.ok() ? std::optional<SnapshotStamp>(*stamp) : std::nullopt;
+    }
+
+    /// @brief Reads and parses the file, recording the phases of @p operation from @p lap on.
+    ///
+    /// String settings that the serializer read as lists get their text back
+    /// (see @c detail::RestoreListTexts).
+    [[nodiscard]] auto ReadValues(MetricsOperation operation, timer_type& lap, FileRead read = FileRead::kMapped) const
+        -> StatusOr<Value>
+    {
+        Value list_texts;
+        StatusOr<Value> result = [&]() -> StatusOr<Value> {
+            if constexpr (InstrumentationPolicy::enabled && HasParseBuffer<SerializerT>) {
+                auto contents = detail::FileContents::Open(file_path_, read);
+                metrics_.RecordPhase(operation, MetricsPhase::kIo, lap);
+                if (!contents.ok()) {
+                    return contents.status();
+                }
+                return detail::ParseBuffer<SerializerT>(contents->View(), list_texts);
+            }
+            else {
+                // Stream serializers read and parse in one pass
+                return ReadFile<SerializerT>(file_path_, read, list_texts);
+            }
+        }();
+        metrics_.RecordPhase(operation, MetricsPhase::kParse, lap);
+        if (!result.ok()) {
+            return result;
+        }
+        Value values = *std::move(result);
+        detail::RestoreListTexts<Schema>(values, list_texts);
+        return values;
+    }
+
+    /// @brief Writes @p values to the file, creating parent directories as needed.
+    ///
+    /// Records the phases of @p operation from @p lap on.
+    [[nodiscard]] auto WriteValues(const Value& values, MetricsOperation operation, timer_type& lap) const -> Status
     {
         namespace fs = std::filesystem;
 
@@ -293,52 +1119,175 @@ private:
             }
         }
 
-        return WriteFile<SerializerT>(file_path_, file_values_);
+        const std::string contents = SerializerT::Stringify(values);
+        metrics_.RecordPhase(operation, MetricsPhase::kSerialize, lap);
+        auto status = detail::WriteFileAtomically(file_path_, contents);
+        metrics_.RecordPhase(operation, MetricsPhase::kIo, lap);
+        return status;
     }
 
-    /// @brief Validates all values (caller must hold at least a shared lock).
-    [[nodiscard]] auto ValidateAllUnlocked() const -> Status
+    /// @brief Body of @c Reload; records its phases from @p start on.
+    [[nodiscard]] auto ReloadTimed(timer_type start) -> Status
     {
-        Status status = OkStatus();
+        auto lap = start;
+        const auto stamp = StampFile();
+        // Reloads follow external edits, which may truncate the file while it is parsed
+        auto result = ReadValues(MetricsOperation::kLoad, lap, FileRead::kCopied);
+        if (!result.ok()) {
+            return result.status();
+        }
 
-        Schema::ForEachSetting([this, &status]<typename S>() {
-            if (!status.ok()) {
-                return;  // Stop on first error
-            }
+        State next { std::move(*result), {}, {}, 0 };
+        next.fingerprint = next.file_values.Hash();
+        next.environment.ResolveAll();
 
-            using value_type = typename S::value_type;
-            auto file_result = file_values_.GetAtPath(S::path);
-
-            if (file_result.ok()) {
-                auto parsed = ConfigTraits<value_type>::Deserialize(*file_result);
-                if (parsed.has_value()) {
-                    auto validator = GetSettingValidator<S>();
-                    auto validation = validator(*parsed);
-                    if (!validation) {
-                        status = InvalidArgumentError(std::string(S::path) + ": " + validation.error_message);
-                    }
-                }
-            }
+        // An unchanged file under unchanged overrides needs no resolution,
+        // validation, state swap or notification
+        const bool unchanged = ReadState([&next](const State& current) {
+            bool same = current.fingerprint == next.fingerprint;
+            Schema::ForEachSetting([&]<typename S>() { same = same && current.environment.template SameOverride<S>(next.environment); });
+            return same;
         });
+        metrics_.RecordPhase(MetricsOperation::kLoad, MetricsPhase::kDiff, lap);
+        if (unchanged) {
+            typename ThreadPolicy::unique_lock save_lock(save_mutex_);
+            saved_values_ = std::move(next.file_values);
+            saved_stamp_ = stamp;
+            return OkStatus();
+        }
 
-        return status;
+        next.slots.ResolveAll(next.file_values);
+
+        auto status = ValidateAllUnlocked(next);
+        metrics_.RecordPhase(MetricsOperation::kLoad, MetricsPhase::kValidate, lap);
+        if (!status.ok()) {
+            return status;
+        }
+
+        change_set changed;
+        {
+            typename ThreadPolicy::unique_lock save_lock(save_mutex_);
+            saved_values_ = next.file_values;
+            saved_stamp_ = stamp;
+            changed = ReplaceState(std::move(next));
+        }
+        Notify(changed);
+        return OkStatus();
+    }
+
+    /// @brief Validates the file value of setting S held by its slot.
+    ///
+    /// Only values that came from the file are checked; defaults, overrides
+    /// and values that failed to parse are skipped, and so are settings
+    /// without a validator, leaving deferred slots unparsed.
+    template <IsSetting S>
+    [[nodiscard]] static auto ValidateSlot(const State& state) -> Status
+    {
+        if constexpr (!HasValidator<S>) {
+            return OkStatus();
+        }
+        if (state.slots.template Source<S>() != SlotSource::kFile) {
+            return OkStatus();
+        }
+        auto validation = GetSettingValidator<S>()(state.slots.template Get<S>());
+        if (!validation) {
+            return InvalidArgumentError(std::string(S::path) + ": " + validation.error_message);
+        }
+        return OkStatus();
+    }
+
+    using path_getter_fn = Value (*)(const Configuration&);
+    using path_setter_fn = Status (*)(Configuration&, const Value&);
+
+    template <IsSetting S>
+    [[nodiscard]] static auto GetSettingValue(const Configuration& self) -> Value
+    {
+        return ConfigTraits<typename S::value_type>::Serialize(self.GetImpl<S>());
+    }
+
+    template <IsSetting S>
+    [[nodiscard]] static auto SetSettingValue(Configuration& self, const Value& value) -> Status
+    {
+        auto parsed = ConfigTraits<typename S::value_type>::Deserialize(value);
+        if (!parsed.has_value()) {
+            return InvalidArgumentError(std::string(S::path) + ": value has the wrong type");
+        }
+        return self.SetImpl<S>(*std::move(parsed));
+    }
+
+    /// @brief @c GetSettingValue and @c SetSettingValue of every setting, indexed by slot.
+    static inline const std::array<path_getter_fn, Schema::size> kPathGetters = [] {
+        std::array<path_getter_fn, Schema::size> getters {};
+        Schema::ForEachSetting([&getters]<typename S>() { getters[Schema::template index_of<S>] = &GetSettingValue<S>; });
+        return getters;
+    }();
+    static inline const std::array<path_setter_fn, Schema::size> kPathSetters = [] {
+        std::array<path_setter_fn, Schema::size> setters {};
+        Schema::ForEachSetting([&setters]<typename S>() { setters[Schema::template index_of<S>] = &SetSettingValue<S>; });
+        return setters;
+    }();
+
+    using slot_validator_fn = Status (*)(const State&);
+
+    /// @brief @c ValidateSlot of every setting, indexed by slot.
+    static inline const std::array<slot_validator_fn, Schema::size> kSlotValidators = [] {
+        std::array<slot_validator_fn, Schema::size> validators {};
+        Schema::ForEachSetting([&validators]<typename S>() { validators[Schema::template index_of<S>] = &ValidateSlot<S>; });
+        return validators;
+    }();
+
+    /// @brief Validates all values, stopping at the first error (caller must hold at least a shared lock).
+    [[nodiscard]] static auto ValidateAllUnlocked(const State& state) -> Status
+    {
+        for (auto validate : kSlotValidators) {
+            auto status = validate(state);
+            if (!status.ok()) {
+                return status;
+            }
+        }
+        return OkStatus();
     }
 
-    void BuildDefaults()
+    [[nodiscard]] static auto BuildDefaults() -> Value
     {
-        defaults_ = Value::Object();
+        auto defaults = Value::Object();
 
-        Schema::ForEachSetting([this]<typename S>() {
+        Schema::ForEachSetting([&defaults]<typename S>() {
             using value_type = typename S::value_type;
             auto serialized = ConfigTraits<value_type>::Serialize(S::default_value());
-            defaults_.SetAtPath(S::path, serialized);
+            defaults.SetAtPath(S::path, serialized);
         });
+
+        return defaults;
+    }
+
+    /// @brief Returns the defaults tree of the schema, built on first use.
+    ///
+    /// Copies are cheap: Value objects share their storage until written.
+    [[nodiscard]] static auto SharedDefaults() -> const Value&
+    {
+        static const Value defaults = BuildDefaults();
+        return defaults;
     }
 
     std::string file_path_;
-    Value file_values_;
-    Value defaults_;
-    mutable typename ThreadPolicy::mutex_type mutex_;
+    typename StateStorage<ThreadPolicy>::type state_;
+    std::atomic<std::uint64_t> generation_ { 0 };
+    mutable detail::WarnOnce<Schema::size> env_warnings_;  ///< Invalid environment overrides reported by @c Get.
+    mutable detail::WarnOnce<Schema::size> file_warnings_;  ///< Invalid file values reported by @c Get.
+    [[no_unique_address]] recorder_type metrics_;
+    mutable typename ThreadPolicy::mutex_type mutex_;  ///< Under @c ShardedPolicy, guards the Value tree only.
+    [[no_unique_address]] mutable stripe_storage stripes_;  ///< Guard the slots of their settings (sharded only).
+
+    /// @brief File values as last read from or written to the file (guarded by @c save_mutex_).
+    mutable std::optional<Value> saved_values_;
+    /// @brief Stamp of the file @c saved_values_ was read from or written to (guarded by @c save_mutex_).
+    mutable std::optional<SnapshotStamp> saved_stamp_;
+    mutable typename ThreadPolicy::mutex_type save_mutex_;
+
+    SubscriptionTable<Schema> subscribers_;
+    std::atomic<std::size_t> subscriber_count_ { 0 };
+    mutable typename ThreadPolicy::mutex_type subscribers_mutex_;
 };
 
 }  // namespace cppfig
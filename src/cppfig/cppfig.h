@@ -1,17 +1,28 @@
 #pragma once
 
+#include "cppfig/binary.h"         // IWYU pragma: export
+#include "cppfig/cache.h"          // IWYU pragma: export
 #include "cppfig/conf.h"           // IWYU pragma: export
 #include "cppfig/configuration.h"  // IWYU pragma: export
 #include "cppfig/diff.h"           // IWYU pragma: export
+#include "cppfig/execution.h"      // IWYU pragma: export
+#include "cppfig/flat_map.h"       // IWYU pragma: export
+#include "cppfig/instrumentation.h"  // IWYU pragma: export
 #include "cppfig/interface.h"      // IWYU pragma: export
+#include "cppfig/layered.h"        // IWYU pragma: export
+#include "cppfig/loader.h"         // IWYU pragma: export
 #include "cppfig/logging.h"        // IWYU pragma: export
 #include "cppfig/schema.h"         // IWYU pragma: export
 #include "cppfig/serializer.h"     // IWYU pragma: export
 #include "cppfig/setting.h"        // IWYU pragma: export
+#include "cppfig/slots.h"          // IWYU pragma: export
+#include "cppfig/subscription.h"   // IWYU pragma: export
 #include "cppfig/thread_policy.h"  // IWYU pragma: export
 #include "cppfig/traits.h"         // IWYU pragma: export
+#include "cppfig/transaction.h"    // IWYU pragma: export
 #include "cppfig/validator.h"      // IWYU pragma: export
 #include "cppfig/value.h"          // IWYU pragma: export
+#include "cppfig/watcher.h"        // IWYU pragma: export
 
 /// @namespace cppfig
 /// @brief C++20 compile-time type-safe configuration library.
@@ -3,6 +3,9 @@
 #include <cstdint>
 #include <sstream>
 #include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 #include "cppfig/value.h"
@@ -15,11 +18,35 @@ enum class DiffType : std::uint8_t { Added,
                                      Modified };
 
 /// @brief Represents a single difference between two configurations.
+///
+/// The values are kept as @c Value in @c before / @c after (container
+/// copies share storage) and only rendered to text by @c OldValue(),
+/// @c NewValue() or @c ConfigDiff::ToString, so building a diff never
+/// formats anything.
 struct DiffEntry {
     DiffType type;
     std::string path;
-    std::string old_value;
-    std::string new_value;
+    Value before;  ///< Value before the change (null for Added entries).
+    Value after;   ///< Value after the change (null for Removed entries).
+
+    DiffEntry(DiffType change, std::string changed_path, Value old, Value current)
+        : type(change)
+        , path(std::move(changed_path))
+        , before(std::move(old))
+        , after(std::move(current))
+    {
+    }
+
+    /// @brief Entries are built from Values; wrap text in @c Value explicitly if it is the value itself.
+    template <typename Before, typename After>
+        requires(std::is_convertible_v<Before, std::string_view> || std::is_convertible_v<After, std::string_view>)
+    DiffEntry(DiffType change, std::string changed_path, Before&& old, After&& current) = delete;
+
+    /// @brief Renders the old value (empty for Added entries).
+    [[nodiscard]] auto OldValue() const -> std::string { return type == DiffType::Added ? std::string() : before.Dump(); }
+
+    /// @brief Renders the new value (empty for Removed entries).
+    [[nodiscard]] auto NewValue() const -> std::string { return type == DiffType::Removed ? std::string() : after.Dump(); }
 
     [[nodiscard]] auto TypeString() const -> std::string
     {
@@ -81,13 +108,13 @@ public:
             ss << "  [" << entry.TypeString() << "] " << entry.path;
             switch (entry.type) {
             case DiffType::Added:
-                ss << " = " << entry.new_value;
+                ss << " = " << entry.NewValue();
                 break;
             case DiffType::Removed:
-                ss << " (was: " << entry.old_value << ")";
+                ss << " (was: " << entry.OldValue() << ")";
                 break;
             case DiffType::Modified:
-                ss << ": " << entry.old_value << " -> " << entry.new_value;
+                ss << ": " << entry.OldValue() << " -> " << entry.NewValue();
                 break;
             }
             ss << "\n";
@@ -100,24 +127,29 @@ public:
 namespace detail {
 
     /// @brief Recursively compares two Value objects and collects differences.
+    ///
+    /// Nested objects are descended into directly rather than compared first,
+    /// so each subtree is walked once; subtrees sharing storage are skipped.
     inline void CompareValueRecursive(const Value& base, const Value& target, const std::string& prefix,
                                       ConfigDiff& diff)
     {
         // Check for keys in target that are not in base (added)
         if (target.IsObject()) {
             for (const auto& [key, value] : target.Items()) {
-                std::string path = prefix.empty() ? key : prefix + "." + key;
+                const Value* base_value = base.Find(key);
+                if (base_value != nullptr && base_value->SharesStorageWith(value)) {
+                    continue;
+                }
 
-                if (!base.IsObject() || !base.Contains(key)) {
-                    diff.entries.push_back({ DiffType::Added, path, "", value.Dump() });
+                std::string path = prefix.empty() ? key : prefix + "." + key;
+                if (base_value == nullptr) {
+                    diff.entries.push_back({ DiffType::Added, std::move(path), Value(), value });
+                }
+                else if (base_value->IsObject() && value.IsObject()) {
+                    CompareValueRecursive(*base_value, value, path, diff);
                 }
-                else if (base[key] != value) {
-                    if (base[key].IsObject() && value.IsObject()) {
-                        CompareValueRecursive(base[key], value, path, diff);
-                    }
-                    else {
-                        diff.entries.push_back({ DiffType::Modified, path, base[key].Dump(), value.Dump() });
-                    }
+                else if (*base_value != value) {
+                    diff.entries.push_back({ DiffType::Modified, std::move(path), *base_value, value });
                 }
             }
         }
@@ -125,15 +157,38 @@ namespace detail {
         // Check for keys in base that are not in target (removed)
         if (base.IsObject()) {
             for (const auto& [key, value] : base.Items()) {
-                std::string path = prefix.empty() ? key : prefix + "." + key;
-
-                if (!target.IsObject() || !target.Contains(key)) {
-                    diff.entries.push_back({ DiffType::Removed, path, value.Dump(), "" });
+                if (target.Find(key) == nullptr) {
+                    std::string path = prefix.empty() ? key : prefix + "." + key;
+                    diff.entries.push_back({ DiffType::Removed, std::move(path), value, Value() });
                 }
             }
         }
     }
 
+    /// @brief Checks whether @p path is absent from @p tree and could be added without replacing a value.
+    ///
+    /// This is the case when the walk along @p path only meets objects until
+    /// a segment is missing; a path blocked by a scalar is a modification of
+    /// that scalar, not an addition (mirroring what @c DiffValues reports).
+    inline auto IsMissingPath(const Value& tree, std::string_view path) -> bool
+    {
+        const Value* current = &tree;
+        while (true) {
+            if (!current->IsObject()) {
+                return false;
+            }
+            const auto dot = path.find('.');
+            current = current->Find(path.substr(0, dot));
+            if (current == nullptr) {
+                return true;
+            }
+            if (dot == std::string_view::npos) {
+                return false;
+            }
+            path.remove_prefix(dot + 1);
+        }
+    }
+
 }  // namespace detail
 
 /// @brief Compares two Value configurations and returns the differences.
@@ -148,6 +203,63 @@ inline auto DiffValues(const Value& base, const Value& target) -> ConfigDiff
     return diff;
 }
 
+/// @brief Compares two configurations at the given paths only.
+///
+/// Instead of walking both trees, each path is looked up in @p base and
+/// @p target, so the cost is proportional to the number of paths rather
+/// than to the size of the trees.  Entries are emitted in the order of
+/// @p paths.
+///
+/// @param base The configuration before the change.
+/// @param target The configuration after the change.
+/// @param paths The dot-separated paths to compare (e.g. @c Schema::GetPaths()).
+/// @return A ConfigDiff containing the differences at those paths.
+template <typename Paths>
+auto DiffPaths(const Value& base, const Value& target, const Paths& paths) -> ConfigDiff
+{
+    ConfigDiff diff;
+    for (const std::string_view path : paths) {
+        const Value* base_value = base.FindAtPath(path);
+        const Value* target_value = target.FindAtPath(path);
+
+        if (base_value == nullptr && target_value != nullptr) {
+            diff.entries.push_back({ DiffType::Added, std::string(path), Value(), *target_value });
+        }
+        else if (base_value != nullptr && target_value == nullptr) {
+            diff.entries.push_back({ DiffType::Removed, std::string(path), *base_value, Value() });
+        }
+        else if (base_value != nullptr && *base_value != *target_value) {
+            diff.entries.push_back({ DiffType::Modified, std::string(path), *base_value, *target_value });
+        }
+    }
+    return diff;
+}
+
+/// @brief Checks whether the value at @p path was added, removed or modified.
+///
+/// Equivalent to asking whether @c DiffPaths reports @p path, without
+/// building an entry.
+inline auto PathDiffers(const Value& base, const Value& target, std::string_view path) -> bool
+{
+    const Value* base_value = base.FindAtPath(path);
+    const Value* target_value = target.FindAtPath(path);
+    if (base_value == nullptr || target_value == nullptr) {
+        return base_value != target_value;
+    }
+    return *base_value != *target_value;
+}
+
+/// @brief Compares two configurations at the paths of a schema only.
+///
+/// Keys outside the schema are ignored; entries follow schema order.
+///
+/// @tparam Schema The ConfigSchema whose paths are compared.
+template <typename Schema>
+auto DiffSchema(const Value& base, const Value& target) -> ConfigDiff
+{
+    return DiffPaths(base, target, Schema::GetPaths());
+}
+
 /// @brief Compares file configuration against defaults.
 ///
 /// Shows what settings in the file differ from defaults:
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+namespace cppfig {
+
+/// @brief How a bulk operation over the schema (e.g. @c ValidateAll) is executed.
+enum class ExecutionPolicy : std::uint8_t {
+    kSequential,  ///< Run on the calling thread.
+    kParallel,    ///< Split the work into contiguous shards run on worker threads.
+};
+
+namespace detail {
+
+    /// @brief Fewest settings worth a shard of their own when validating in parallel.
+    ///
+    /// Starting a worker thread costs tens of microseconds, far more than
+    /// checking a few dozen cheap validators.
+    inline constexpr std::size_t k_min_settings_per_shard = 64;
+
+    /// @brief Calls @p fn(begin, end) over contiguous shards covering [0, count).
+    ///
+    /// With @c ExecutionPolicy::kParallel the range is split into up to one
+    /// shard per hardware thread, each holding at least @p min_shard_size
+    /// items; the calling thread runs the first shard and the others run on
+    /// short-lived worker threads that are joined before returning.  A range
+    /// too small for two shards runs inline.  If a worker cannot be started
+    /// its shard runs inline.  @p fn must be safe to call concurrently on
+    /// disjoint shards.
+    template <typename Fn>
+    void ForEachShard(std::size_t count, ExecutionPolicy policy, std::size_t min_shard_size, Fn&& fn)
+    {
+        std::size_t shards = 1;
+        if (policy == ExecutionPolicy::kParallel) {
+            const std::size_t max_shards = std::max<std::size_t>(count / std::max<std::size_t>(min_shard_size, 1), 1);
+            shards = std::clamp<std::size_t>(std::thread::hardware_concurrency(), 1, max_shards);
+        }
+        if (shards == 1) {
+            fn(std::size_t { 0 }, count);
+            return;
+        }
+
+        const std::size_t base = count / shards;
+        const std::size_t remainder = count % shards;
+        auto shard_begin = [base, remainder](std::size_t shard) { return (shard * base) + std::min(shard, remainder); };
+
+        std::vector<std::jthread> workers;
+        workers.reserve(shards - 1);
+        for (std::size_t shard = 1; shard < shards; ++shard) {
+            const std::size_t begin = shard_begin(shard);
+            const std::size_t end = shard_begin(shard + 1);
+            try {
+                workers.emplace_back([&fn, begin, end] { fn(begin, end); });
+            }
+            catch (const std::system_error&) {
+                fn(begin, end);
+            }
+        }
+        fn(std::size_t { 0 }, shard_begin(1));
+    }
+
+    /// @brief Calls @p fn(index) for every index in [0, count), claiming indices one at a time.
+    ///
+    /// Suited to items of uneven cost, where contiguous shards would leave
+    /// threads idle.  With @c ExecutionPolicy::kParallel up to
+    /// @p max_threads threads (one per hardware thread when 0), including
+    /// the calling thread, pull the next index from a shared counter until
+    /// none is left.  If a worker cannot be started the remaining threads
+    /// pick up its share.  @p fn must be safe to call concurrently.
+    template <typename Fn>
+    void ForEachIndex(std::size_t count, ExecutionPolicy policy, std::size_t max_threads, Fn&& fn)
+    {
+        std::size_t threads = 1;
+        if (policy == ExecutionPolicy::kParallel) {
+            const std::size_t limit = max_threads != 0 ? max_threads : std::thread::hardware_concurrency();
+            threads = std::clamp<std::size_t>(limit, 1, std::max<std::size_t>(count, 1));
+        }
+        if (threads == 1) {
+            for (std::size_t index = 0; index < count; ++index) {
+                fn(index);
+            }
+            return;
+        }
+
+        std::atomic<std::size_t> next { 0 };
+        auto drain = [&fn, &next, count] {
+            for (std::size_t index = next.fetch_add(1, std::memory_order_relaxed); index < count;
+                 index = next.fetch_add(1, std::memory_order_relaxed)) {
+                fn(index);
+            }
+        };
+
+        std::vector<std::jthread> workers;
+        workers.reserve(threads - 1);
+        for (std::size_t worker = 1; worker < threads; ++worker) {
+            try {
+                workers.emplace_back(drain);
+            }
+            catch (const std::system_error&) {
+                break;
+            }
+        }
+        drain();
+    }
+
+}  // namespace detail
+
+}  // namespace cppfig
@@ -0,0 +1,161 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace cppfig {
+
+/// @brief Sorted-vector map with the subset of the @c std::map interface used by Value.
+///
+/// Entries live contiguously in key order, so an object with N keys costs a
+/// single buffer allocation instead of N tree nodes, and lookups are a
+/// binary search over adjacent memory.  Inserting a key greater than every
+/// existing key (the common case when parsing sorted or grouped input) is
+/// an append; other insertions shift the tail.
+///
+/// Unlike @c std::map, inserting or erasing invalidates iterators, pointers
+/// and references to the other entries.  Keys must not be modified through
+/// iterators.
+///
+/// @tparam Key Key type.
+/// @tparam T Mapped type (may be incomplete where the map is declared).
+/// @tparam Compare Strict weak ordering; transparent comparators enable heterogeneous lookup.
+template <typename Key, typename T, typename Compare = std::less<>>
+class FlatMap {
+public:
+    using key_type = Key;
+    using mapped_type = T;
+    using value_type = std::pair<Key, T>;
+    using container_type = std::vector<value_type>;
+    using size_type = std::size_t;
+    using iterator = typename container_type::iterator;
+    using const_iterator = typename container_type::const_iterator;
+
+    [[nodiscard]] auto begin() -> iterator { return entries_.begin(); }
+    [[nodiscard]] auto end() -> iterator { return entries_.end(); }
+    [[nodiscard]] auto begin() const -> const_iterator { return entries_.begin(); }
+    [[nodiscard]] auto end() const -> const_iterator { return entries_.end(); }
+
+    [[nodiscard]] auto empty() const -> bool { return entries_.empty(); }
+    [[nodiscard]] auto size() const -> size_type { return entries_.size(); }
+
+    void reserve(size_type capacity) { entries_.reserve(capacity); }
+    void clear() { entries_.clear(); }
+
+    /// @brief Returns the first entry whose key is not less than @p key.
+    template <typename K>
+    [[nodiscard]] auto lower_bound(const K& key) -> iterator
+    {
+        return std::lower_bound(entries_.begin(), entries_.end(), key, KeyLess { compare_ });
+    }
+
+    template <typename K>
+    [[nodiscard]] auto lower_bound(const K& key) const -> const_iterator
+    {
+        return std::lower_bound(entries_.begin(), entries_.end(), key, KeyLess { compare_ });
+    }
+
+    template <typename K>
+    [[nodiscard]] auto find(const K& key) -> iterator
+    {
+        auto iter = lower_bound(key);
+        return iter != entries_.end() && !compare_(key, iter->first) ? iter : entries_.end();
+    }
+
+    template <typename K>
+    [[nodiscard]] auto find(const K& key) const -> const_iterator
+    {
+        auto iter = lower_bound(key);
+        return iter != entries_.end() && !compare_(key, iter->first) ? iter : entries_.end();
+    }
+
+    template <typename K>
+    [[nodiscard]] auto contains(const K& key) const -> bool
+    {
+        return find(key) != entries_.end();
+    }
+
+    /// @brief Inserts a value constructed from @p args unless @p key already exists.
+    template <typename K, typename... Args>
+    auto try_emplace(K&& key, Args&&... args) -> std::pair<iterator, bool>
+    {
+        // Fast path: appending past the current largest key.
+        if (entries_.empty() || compare_(entries_.back().first, key)) {
+            entries_.emplace_back(std::piecewise_construct, std::forward_as_tuple(std::forward<K>(key)),
+                                  std::forward_as_tuple(std::forward<Args>(args)...));
+            return { std::prev(entries_.end()), true };
+        }
+
+        auto iter = lower_bound(key);
+        if (iter != entries_.end() && !compare_(key, iter->first)) {
+            return { iter, false };
+        }
+        iter = entries_.emplace(iter, std::piecewise_construct, std::forward_as_tuple(std::forward<K>(key)),
+                                std::forward_as_tuple(std::forward<Args>(args)...));
+        return { iter, true };
+    }
+
+    /// @brief Inserts @p value under @p key unless the key already exists (like @c std::map::emplace).
+    template <typename... Args>
+    auto emplace(Key key, Args&&... args) -> std::pair<iterator, bool>
+    {
+        return try_emplace(std::move(key), std::forward<Args>(args)...);
+    }
+
+    /// @brief Inserts or replaces the value stored under @p key.
+    template <typename K, typename V>
+    auto insert_or_assign(K&& key, V&& value) -> std::pair<iterator, bool>
+    {
+        auto result = try_emplace(std::forward<K>(key), std::forward<V>(value));
+        if (!result.second) {
+            result.first->second = std::forward<V>(value);
+        }
+        return result;
+    }
+
+    /// @brief Returns the value stored under @p key, default-constructing it if missing.
+    template <typename K>
+    auto operator[](K&& key) -> T&
+    {
+        return try_emplace(std::forward<K>(key)).first->second;
+    }
+
+    auto erase(iterator position) -> iterator { return entries_.erase(position); }
+    auto erase(const_iterator position) -> iterator { return entries_.erase(position); }
+
+    /// @brief Removes the entry stored under @p key; returns the number of removed entries.
+    template <typename K>
+    auto erase(const K& key) -> size_type
+    {
+        auto iter = find(key);
+        if (iter == entries_.end()) {
+            return 0;
+        }
+        entries_.erase(iter);
+        return 1;
+    }
+
+    friend auto operator==(const FlatMap& lhs, const FlatMap& rhs) -> bool { return lhs.entries_ == rhs.entries_; }
+
+private:
+    /// @brief Adapts the key comparator to compare entries against keys.
+    struct KeyLess {
+        const Compare& compare;
+
+        template <typename K>
+        auto operator()(const value_type& entry, const K& key) const -> bool
+        {
+            return compare(entry.first, key);
+        }
+    };
+
+    container_type entries_;
+    [[no_unique_address]] Compare compare_ {};
+};
+
+}  // namespace cppfig
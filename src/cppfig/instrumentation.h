@@ -0,0 +1,273 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+#include "cppfig/slots.h"
+#include "cppfig/thread_policy.h"
+
+namespace cppfig {
+
+/// @brief Counters of one setting in a @c MetricsSnapshot.
+struct SettingMetrics {
+    std::string_view path;
+    std::uint64_t gets = 0;           ///< Calls to @c Get.
+    std::uint64_t sets = 0;           ///< Successful calls to @c Set.
+    std::uint64_t env_overrides = 0;  ///< Reads served by the environment variable.
+    std::uint64_t defaults = 0;       ///< Reads served by the default because the file has no value.
+    std::uint64_t fallbacks = 0;      ///< Reads served by a fallback because a value failed to parse.
+    std::uint64_t cache_hits = 0;     ///< @c CachedSetting reads served without re-resolving.
+    std::uint64_t cache_misses = 0;   ///< @c CachedSetting reads that re-resolved the value.
+};
+
+/// @brief Timings of one kind of file operation (load or save) in a @c MetricsSnapshot.
+///
+/// Phase times are summed over all operations; a phase an operation does
+/// not have stays zero (e.g. loads never serialize unless they create or
+/// migrate the file).
+struct OperationMetrics {
+    std::uint64_t count = 0;     ///< Operations started.
+    std::uint64_t failures = 0;  ///< Operations that returned an error.
+    std::chrono::nanoseconds total { 0 };
+    std::chrono::nanoseconds io { 0 };         ///< Opening, reading and writing files.
+    std::chrono::nanoseconds parse { 0 };      ///< Turning file contents into a Value tree.
+    std::chrono::nanoseconds serialize { 0 };  ///< Turning a Value tree into file contents.
+    std::chrono::nanoseconds diff { 0 };       ///< Change detection (migration, fingerprint and save checks).
+    std::chrono::nanoseconds validate { 0 };   ///< Running validators.
+};
+
+/// @brief Plain copy of the counters recorded by @c MetricsInstrumentation.
+///
+/// Counters are read one by one with relaxed loads, so a snapshot taken
+/// under concurrent traffic is not a consistent cut, but every counter is
+/// monotonic.
+struct MetricsSnapshot {
+    std::vector<SettingMetrics> settings;  ///< In schema order.
+    OperationMetrics load;                 ///< @c Load and @c Reload.
+    OperationMetrics save;                 ///< @c Save.
+    std::uint64_t lock_waits = 0;          ///< Lock acquisitions timed (locking thread policies only).
+    std::chrono::nanoseconds lock_wait_time { 0 };
+};
+
+/// @brief File operations timed by an instrumentation policy.
+enum class MetricsOperation : std::uint8_t {
+    kLoad,
+    kSave,
+};
+
+/// @brief Phases of a file operation timed by an instrumentation policy.
+enum class MetricsPhase : std::uint8_t {
+    kIo,
+    kParse,
+    kSerialize,
+    kDiff,
+    kValidate,
+};
+
+namespace detail {
+
+    /// @brief Timer of a disabled instrumentation policy; reading it costs nothing.
+    struct NullTimer { };
+
+    /// @brief Recorder of @c NoInstrumentation: every call compiles to nothing.
+    struct NullRecorder {
+        using timer = NullTimer;
+
+        [[nodiscard]] static auto StartTimer() -> timer { return {}; }
+        void RecordGet(std::size_t /*index*/, SlotSource /*source*/) const { }
+        void RecordSet(std::size_t /*index*/) const { }
+        void RecordCache(std::size_t /*index*/, bool /*hit*/) const { }
+        void RecordLockWait(timer /*start*/) const { }
+        void RecordPhase(MetricsOperation /*operation*/, MetricsPhase /*phase*/, timer& /*lap*/) const { }
+        void RecordOperation(MetricsOperation /*operation*/, timer /*start*/, bool /*ok*/) const { }
+    };
+
+    /// @brief Recorder of @c MetricsInstrumentation: relaxed atomic counters.
+    ///
+    /// Counters of each setting live on their own cache line so that reads
+    /// of different settings from different threads do not contend.
+    ///
+    /// @tparam N Number of settings.
+    template <std::size_t N>
+    class MetricsRecorder {
+    public:
+        using timer = std::chrono::steady_clock::time_point;
+
+        [[nodiscard]] static auto StartTimer() -> timer { return std::chrono::steady_clock::now(); }
+
+        /// @brief Counts a @c Get of setting @p index served from @p source.
+        void RecordGet(std::size_t index, SlotSource source) const
+        {
+            auto& counters = settings_[index];
+            Increment(counters.gets);
+            switch (source) {
+            case SlotSource::kEnvironment:
+                Increment(counters.env_overrides);
+                break;
+            case SlotSource::kDefault:
+                Increment(counters.defaults);
+                break;
+            case SlotSource::kInvalid:
+                Increment(counters.fallbacks);
+                break;
+            case SlotSource::kFile:
+                break;
+            }
+        }
+
+        void RecordSet(std::size_t index) const { Increment(settings_[index].sets); }
+
+        void RecordCache(std::size_t index, bool hit) const
+        {
+            Increment(hit ? settings_[index].cache_hits : settings_[index].cache_misses);
+        }
+
+        void RecordLockWait(timer start) const
+        {
+            Increment(lock_waits_);
+            Add(lock_wait_ns_, Elapsed(start));
+        }
+
+        void RecordLockWait(NullTimer /*start*/) const { }
+
+        /// @brief Adds the time since @p lap to @p phase of @p operation and restarts @p lap.
+        void RecordPhase(MetricsOperation operation, MetricsPhase phase, timer& lap) const
+        {
+            const timer now = StartTimer();
+            Add(operations_[Index(operation)].phases[static_cast<std::size_t>(phase)], (now - lap).count());
+            lap = now;
+        }
+
+        /// @brief Counts one @p operation started at @p start.
+        void RecordOperation(MetricsOperation operation, timer start, bool ok) const
+        {
+            auto& counters = operations_[Index(operation)];
+            Increment(counters.count);
+            if (!ok) {
+                Increment(counters.failures);
+            }
+            Add(counters.total_ns, Elapsed(start));
+        }
+
+        /// @brief Copies the counters; @p paths names the settings in schema order.
+        [[nodiscard]] auto Snapshot(const std::array<std::string_view, N>& paths) const -> MetricsSnapshot
+        {
+            MetricsSnapshot snapshot;
+            snapshot.settings.reserve(N);
+            for (std::size_t i = 0; i < N; ++i) {
+                const auto& counters = settings_[i];
+                snapshot.settings.push_back({
+                    .path = paths[i],
+                    .gets = Load(counters.gets),
+                    .sets = Load(counters.sets),
+                    .env_overrides = Load(counters.env_overrides),
+                    .defaults = Load(counters.defaults),
+                    .fallbacks = Load(counters.fallbacks),
+                    .cache_hits = Load(counters.cache_hits),
+                    .cache_misses = Load(counters.cache_misses),
+                });
+            }
+            snapshot.load = SnapshotOperation(MetricsOperation::kLoad);
+            snapshot.save = SnapshotOperation(MetricsOperation::kSave);
+            snapshot.lock_waits = Load(lock_waits_);
+            snapshot.lock_wait_time = std::chrono::nanoseconds(Load(lock_wait_ns_));
+            return snapshot;
+        }
+
+    private:
+        using counter = std::atomic<std::uint64_t>;
+
+        struct alignas(k_cache_line_size) SettingCounters {
+            counter gets { 0 };
+            counter sets { 0 };
+            counter env_overrides { 0 };
+            counter defaults { 0 };
+            counter fallbacks { 0 };
+            counter cache_hits { 0 };
+            counter cache_misses { 0 };
+        };
+
+        struct alignas(k_cache_line_size) OperationCounters {
+            counter count { 0 };
+            counter failures { 0 };
+            counter total_ns { 0 };
+            std::array<counter, 5> phases {};
+        };
+
+        static void Increment(counter& value) { value.fetch_add(1, std::memory_order_relaxed); }
+        static void Add(counter& value, std::int64_t amount) { value.fetch_add(static_cast<std::uint64_t>(amount), std::memory_order_relaxed); }
+        [[nodiscard]] static auto Load(const counter& value) -> std::uint64_t { return value.load(std::memory_order_relaxed); }
+        [[nodiscard]] static auto Index(MetricsOperation operation) -> std::size_t { return static_cast<std::size_t>(operation); }
+
+        [[nodiscard]] static auto Elapsed(timer start) -> std::int64_t
+        {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(StartTimer() - start).count();
+        }
+
+        [[nodiscard]] auto SnapshotOperation(MetricsOperation operation) const -> OperationMetrics
+        {
+            const auto& counters = operations_[Index(operation)];
+            auto phase = [&counters](MetricsPhase which) {
+                return std::chrono::nanoseconds(Load(counters.phases[static_cast<std::size_t>(which)]));
+            };
+            return {
+                .count = Load(counters.count),
+                .failures = Load(counters.failures),
+                .total = std::chrono::nanoseconds(Load(counters.total_ns)),
+                .io = phase(MetricsPhase::kIo),
+                .parse = phase(MetricsPhase::kParse),
+                .serialize = phase(MetricsPhase::kSerialize),
+                .diff = phase(MetricsPhase::kDiff),
+                .validate = phase(MetricsPhase::kValidate),
+            };
+        }
+
+        mutable std::array<SettingCounters, N> settings_ {};
+        mutable std::array<OperationCounters, 2> operations_ {};
+        mutable counter lock_waits_ { 0 };
+        mutable counter lock_wait_ns_ { 0 };
+    };
+
+}  // namespace detail
+
+/// @brief Instrumentation policy recording nothing (zero overhead).
+///
+/// This is the default policy: every recording call is an empty inline
+/// function and no timer is ever read.
+struct NoInstrumentation {
+    static constexpr bool enabled = false;
+
+    template <std::size_t N>
+    using recorder = detail::NullRecorder;
+};
+
+/// @brief Instrumentation policy counting accesses and timing file operations.
+///
+/// Records, per setting, @c Get / @c Set calls, the source that served each
+/// read (environment override, default, fallback after a parse failure) and
+/// @c CachedSetting hits and misses; lock wait time under locking thread
+/// policies; and @c Load / @c Save timings broken down by phase.  Read the
+/// counters with @c Configuration::Metrics().
+///
+/// Usage:
+/// @code
+/// cppfig::Configuration<MySchema, cppfig::ConfSerializer, cppfig::MultiThreadedPolicy,
+///                       cppfig::MetricsInstrumentation> config("app.conf");
+/// // ...
+/// for (const auto& setting : config.Metrics().settings) {
+///     Export(setting.path, setting.gets);
+/// }
+/// @endcode
+struct MetricsInstrumentation {
+    static constexpr bool enabled = true;
+
+    template <std::size_t N>
+    using recorder = detail::MetricsRecorder<N>;
+};
+
+}  // namespace cppfig
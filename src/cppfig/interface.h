@@ -5,6 +5,8 @@
 
 #include "cppfig/diff.h"
 #include "cppfig/setting.h"
+#include "cppfig/status.h"
+#include "cppfig/value.h"
 
 namespace cppfig {
 
@@ -102,6 +104,12 @@ public:
     /// @brief Validates all current values.
     [[nodiscard]] virtual auto ValidateAll() const -> Status = 0;
 
+    /// @brief Gets the effective value of the setting at a dot-separated path.
+    [[nodiscard]] virtual auto GetByPath(std::string_view path) const -> StatusOr<Value> = 0;
+
+    /// @brief Sets the setting at a dot-separated path, converting and validating @p value.
+    virtual auto SetByPath(std::string_view path, const Value& value) -> Status = 0;
+
     /// @brief Gets a string representation of the diff.
     [[nodiscard]] virtual auto GetDiffString() const -> std::string = 0;
 
@@ -5,10 +5,17 @@
 #error "cppfig: JSON support is not enabled. Set CPPFIG_ENABLE_JSON=ON in CMake or add the 'json' vcpkg feature."
 #endif
 
+#include <array>
+#include <charconv>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
 #include <nlohmann/json.hpp>
 #include <optional>
 #include <string>
 #include <string_view>
+#include <utility>
+#include <vector>
 
 #include "cppfig/value.h"
 
@@ -42,10 +49,12 @@ inline auto JsonToValue(const nlohmann::json& json) -> Value
         return obj;
     }
     if (json.is_array()) {
-        auto arr = Value::Array();
-        // Array elements are not used in config settings but supported
-        // for completeness.
-        return arr;
+        Value::ArrayType elements;
+        elements.reserve(json.size());
+        for (const auto& element : json) {
+            elements.push_back(JsonToValue(element));
+        }
+        return Value::Array(std::move(elements));
     }
     return {};
 }
@@ -76,43 +85,358 @@ inline auto ValueToJson(const Value& value) -> nlohmann::json
         return json;
     }
     if (value.IsArray()) {
-        return nlohmann::json::array();
+        nlohmann::json json = nlohmann::json::array();
+        value.ForEachElement([&json](const Value& element) { json.push_back(ValueToJson(element)); });
+        return json;
     }
     return nullptr;
 }
 
-/// @brief JSON serializer using nlohmann::json.
-///
-/// Converts between cppfig::Value trees and JSON file format.
-struct JsonSerializer {
-    using data_type = Value;
+namespace detail {
 
-    /// @brief Parses JSON from an input stream.
-    static auto Parse(std::istream& is) -> StatusOr<Value>
+    /// @brief nlohmann SAX handler that builds a cppfig::Value tree directly.
+    ///
+    /// Produces exactly what @c JsonToValue produces for the equivalent DOM
+    /// (later duplicate keys win) without materializing the intermediate
+    /// nlohmann::json tree.  Array elements are collected in a vector per
+    /// open array and packed by @c Value::Array when the array closes.
+    class JsonValueBuilder {
+    public:
+        using number_integer_t = nlohmann::json::number_integer_t;
+        using number_unsigned_t = nlohmann::json::number_unsigned_t;
+        using number_float_t = nlohmann::json::number_float_t;
+        using string_t = nlohmann::json::string_t;
+        using binary_t = nlohmann::json::binary_t;
+
+        auto null() -> bool { return Put(Value()); }
+
+        auto boolean(bool value) -> bool { return Put(Value(value)); }
+
+        auto number_integer(number_integer_t value) -> bool { return Put(Value(value)); }
+
+        auto number_unsigned(number_unsigned_t value) -> bool { return Put(Value(static_cast<std::int64_t>(value))); }
+
+        auto number_float(number_float_t value, const string_t& /*text*/) -> bool { return Put(Value(value)); }
+
+        auto string(string_t& value) -> bool { return Put(Value(std::move(value))); }
+
+        auto binary(binary_t& /*value*/) -> bool { return Put(Value()); }
+
+        auto start_object(std::size_t /*size*/) -> bool
+        {
+            Value& slot = Slot();
+            slot = Value::Object();
+            stack_.push_back({ &slot, false, {} });
+            return true;
+        }
+
+        auto key(string_t& key) -> bool
+        {
+            key_ = std::move(key);
+            return true;
+        }
+
+        auto end_object() -> bool
+        {
+            stack_.pop_back();
+            return true;
+        }
+
+        auto start_array(std::size_t size) -> bool
+        {
+            // The slot is taken now: keys inside the array must not redirect it
+            Value& slot = Slot();
+            stack_.push_back({ &slot, true, {} });
+            if (size != static_cast<std::size_t>(-1)) {
+                stack_.back().elements.reserve(size);
+            }
+            return true;
+        }
+
+        auto end_array() -> bool
+        {
+            Frame& frame = stack_.back();
+            *frame.target = Value::Array(std::move(frame.elements));
+            stack_.pop_back();
+            return true;
+        }
+
+        auto parse_error(std::size_t /*position*/, const std::string& /*last_token*/,
+                         const nlohmann::detail::exception& error) -> bool
+        {
+            error_ = error.what();
+            return false;
+        }
+
+        /// @brief Returns the parse result, or the parse error reported by nlohmann.
+        [[nodiscard]] auto Result(bool accepted) && -> StatusOr<Value>
+        {
+            if (!accepted) {
+                return InvalidArgumentError("JSON parse error: " + error_);
+            }
+            return std::move(root_);
+        }
+
+    private:
+        /// @brief An open object, or an open array and the elements read so far.
+        ///
+        /// @c target stays valid while the frame is open: its container only
+        /// grows once the frame is closed.
+        struct Frame {
+            Value* target;
+            bool is_array;
+            Value::ArrayType elements;
+        };
+
+        /// @brief Returns the value the next event is stored into.
+        auto Slot() -> Value&
+        {
+            if (stack_.empty()) {
+                return root_;
+            }
+            Frame& frame = stack_.back();
+            if (frame.is_array) {
+                return frame.elements.emplace_back();
+            }
+            return frame.target->Items()[std::move(key_)];
+        }
+
+        auto Put(Value value) -> bool
+        {
+            Slot() = std::move(value);
+            return true;
+        }
+
+        Value root_;
+        std::vector<Frame> stack_;
+        std::string key_;
+        std::string error_;
+    };
+
+    /// @brief Parses JSON text through JsonValueBuilder.
+    ///
+    /// @param strict Whether trailing characters after the top-level value are an error.
+    template <typename Input>
+    auto ParseJsonValue(Input&& input, bool strict) -> StatusOr<Value>
     {
-        try {
-            nlohmann::json data;
-            is >> data;
-            return JsonToValue(data);
+        JsonValueBuilder builder;
+        const bool accepted = nlohmann::json::sax_parse(std::forward<Input>(input), &builder,
+                                                        nlohmann::json::input_format_t::json, strict);
+        return std::move(builder).Result(accepted);
+    }
+
+    /// @brief Appends a JSON string literal, escaped the way nlohmann::json::dump does.
+    ///
+    /// Bytes outside the ASCII control range are copied verbatim.
+    inline void AppendJsonString(std::string& out, std::string_view text)
+    {
+        constexpr std::string_view k_hex = "0123456789abcdef";
+
+        out.push_back('"');
+        std::size_t run_begin = 0;
+        for (std::size_t i = 0; i < text.size(); ++i) {
+            const auto byte = static_cast<unsigned char>(text[i]);
+            if (byte >= 0x20 && byte != '"' && byte != '\\') {
+                continue;
+            }
+            out.append(text.substr(run_begin, i - run_begin));
+            run_begin = i + 1;
+            switch (byte) {
+            case '"': out.append("\\\""); break;
+            case '\\': out.append("\\\\"); break;
+            case '\b': out.append("\\b"); break;
+            case '\f': out.append("\\f"); break;
+            case '\n': out.append("\\n"); break;
+            case '\r': out.append("\\r"); break;
+            case '\t': out.append("\\t"); break;
+            default:
+                out.append("\\u00");
+                out.push_back(k_hex[byte >> 4U]);
+                out.push_back(k_hex[byte & 0x0FU]);
+                break;
+            }
+        }
+        out.append(text.substr(run_begin));
+        out.push_back('"');
+    }
+
+    /// @brief Appends a double in nlohmann::json::dump notation.
+    ///
+    /// Uses the shortest round-trip digits, printed in fixed notation for
+    /// decimal exponents in (-4, 15] and in exponent notation otherwise;
+    /// integral values keep a trailing ".0".  Non-finite values become null.
+    inline void AppendJsonDouble(std::string& out, double value)
+    {
+        if (!std::isfinite(value)) {
+            out.append("null");
+            return;
         }
-        catch (const nlohmann::json::parse_error& e) {
-            return InvalidArgumentError(std::string("JSON parse error: ") + e.what());
+
+        // Shortest digits in scientific form: [-]d[.ddd]e(+|-)XX
+        std::array<char, 32> buffer {};
+        const auto result = std::to_chars(buffer.data(), buffer.data() + buffer.size(), value, std::chars_format::scientific);
+        std::string_view scientific(buffer.data(), static_cast<std::size_t>(result.ptr - buffer.data()));
+
+        if (scientific.front() == '-') {
+            out.push_back('-');
+            scientific.remove_prefix(1);
+        }
+        const std::size_t exponent_pos = scientific.find('e');
+        std::array<char, 24> digit_buffer {};
+        std::size_t digit_count = 0;
+        for (const char c : scientific.substr(0, exponent_pos)) {
+            if (c != '.') {
+                digit_buffer[digit_count++] = c;
+            }
+        }
+        const std::string_view digits(digit_buffer.data(), digit_count);
+        int exponent = 0;
+        const std::string_view exponent_text = scientific.substr(exponent_pos + 1);
+        std::from_chars(exponent_text.data() + (exponent_text.front() == '+' ? 1 : 0), exponent_text.data() + exponent_text.size(), exponent);
+
+        constexpr int k_min_exp = -4;
+        constexpr int k_max_exp = 15;
+        const auto k = static_cast<int>(digit_count);
+        const int n = exponent + 1;  // position of the decimal point relative to the digits
+
+        if (k <= n && n <= k_max_exp) {
+            out.append(digits);
+            out.append(static_cast<std::size_t>(n - k), '0');
+            out.append(".0");
+        }
+        else if (0 < n && n <= k_max_exp) {
+            out.append(digits.substr(0, static_cast<std::size_t>(n)));
+            out.push_back('.');
+            out.append(digits.substr(static_cast<std::size_t>(n)));
+        }
+        else if (k_min_exp < n && n <= 0) {
+            out.append("0.");
+            out.append(static_cast<std::size_t>(-n), '0');
+            out.append(digits);
+        }
+        else {
+            out.push_back(digits.front());
+            if (k > 1) {
+                out.push_back('.');
+                out.append(digits.substr(1));
+            }
+            out.push_back('e');
+            out.push_back(exponent < 0 ? '-' : '+');
+            const int magnitude = exponent < 0 ? -exponent : exponent;
+            if (magnitude < 10) {
+                out.push_back('0');
+            }
+            out.append(std::to_string(magnitude));
         }
     }
 
-    /// @brief Parses JSON from a string.
-    static auto ParseString(std::string_view str) -> StatusOr<Value>
+    /// @brief Appends a Value as JSON, formatted like nlohmann::json::dump(indent).
+    inline void AppendJson(std::string& out, const Value& value, int indent, int depth)
     {
-        try {
-            return JsonToValue(nlohmann::json::parse(str));
+        if (value.IsNull()) {
+            out.append("null");
+        }
+        else if (value.IsBoolean()) {
+            out.append(value.Get<bool>() ? "true" : "false");
+        }
+        else if (value.IsInteger()) {
+            std::array<char, 24> buffer {};
+            const auto result = std::to_chars(buffer.data(), buffer.data() + buffer.size(), value.Get<std::int64_t>());
+            out.append(buffer.data(), result.ptr);
         }
-        catch (const nlohmann::json::parse_error& e) {
-            return InvalidArgumentError(std::string("JSON parse error: ") + e.what());
+        else if (value.IsDouble()) {
+            AppendJsonDouble(out, value.Get<double>());
+        }
+        else if (value.IsString()) {
+            AppendJsonString(out, value.AsStringView());
+        }
+        else if (value.IsObject() && !value.Items().empty()) {
+            const bool pretty = indent >= 0;
+            const auto child_indent = static_cast<std::size_t>(pretty ? indent * (depth + 1) : 0);
+            bool first = true;
+            out.push_back('{');
+            for (const auto& [key, child] : value.Items()) {
+                if (!first) {
+                    out.push_back(',');
+                }
+                first = false;
+                if (pretty) {
+                    out.push_back('\n');
+                    out.append(child_indent, ' ');
+                }
+                AppendJsonString(out, key);
+                out.append(pretty ? ": " : ":");
+                AppendJson(out, child, indent, depth + 1);
+            }
+            if (pretty) {
+                out.push_back('\n');
+                out.append(static_cast<std::size_t>(indent * depth), ' ');
+            }
+            out.push_back('}');
+        }
+        else if (value.IsObject()) {
+            out.append("{}");
+        }
+        else if (value.Size() != 0) {
+            const bool pretty = indent >= 0;
+            const auto child_indent = static_cast<std::size_t>(pretty ? indent * (depth + 1) : 0);
+            bool first = true;
+            out.push_back('[');
+            value.ForEachElement([&](const Value& element) {
+                if (!first) {
+                    out.push_back(',');
+                }
+                first = false;
+                if (pretty) {
+                    out.push_back('\n');
+                    out.append(child_indent, ' ');
+                }
+                AppendJson(out, element, indent, depth + 1);
+            });
+            if (pretty) {
+                out.push_back('\n');
+                out.append(static_cast<std::size_t>(indent * depth), ' ');
+            }
+            out.push_back(']');
+        }
+        else {
+            out.append("[]");
         }
     }
 
+}  // namespace detail
+
+/// @brief JSON serializer using nlohmann::json.
+///
+/// Converts between cppfig::Value trees and JSON file format.
+struct JsonSerializer {
+    using data_type = Value;
+
+    /// @brief Parses JSON from an input stream.
+    ///
+    /// Builds the Value tree directly from nlohmann's SAX events; characters
+    /// after the top-level value are ignored, as with @c operator>>.
+    static auto Parse(std::istream& is) -> StatusOr<Value> { return detail::ParseJsonValue(is, false); }
+
+    /// @brief Parses JSON from a string.
+    static auto ParseString(std::string_view str) -> StatusOr<Value> { return detail::ParseJsonValue(str, true); }
+
+    /// @brief Parses a contiguous JSON buffer (used by @c ReadFile).
+    ///
+    /// Same acceptance rules as @c Parse, so reading a file through the
+    /// buffer path accepts exactly what the stream path accepts.
+    static auto ParseBuffer(std::string_view buffer) -> StatusOr<Value> { return detail::ParseJsonValue(buffer, false); }
+
     /// @brief Converts a Value tree to a formatted JSON string.
-    static auto Stringify(const Value& data, int indent = 4) -> std::string { return ValueToJson(data).dump(indent); }
+    ///
+    /// Writes straight into the result, using the same layout as
+    /// @c nlohmann::json::dump (a negative @p indent yields compact output).
+    static auto Stringify(const Value& data, int indent = 4) -> std::string
+    {
+        std::string out;
+        detail::AppendJson(out, data, indent, 0);
+        return out;
+    }
 };
 
 // ADL-based ConfigTraits helper
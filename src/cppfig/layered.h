@@ -0,0 +1,429 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <limits>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include "cppfig/conf.h"
+#include "cppfig/execution.h"
+#include "cppfig/logging.h"
+#include "cppfig/serializer.h"
+#include "cppfig/setting.h"
+#include "cppfig/slots.h"
+#include "cppfig/status.h"
+#include "cppfig/thread_policy.h"
+#include "cppfig/value.h"
+
+namespace cppfig {
+
+/// @brief One source of a @c LayeredConfiguration.
+///
+/// Layers are listed from lowest to highest precedence.  A directory layer
+/// expands, at load time, into one layer per matching file in file-name
+/// order (the usual `conf.d` convention).
+struct ConfigLayer {
+    enum class Kind : std::uint8_t {
+        kFile,       ///< A single file read with the configuration's serializer.
+        kDirectory,  ///< Every regular file with @c extension in a directory.
+        kValues,     ///< An in-memory Value tree (e.g. command-line flags).
+    };
+
+    Kind kind = Kind::kValues;
+    std::string name;       ///< Path of the file or directory, or a label for in-memory values.
+    std::string extension;  ///< File extension selected by a directory layer.
+    bool required = false;  ///< Whether a missing file or directory fails the load.
+    Value values;           ///< Contents of an in-memory layer.
+
+    /// @brief A file layer; a missing file is skipped unless @p required.
+    [[nodiscard]] static auto File(std::string path, bool required = false) -> ConfigLayer
+    {
+        return { .kind = Kind::kFile, .name = std::move(path), .extension = {}, .required = required, .values = {} };
+    }
+
+    /// @brief A directory of fragments; a missing directory is skipped unless @p required.
+    [[nodiscard]] static auto Directory(std::string path, std::string extension = ".conf", bool required = false) -> ConfigLayer
+    {
+        return { .kind = Kind::kDirectory, .name = std::move(path), .extension = std::move(extension), .required = required, .values = {} };
+    }
+
+    /// @brief An in-memory layer labelled @p name.
+    [[nodiscard]] static auto Values(std::string name, Value values) -> ConfigLayer
+    {
+        return { .kind = Kind::kValues, .name = std::move(name), .extension = {}, .required = false, .values = std::move(values) };
+    }
+
+    /// @brief An in-memory layer of the `--path=value` command-line arguments.
+    ///
+    /// Values are typed as in a `.conf` file (see @c ConfSerializer); other
+    /// arguments are ignored.
+    [[nodiscard]] static auto Arguments(int argc, const char* const* argv) -> ConfigLayer
+    {
+        std::string lines;
+        for (int i = 1; i < argc; ++i) {
+            const std::string_view argument = argv[i];
+            const auto equals = argument.find('=');
+            if (!argument.starts_with("--") || equals == std::string_view::npos || equals == 2
+                || argument.find('\n') != std::string_view::npos) {
+                continue;
+            }
+            lines.append(argument.substr(2, equals - 2)).append(" = ").append(argument.substr(equals + 1)).push_back('\n');
+        }
+        auto parsed = ConfSerializer::ParseString(lines);
+        return Values("command line", parsed.ok() ? *std::move(parsed) : Value::Object());
+    }
+};
+
+/// @brief Read-only configuration merged from several layers.
+///
+/// @c Load reads every layer (optionally in parallel), deep-merges them
+/// with @c Value::Merge in precedence order and resolves each setting once
+/// into a typed slot, recording which layer supplied it.  @c Get is then a
+/// single indexed read however many layers there are.
+///
+/// Resolution order:
+/// 1. Environment variable (if configured)
+/// 2. Highest layer that has the setting's path
+/// 3. Default value
+///
+/// Usage:
+/// @code
+/// cppfig::LayeredConfiguration<MySchema> config({
+///     cppfig::ConfigLayer::File("/etc/app/base.conf", true),
+///     cppfig::ConfigLayer::File("/etc/app/" + hostname + ".conf"),
+///     cppfig::ConfigLayer::Directory("/etc/app/conf.d"),
+///     cppfig::ConfigLayer::Arguments(argc, argv),
+/// });
+/// auto status = config.Load(cppfig::ExecutionPolicy::kParallel);
+/// int port = config.Get<ServerPort>();
+/// config.LayerName<ServerPort>();  // e.g. "/etc/app/conf.d/10-port.conf"
+/// @endcode
+///
+/// Layers are never written: there is no @c Set or @c Save.
+///
+/// @tparam Schema The ConfigSchema type defining all settings.
+/// @tparam SerializerT The serializer used to read file layers (defaults to ConfSerializer).
+/// @tparam ThreadPolicy The threading policy (defaults to SingleThreadedPolicy).
+template <typename Schema, Serializer SerializerT = ConfSerializer, typename ThreadPolicy = SingleThreadedPolicy>
+class LayeredConfiguration {
+public:
+    using schema_type = Schema;
+    using serializer_type = SerializerT;
+    using thread_policy = ThreadPolicy;
+
+    /// @brief @c LayerOf result for a value taken from the setting's environment variable.
+    static constexpr std::size_t k_environment_layer = std::numeric_limits<std::size_t>::max();
+    /// @brief @c LayerOf result for a setting no layer provides.
+    static constexpr std::size_t k_default_layer = k_environment_layer - 1;
+
+    /// @brief Creates a configuration over @p layers, lowest precedence first.
+    ///
+    /// Until the first @c Load every setting reads its environment override
+    /// or default.
+    explicit LayeredConfiguration(std::vector<ConfigLayer> layers)
+        : layers_(std::move(layers))
+        , state_(MakeInitialState())
+    {
+    }
+
+    /// @brief Gets the value for a setting type (see the resolution order above).
+    ///
+    /// Thread safety: acquires a shared (reader) lock (lock-free under
+    /// @c SnapshotPolicy).
+    template <IsSetting S>
+        requires(Schema::template has_setting<S>)
+    [[nodiscard]] auto Get() const -> typename S::value_type
+    {
+        using value_type = typename S::value_type;
+
+        return ReadState([this](const State& state) -> value_type {
+            if constexpr (HasEnvOverride<S>) {
+                if (const value_type* env_value = state.environment.template Find<S>()) {
+                    return *env_value;
+                }
+            }
+            if (state.slots.template Source<S>() == SlotSource::kInvalid
+                && warnings_.First(Schema::template index_of<S>, Generation())) {
+                Logger::WarnF("Failed to parse layered value for '%.*s', using default",
+                              static_cast<int>(S::path.size()), S::path.data());
+            }
+            return state.slots.template Get<S>();
+        });
+    }
+
+    /// @brief Returns the index (among @c LayerNames) of the layer setting S was resolved from.
+    ///
+    /// Returns @c k_environment_layer for an environment override and
+    /// @c k_default_layer when the setting holds its default.
+    template <IsSetting S>
+        requires(Schema::template has_setting<S>)
+    [[nodiscard]] auto LayerOf() const -> std::size_t
+    {
+        return ReadState([](const State& state) { return LayerOfUnlocked<S>(state); });
+    }
+
+    /// @brief Returns the name of the layer setting S was resolved from, or "environment" / "default".
+    template <IsSetting S>
+        requires(Schema::template has_setting<S>)
+    [[nodiscard]] auto LayerName() const -> std::string
+    {
+        return ReadState([](const State& state) -> std::string {
+            const auto layer = LayerOfUnlocked<S>(state);
+            if (layer == k_environment_layer) {
+                return "environment";
+            }
+            if (layer == k_default_layer) {
+                return "default";
+            }
+            return state.layer_names[layer];
+        });
+    }
+
+    /// @brief Returns the names of the layers read by the last @c Load, lowest precedence first.
+    ///
+    /// Directory layers appear as one entry per fragment; missing optional
+    /// files are left out.
+    [[nodiscard]] auto LayerNames() const -> std::vector<std::string>
+    {
+        return ReadState([](const State& state) { return state.layer_names; });
+    }
+
+    /// @brief Returns the merged Value tree of all layers (a copy-on-write reference).
+    [[nodiscard]] auto GetMergedValues() const -> Value
+    {
+        return ReadState([](const State& state) { return state.merged; });
+    }
+
+    /// @brief Reads and merges all layers and re-reads the environment overrides.
+    ///
+    /// With @c ExecutionPolicy::kParallel the layer files are read and
+    /// parsed concurrently; merging and resolution always run in layer
+    /// order.  The new state is built without holding any lock and swapped
+    /// in at the end.  A missing required layer, a file that fails to parse
+    /// or a merged value that fails validation leaves the current state
+    /// untouched.
+    ///
+    /// Thread safety: holds the exclusive (writer) lock only for the swap.
+    [[nodiscard]] auto Load(ExecutionPolicy policy = ExecutionPolicy::kSequential) -> Status
+    {
+        std::vector<std::string> names;
+        std::vector<const Value*> in_memory;
+        for (const auto& layer : layers_) {
+            auto status = ExpandLayer(layer, names, in_memory);
+            if (!status.ok()) {
+                return status;
+            }
+        }
+
+        // Read the file layers; in-memory layers are copied as is
+        std::vector<Value> trees(names.size());
+        std::vector<Status> errors(names.size());
+        // Each layer is a file read, worth a thread of its own
+        detail::ForEachShard(names.size(), policy, 1, [&](std::size_t begin, std::size_t end) {
+            for (std::size_t i = begin; i < end; ++i) {
+                if (in_memory[i] != nullptr) {
+                    trees[i] = *in_memory[i];
+                    continue;
+                }
+                // Load doubles as the reload path, so layers may be rewritten while they are read
+                Value list_texts;
+                auto result = ReadFile<SerializerT>(names[i], FileRead::kCopied, list_texts);
+                if (result.ok()) {
+                    trees[i] = *std::move(result);
+                    detail::RestoreListTexts<Schema>(trees[i], list_texts);
+                }
+                else {
+                    errors[i] = Status(result.status().code(), names[i] + ": " + std::string(result.status().message()));
+                }
+            }
+        });
+        for (auto& error : errors) {
+            if (!error.ok()) {
+                return error;
+            }
+        }
+
+        State next;
+        next.merged = Value::Object();
+        for (const auto& tree : trees) {
+            next.merged = Value::Merge(next.merged, tree);
+        }
+        next.slots.ResolveAll(next.merged);
+        next.environment.ResolveAll();
+        Schema::ForEachSetting([&next, &trees]<typename S>() {
+            auto& origin = next.origins[Schema::template index_of<S>];
+            origin = k_default_layer;
+            if (!next.slots.template HasFileValue<S>()) {
+                return;
+            }
+            for (std::size_t layer = trees.size(); layer-- > 0;) {
+                if (trees[layer].HasPath(S::path)) {
+                    origin = layer;
+                    return;
+                }
+            }
+        });
+        next.layer_names = std::move(names);
+
+        auto status = ValidateUnlocked(next);
+        if (!status.ok()) {
+            return status;
+        }
+
+        ReplaceState(std::move(next));
+        return OkStatus();
+    }
+
+    /// @brief Returns a counter bumped every time @c Load swaps in a new state.
+    [[nodiscard]] auto Generation() const -> std::uint64_t { return generation_.load(std::memory_order_acquire); }
+
+private:
+    struct State {
+        Value merged;
+        SlotTable<Schema> slots;
+        EnvironmentTable<Schema> environment;
+        /// @brief Index into @c layer_names of the layer each slot was resolved from.
+        std::array<std::size_t, Schema::size> origins {};
+        std::vector<std::string> layer_names;
+    };
+
+    template <typename Policy>
+    struct StateStorage {
+        using type = State;
+    };
+
+    template <IsSnapshotPolicy Policy>
+    struct StateStorage<Policy> {
+        using type = typename Policy::template snapshot_type<State>;
+    };
+
+    template <IsSetting S>
+    [[nodiscard]] static auto LayerOfUnlocked(const State& state) -> std::size_t
+    {
+        if (state.environment.template Source<S>() == SlotSource::kEnvironment) {
+            return k_environment_layer;
+        }
+        if (state.slots.template Source<S>() != SlotSource::kFile) {
+            return k_default_layer;
+        }
+        return state.origins[Schema::template index_of<S>];
+    }
+
+    /// @brief Appends the layer(s) @p layer stands for to @p names and @p in_memory.
+    [[nodiscard]] static auto ExpandLayer(const ConfigLayer& layer, std::vector<std::string>& names,
+                                          std::vector<const Value*>& in_memory) -> Status
+    {
+        namespace fs = std::filesystem;
+
+        std::error_code error_code;
+        switch (layer.kind) {
+        case ConfigLayer::Kind::kValues:
+            names.push_back(layer.name);
+            in_memory.push_back(&layer.values);
+            return OkStatus();
+        case ConfigLayer::Kind::kFile:
+            if (!fs::exists(layer.name, error_code)) {
+                return layer.required ? NotFoundError("Required configuration layer not found: " + layer.name) : OkStatus();
+            }
+            names.push_back(layer.name);
+            in_memory.push_back(nullptr);
+            return OkStatus();
+        case ConfigLayer::Kind::kDirectory: {
+            if (!fs::is_directory(layer.name, error_code)) {
+                return layer.required ? NotFoundError("Required configuration directory not found: " + layer.name) : OkStatus();
+            }
+            std::vector<fs::path> fragments;
+            for (const auto& entry : fs::directory_iterator(layer.name, error_code)) {
+                if (entry.is_regular_file(error_code) && entry.path().extension() == layer.extension) {
+                    fragments.push_back(entry.path());
+                }
+            }
+            if (error_code) {
+                return InternalError("Failed to list configuration directory: " + layer.name);
+            }
+            std::ranges::sort(fragments, [](const fs::path& lhs, const fs::path& rhs) { return lhs.filename() < rhs.filename(); });
+            for (const auto& fragment : fragments) {
+                names.push_back(fragment.string());
+                in_memory.push_back(nullptr);
+            }
+            return OkStatus();
+        }
+        }
+        return OkStatus();
+    }
+
+    /// @brief Validates every slot resolved from a layer, stopping at the first error.
+    [[nodiscard]] static auto ValidateUnlocked(const State& state) -> Status
+    {
+        Status status = OkStatus();
+        Schema::ForEachSetting([&state, &status]<typename S>() {
+            if (!HasValidator<S> || !status.ok() || state.slots.template Source<S>() != SlotSource::kFile) {
+                return;
+            }
+            auto validation = GetSettingValidator<S>()(state.slots.template Get<S>());
+            if (!validation) {
+                status = InvalidArgumentError(std::string(S::path) + ": " + validation.error_message);
+            }
+        });
+        return status;
+    }
+
+    [[nodiscard]] static auto MakeInitialState() -> typename StateStorage<ThreadPolicy>::type
+    {
+        State state;
+        state.merged = Value::Object();
+        state.origins.fill(k_default_layer);
+        state.environment.ResolveAll();
+        if constexpr (IsSnapshotPolicy<ThreadPolicy>) {
+            return typename StateStorage<ThreadPolicy>::type(std::make_shared<const State>(std::move(state)));
+        }
+        else {
+            return state;
+        }
+    }
+
+    /// @brief Runs @p fn with read access to the state.
+    template <typename Fn>
+    auto ReadState(Fn&& fn) const -> decltype(auto)
+    {
+        if constexpr (IsSnapshotPolicy<ThreadPolicy>) {
+            return state_.Read(std::forward<Fn>(fn));
+        }
+        else {
+            typename ThreadPolicy::shared_lock lock(mutex_);
+            return std::forward<Fn>(fn)(state_);
+        }
+    }
+
+    /// @brief Replaces the whole state with @p next under the exclusive lock.
+    void ReplaceState(State next)
+    {
+        if constexpr (IsSnapshotPolicy<ThreadPolicy>) {
+            auto snapshot = std::make_shared<const State>(std::move(next));
+            typename ThreadPolicy::unique_lock lock(mutex_);
+            state_.Publish(std::move(snapshot));
+        }
+        else {
+            typename ThreadPolicy::unique_lock lock(mutex_);
+            std::swap(state_, next);
+        }
+        generation_.fetch_add(1, std::memory_order_release);
+    }
+
+    std::vector<ConfigLayer> layers_;
+    typename StateStorage<ThreadPolicy>::type state_;
+    std::atomic<std::uint64_t> generation_ { 0 };
+    mutable detail::WarnOnce<Schema::size> warnings_;  ///< Invalid layered values reported by @c Get.
+    mutable typename ThreadPolicy::mutex_type mutex_;
+};
+
+}  // namespace cppfig
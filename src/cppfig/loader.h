@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstddef>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "cppfig/execution.h"
+#include "cppfig/interface.h"
+#include "cppfig/status.h"
+
+namespace cppfig {
+
+/// @brief Loads every configuration of @p configs and returns every failure.
+///
+/// Meant for processes holding many configurations (e.g. one per tenant),
+/// whose start-up would otherwise be a serial loop of file reads, parses,
+/// migrations and saves.  With @c ExecutionPolicy::kParallel the loads run
+/// on at most @p max_threads threads (one per hardware thread when 0),
+/// each taking the next configuration as soon as it is done with the
+/// previous one, so a slow file does not hold up a whole batch.
+///
+/// Each failing configuration contributes one status with its own code
+/// ("file path: message"), in the order of @p configs; an empty vector
+/// means every configuration loaded.  A failure does not stop the other
+/// loads.
+///
+/// Usage:
+/// @code
+/// std::vector<cppfig::IConfigurationProviderVirtual*> tenants = ...;
+/// for (const auto& error : cppfig::LoadAll(tenants)) {
+///     std::cerr << error.message() << '\n';
+/// }
+/// @endcode
+///
+/// Thread safety: the configurations must be distinct objects; each load
+/// has the thread safety of the configuration's own @c Load.
+[[nodiscard]] inline auto LoadAll(std::span<IConfigurationProviderVirtual* const> configs,
+                                  ExecutionPolicy policy = ExecutionPolicy::kParallel, std::size_t max_threads = 0)
+    -> std::vector<Status>
+{
+    std::vector<Status> results(configs.size());
+    detail::ForEachIndex(configs.size(), policy, max_threads, [configs, &results](std::size_t index) {
+        auto status = configs[index]->Load();
+        if (!status.ok()) {
+            results[index] = Status(status.code(), std::string(configs[index]->GetFilePath()) + ": " + std::string(status.message()));
+        }
+    });
+    std::erase_if(results, [](const Status& status) { return status.ok(); });
+    return results;
+}
+
+}  // namespace cppfig
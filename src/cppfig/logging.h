@@ -1,8 +1,18 @@
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
 #include <cstdint>
 #include <cstdio>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
 #include <string_view>
+#include <thread>
 
 namespace cppfig {
 
@@ -11,75 +21,379 @@ enum class LogLevel : std::uint8_t { Info,
                                      Warning,
                                      Error };
 
-/// @brief Simple logger that writes to stdout/stderr.
-class Logger {
+/// @brief Destination of log messages.
+///
+/// Implementations receive one message at a time, without the "[cppfig]"
+/// prefix or a trailing newline, and must be safe to call concurrently.
+class LogSink {
 public:
-    /// @brief Logs an info message to stdout.
-    static void Info(std::string_view message) { std::fprintf(stdout, "[cppfig] INFO: %.*s\n", static_cast<int>(message.size()), message.data()); }
+    virtual ~LogSink() = default;
 
-    /// @brief Logs a warning message to stderr.
-    static void Warn(std::string_view message)
-    {
-        std::fprintf(stderr, "[cppfig] WARN: %.*s\n", static_cast<int>(message.size()), message.data());
-    }
+    /// @brief Writes one message.
+    virtual void Write(LogLevel level, std::string_view message) = 0;
 
-    /// @brief Logs an error message to stderr.
-    static void Error(std::string_view message)
-    {
-        std::fprintf(stderr, "[cppfig] ERROR: %.*s\n", static_cast<int>(message.size()), message.data());
-    }
+protected:
+    LogSink() = default;
+    LogSink(const LogSink&) = default;
+    LogSink(LogSink&&) = default;
+    auto operator=(const LogSink&) -> LogSink& = default;
+    auto operator=(LogSink&&) -> LogSink& = default;
+};
 
-    /// @brief Logs a message at the specified level.
-    static void Log(LogLevel level, std::string_view message)
+/// @brief Sink writing "[cppfig] LEVEL: message" lines: info to stdout, warnings and errors to stderr.
+///
+/// This is the sink used until @c Logger::SetSink installs another one.
+class StreamLogSink final : public LogSink {
+public:
+    void Write(LogLevel level, std::string_view message) override
     {
+        const auto length = static_cast<int>(message.size());
         switch (level) {
         case LogLevel::Info:
-            Info(message);
+            std::fprintf(stdout, "[cppfig] INFO: %.*s\n", length, message.data());
             break;
         case LogLevel::Warning:
-            Warn(message);
+            std::fprintf(stderr, "[cppfig] WARN: %.*s\n", length, message.data());
             break;
         case LogLevel::Error:
-            Error(message);
+            std::fprintf(stderr, "[cppfig] ERROR: %.*s\n", length, message.data());
             break;
         }
     }
+};
 
-    /// @brief Logs a formatted info message to stdout.
+/// @brief Sink handing messages to a background thread through a lock-free ring buffer.
+///
+/// @c Write copies the message (truncated to @c k_max_message bytes) into a
+/// bounded multi-producer ring and returns without taking a lock or doing
+/// I/O; when the ring is full the message is dropped and counted instead of
+/// blocking the caller.  A worker thread forwards messages, in the order
+/// they were queued, to the downstream sink.  Destruction flushes every
+/// queued message.
+///
+/// Usage:
+/// @code
+/// cppfig::StreamLogSink stream;
+/// cppfig::AsyncLogSink async(stream);
+/// cppfig::Logger::SetSink(&async);
+/// // ...
+/// cppfig::Logger::SetSink(nullptr);  // returns once no thread still writes to async
+/// @endcode
+class AsyncLogSink final : public LogSink {
+public:
+    /// @brief Longest message kept; longer messages are truncated.
+    static constexpr std::size_t k_max_message = 256;
+
+    /// @brief Creates a sink forwarding to @p downstream through a ring of @p capacity messages.
+    ///
+    /// The capacity is rounded up to a power of two.  @p downstream must
+    /// outlive the sink.
+    explicit AsyncLogSink(LogSink& downstream, std::size_t capacity = 1024)
+        : downstream_(downstream)
+        , mask_(std::bit_ceil(std::max<std::size_t>(capacity, 2)) - 1)
+        , cells_(std::make_unique<Cell[]>(mask_ + 1))
+    {
+        for (std::size_t i = 0; i <= mask_; ++i) {
+            cells_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+        worker_ = std::jthread([this] { Run(); });
+    }
+
+    AsyncLogSink(const AsyncLogSink&) = delete;
+    AsyncLogSink(AsyncLogSink&&) = delete;
+    auto operator=(const AsyncLogSink&) -> AsyncLogSink& = delete;
+    auto operator=(AsyncLogSink&&) -> AsyncLogSink& = delete;
+
+    ~AsyncLogSink() override
+    {
+        stop_.store(true, std::memory_order_release);
+        Signal();
+        worker_.join();
+        Drain();
+    }
+
+    void Write(LogLevel level, std::string_view message) override
+    {
+        std::size_t position = enqueue_.load(std::memory_order_relaxed);
+        Cell* cell = nullptr;
+        for (;;) {
+            cell = &cells_[position & mask_];
+            const std::size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            const auto distance = static_cast<std::ptrdiff_t>(sequence - position);
+            if (distance == 0) {
+                if (enqueue_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            }
+            else if (distance < 0) {
+                dropped_.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            else {
+                position = enqueue_.load(std::memory_order_relaxed);
+            }
+        }
+
+        cell->level = level;
+        cell->length = std::min(message.size(), k_max_message);
+        std::memcpy(cell->text.data(), message.data(), cell->length);
+        cell->sequence.store(position + 1, std::memory_order_release);
+        Signal();
+    }
+
+    /// @brief Blocks until every message queued before the call has been forwarded.
+    void Flush()
+    {
+        const std::size_t target = enqueue_.load(std::memory_order_acquire);
+        for (std::size_t done = forwarded_.load(std::memory_order_acquire); done < target;
+             done = forwarded_.load(std::memory_order_acquire)) {
+            forwarded_.wait(done, std::memory_order_acquire);
+        }
+    }
+
+    /// @brief Returns the number of messages dropped because the ring was full.
+    [[nodiscard]] auto Dropped() const -> std::uint64_t { return dropped_.load(std::memory_order_relaxed); }
+
+private:
+    struct Cell {
+        std::atomic<std::size_t> sequence { 0 };
+        LogLevel level = LogLevel::Info;
+        std::size_t length = 0;
+        std::array<char, k_max_message> text {};
+    };
+
+    void Signal()
+    {
+        signal_.fetch_add(1, std::memory_order_release);
+        signal_.notify_one();
+    }
+
+    /// @brief Forwards every message that is ready, in queue order (worker thread only).
+    void Drain()
+    {
+        for (;;) {
+            Cell& cell = cells_[dequeue_ & mask_];
+            if (cell.sequence.load(std::memory_order_acquire) != dequeue_ + 1) {
+                return;
+            }
+            downstream_.Write(cell.level, std::string_view(cell.text.data(), cell.length));
+            cell.sequence.store(dequeue_ + mask_ + 1, std::memory_order_release);
+            ++dequeue_;
+            forwarded_.store(dequeue_, std::memory_order_release);
+            forwarded_.notify_all();
+        }
+    }
+
+    void Run()
+    {
+        for (;;) {
+            // Read the signal before draining: a message queued after the
+            // drain changes it, so the wait below returns immediately
+            const std::uint32_t observed = signal_.load(std::memory_order_acquire);
+            Drain();
+            if (stop_.load(std::memory_order_acquire)) {
+                return;
+            }
+            signal_.wait(observed, std::memory_order_acquire);
+        }
+    }
+
+    LogSink& downstream_;
+    std::size_t mask_;
+    std::unique_ptr<Cell[]> cells_;
+    std::atomic<std::size_t> enqueue_ { 0 };
+    std::size_t dequeue_ = 0;
+    std::atomic<std::size_t> forwarded_ { 0 };
+    std::atomic<std::uint64_t> dropped_ { 0 };
+    std::atomic<std::uint32_t> signal_ { 0 };
+    std::atomic<bool> stop_ { false };
+    std::jthread worker_;
+};
+
+/// @brief Logger forwarding configuration messages to the installed @c LogSink.
+///
+/// Messages go to a @c StreamLogSink (stdout/stderr) unless another sink is
+/// installed with @c SetSink.
+///
+/// Every message is written while registered in one of two writer counts,
+/// chosen by the current epoch.  @c SetSink installs the new sink, advances
+/// the epoch and waits for the count of the previous epoch to drain, so once
+/// it returns no thread is still inside the previous sink.
+class Logger {
+public:
+    /// @brief Installs @p sink for all subsequent messages; nullptr restores the stream sink.
+    ///
+    /// The sink is not owned.  Returns once no thread is still writing to
+    /// the previous sink, which may then be destroyed.  Must not be called
+    /// from within @c LogSink::Write.
+    static void SetSink(LogSink* sink)
+    {
+        auto& registry = Registry();
+        const std::lock_guard lock(registry.set_mutex);
+        registry.sink.store(sink);
+        const std::uint32_t previous = registry.epoch.fetch_add(1);
+        while (registry.writers[previous & 1].load() != 0) {
+            std::this_thread::yield();
+        }
+    }
+
+    /// @brief Returns the sink messages are currently written to.
+    ///
+    /// The reference is only valid until the sink is replaced; log through
+    /// the @c Logger functions rather than keeping it.
+    [[nodiscard]] static auto GetSink() -> LogSink&
+    {
+        LogSink* sink = Registry().sink.load();
+        return sink != nullptr ? *sink : DefaultSink();
+    }
+
+    /// @brief Logs an info message.
+    static void Info(std::string_view message) { Write(LogLevel::Info, message); }
+
+    /// @brief Logs a warning message.
+    static void Warn(std::string_view message) { Write(LogLevel::Warning, message); }
+
+    /// @brief Logs an error message.
+    static void Error(std::string_view message) { Write(LogLevel::Error, message); }
+
+    /// @brief Logs a message at the specified level.
+    static void Log(LogLevel level, std::string_view message) { Write(level, message); }
+
+    /// @brief Logs a formatted info message.
     template <typename... Args>
     static void InfoF(const char* format, Args... args)
     {
-        std::fprintf(stdout, "[cppfig] INFO: ");
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Wformat-nonliteral"
-        std::fprintf(stdout, format, args...);
-#pragma GCC diagnostic pop
-        std::fprintf(stdout, "\n");
+        LogF(LogLevel::Info, format, args...);
     }
 
-    /// @brief Logs a formatted warning message to stderr.
+    /// @brief Logs a formatted warning message.
     template <typename... Args>
     static void WarnF(const char* format, Args... args)
     {
-        std::fprintf(stderr, "[cppfig] WARN: ");
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Wformat-nonliteral"
-        std::fprintf(stderr, format, args...);
-#pragma GCC diagnostic pop
-        std::fprintf(stderr, "\n");
+        LogF(LogLevel::Warning, format, args...);
     }
 
-    /// @brief Logs a formatted error message to stderr.
+    /// @brief Logs a formatted error message.
     template <typename... Args>
     static void ErrorF(const char* format, Args... args)
     {
-        std::fprintf(stderr, "[cppfig] ERROR: ");
+        LogF(LogLevel::Error, format, args...);
+    }
+
+private:
+    /// @brief Formats into a stack buffer (the heap only for long messages) and writes to the sink.
+    template <typename... Args>
+    static void LogF(LogLevel level, const char* format, Args... args)
+    {
+        std::array<char, 512> buffer {};
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wformat-nonliteral"
-        std::fprintf(stderr, format, args...);
+#pragma GCC diagnostic ignored "-Wformat-security"
+        const int length = std::snprintf(buffer.data(), buffer.size(), format, args...);
+        if (length < 0) {
+            return;
+        }
+        if (static_cast<std::size_t>(length) < buffer.size()) {
+            Write(level, std::string_view(buffer.data(), static_cast<std::size_t>(length)));
+            return;
+        }
+        std::string text(static_cast<std::size_t>(length), '\0');
+        std::snprintf(text.data(), text.size() + 1, format, args...);
 #pragma GCC diagnostic pop
-        std::fprintf(stderr, "\n");
+        Write(level, text);
+    }
+
+    /// @brief Installed sink and the writer counts @c SetSink waits on.
+    ///
+    /// All operations are sequentially consistent: a writer that sees the
+    /// epoch unchanged after registering is either seen by the @c SetSink
+    /// that advances it, or loads the sink that @c SetSink installed.
+    struct SinkRegistry {
+        std::atomic<LogSink*> sink { nullptr };
+        std::atomic<std::uint32_t> epoch { 0 };
+        std::array<std::atomic<std::uint32_t>, 2> writers {};
+        std::mutex set_mutex;  ///< Serializes @c SetSink calls.
+    };
+
+    /// @brief Keeps the calling thread registered as a writer of the current epoch.
+    class WriterGuard {
+    public:
+        explicit WriterGuard(SinkRegistry& registry)
+            : registry_(registry)
+            , epoch_(registry.epoch.load())
+        {
+            // Register, then confirm the epoch did not advance in between
+            for (;;) {
+                registry_.writers[epoch_ & 1].fetch_add(1);
+                const std::uint32_t current = registry_.epoch.load();
+                if (current == epoch_) {
+                    return;
+                }
+                registry_.writers[epoch_ & 1].fetch_sub(1);
+                epoch_ = current;
+            }
+        }
+
+        ~WriterGuard() { registry_.writers[epoch_ & 1].fetch_sub(1); }
+
+        WriterGuard(const WriterGuard&) = delete;
+        auto operator=(const WriterGuard&) -> WriterGuard& = delete;
+        WriterGuard(WriterGuard&&) = delete;
+        auto operator=(WriterGuard&&) -> WriterGuard& = delete;
+
+    private:
+        SinkRegistry& registry_;
+        std::uint32_t epoch_;
+    };
+
+    /// @brief Writes one message to the installed sink.
+    static void Write(LogLevel level, std::string_view message)
+    {
+        auto& registry = Registry();
+        const WriterGuard guard(registry);
+        LogSink* sink = registry.sink.load();
+        (sink != nullptr ? *sink : DefaultSink()).Write(level, message);
+    }
+
+    static auto Registry() -> SinkRegistry&
+    {
+        static SinkRegistry registry;
+        return registry;
+    }
+
+    static auto DefaultSink() -> StreamLogSink&
+    {
+        static StreamLogSink sink;
+        return sink;
     }
 };
 
+namespace detail {
+
+    /// @brief Per-key stamps reporting a warning once per configuration generation.
+    ///
+    /// Used for warnings raised on the read path (a value that fails to
+    /// parse is otherwise reported on every @c Get, from every thread).
+    ///
+    /// @tparam N Number of keys (e.g. one per setting).
+    template <std::size_t N>
+    class WarnOnce {
+    public:
+        /// @brief Returns true the first time @p key is reported at @p generation.
+        [[nodiscard]] auto First(std::size_t key, std::uint64_t generation) -> bool
+        {
+            // Stamps are offset by one so that the zero-initialized state
+            // means "never reported"; the load keeps repeated reports off
+            // the cache line's exclusive state
+            const std::uint64_t stamp = generation + 1;
+            auto& slot = stamps_[key];
+            return slot.load(std::memory_order_relaxed) != stamp && slot.exchange(stamp, std::memory_order_relaxed) != stamp;
+        }
+
+    private:
+        std::array<std::atomic<std::uint64_t>, N> stamps_ {};
+    };
+
+}  // namespace detail
+
 }  // namespace cppfig
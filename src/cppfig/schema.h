@@ -1,7 +1,13 @@
 #pragma once
 
+#include <algorithm>
 #include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
 #include <string_view>
+#include <tuple>
 #include <type_traits>
 
 #include "cppfig/setting.h"
@@ -29,6 +35,83 @@ namespace detail {
         return true;
     }
 
+    inline constexpr std::uint64_t k_fnv_offset = 0xcbf29ce484222325ULL;
+    inline constexpr std::uint64_t k_fnv_prime = 0x100000001b3ULL;
+
+    /// @brief FNV-1a hash of @p text, continuing from @p hash.
+    constexpr auto Fnv1a(std::string_view text, std::uint64_t hash = k_fnv_offset) -> std::uint64_t
+    {
+        for (const char c : text) {
+            hash = (hash ^ static_cast<std::uint8_t>(c)) * k_fnv_prime;
+        }
+        return hash;
+    }
+
+    /// @brief Bucket of @p path in a table of @p buckets (a power of two) buckets.
+    constexpr auto PathBucket(std::string_view path, std::size_t buckets) -> std::size_t
+    {
+        return static_cast<std::uint32_t>(Fnv1a(path)) & (buckets - 1);
+    }
+
+    /// @brief FNV-1a hash of the setting paths, in schema order.
+    template <typename... Settings>
+    consteval auto PathsHash() -> std::uint64_t
+    {
+        constexpr std::array<std::string_view, sizeof...(Settings)> paths = { Settings::path... };
+        std::uint64_t hash = k_fnv_offset;
+        for (const auto path : paths) {
+            // Separator, so that {"ab", "c"} and {"a", "bc"} differ
+            hash = (Fnv1a(path, hash) ^ 0xffU) * k_fnv_prime;
+        }
+        return hash;
+    }
+
+    /// @brief Open-addressing table from setting path to slot index, built at compile time.
+    ///
+    /// The table has at least twice as many buckets as settings and uses
+    /// linear probing; @c max_probe is the longest probe sequence of any
+    /// path, so a lookup inspects at most @c max_probe + 1 buckets.
+    template <std::size_t N>
+    struct PathIndex {
+        static constexpr std::size_t k_buckets = std::bit_ceil(2 * N);
+
+        std::array<std::size_t, k_buckets> entries {};  ///< Slot index + 1, or 0 for an empty bucket.
+        std::size_t max_probe = 0;
+    };
+
+    template <typename... Settings>
+    consteval auto BuildPathIndex() -> PathIndex<sizeof...(Settings)>
+    {
+        using index_type = PathIndex<sizeof...(Settings)>;
+        constexpr std::array<std::string_view, sizeof...(Settings)> paths = { Settings::path... };
+
+        index_type index;
+        for (std::size_t i = 0; i < paths.size(); ++i) {
+            std::size_t probe = 0;
+            auto bucket = PathBucket(paths[i], index_type::k_buckets);
+            while (index.entries[bucket] != 0) {
+                bucket = (bucket + 1) & (index_type::k_buckets - 1);
+                ++probe;
+            }
+            index.entries[bucket] = i + 1;
+            index.max_probe = std::max(index.max_probe, probe);
+        }
+        return index;
+    }
+
+    /// @brief Helper to find the position of a type in a parameter pack.
+    template <typename T, typename... Types>
+    consteval auto IndexOf() -> std::size_t
+    {
+        constexpr std::array<bool, sizeof...(Types)> matches = { std::is_same_v<T, Types>... };
+        for (std::size_t i = 0; i < matches.size(); ++i) {
+            if (matches[i]) {
+                return i;
+            }
+        }
+        return matches.size();
+    }
+
 }  // namespace detail
 
 /// @brief Configuration schema holding all setting types.
@@ -66,12 +149,49 @@ public:
     template <typename S>
     static constexpr bool has_setting = detail::IsOneOf<S, Settings...>::value;
 
+    /// @brief Compile-time slot index of a setting (its position in the pack).
+    template <typename S>
+        requires has_setting<S>
+    static constexpr std::size_t index_of = detail::IndexOf<S, Settings...>();
+
+    /// @brief Tuple holding one value per setting, in schema order.
+    using value_tuple = std::tuple<typename Settings::value_type...>;
+
     /// @brief Returns all paths as a compile-time array.
     [[nodiscard]] static constexpr auto GetPaths() -> std::array<std::string_view, size>
     {
         return { Settings::path... };
     }
 
+    /// @brief Compile-time hash identifying the schema's setting paths and their order.
+    ///
+    /// Stamped into binary snapshots so that a snapshot written by a
+    /// different schema is never trusted (see @c Configuration::LoadSnapshot).
+    static constexpr std::uint64_t hash = detail::PathsHash<Settings...>();
+
+    /// @brief Returns the slot index of the setting at @p path, if the schema has one.
+    ///
+    /// Looks @p path up in a hash table generated at compile time: one hash
+    /// of @p path and, in the usual case, a single string comparison.
+    [[nodiscard]] static constexpr auto FindIndex(std::string_view path) -> std::optional<std::size_t>
+    {
+        using index_type = detail::PathIndex<size>;
+        constexpr std::array<std::string_view, size> paths = { Settings::path... };
+
+        auto bucket = detail::PathBucket(path, index_type::k_buckets);
+        for (std::size_t probe = 0; probe <= path_index_.max_probe; ++probe) {
+            const std::size_t entry = path_index_.entries[bucket];
+            if (entry == 0) {
+                return std::nullopt;
+            }
+            if (paths[entry - 1] == path) {
+                return entry - 1;
+            }
+            bucket = (bucket + 1) & (index_type::k_buckets - 1);
+        }
+        return std::nullopt;
+    }
+
     /// @brief Returns the number of settings in the schema.
     [[nodiscard]] static constexpr auto Size() -> std::size_t { return size; }
 
@@ -84,6 +204,9 @@ public:
     {
         (fn.template operator()<Settings>(), ...);
     }
+
+private:
+    static constexpr auto path_index_ = detail::BuildPathIndex<Settings...>();
 };
 
 /// @brief Helper alias to get the value type for a setting.
@@ -1,9 +1,26 @@
 #pragma once
 
+#include <array>
+#include <atomic>
 #include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
 #include <fstream>
 #include <istream>
+#include <sstream>
 #include <string>
+#include <string_view>
+#include <utility>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define CPPFIG_HAS_POSIX_FILES 1
+#endif
 
 #include "cppfig/status.h"
 #include "cppfig/value.h"
@@ -22,30 +39,364 @@ concept Serializer = requires(const Value& data, std::istream& is) {
     { S::Stringify(data) } -> std::convertible_to<std::string>;
 };
 
+/// @brief Concept for serializers that can also parse a contiguous buffer.
+///
+/// Serializers may optionally provide
+/// @code
+/// static auto ParseBuffer(std::string_view buffer) -> StatusOr<Value>;
+/// @endcode
+/// in which case @c ReadFile hands them the whole file contents (memory
+/// mapped where possible) instead of an @c std::istream.
+template <typename S>
+concept HasParseBuffer = Serializer<S> && requires(std::string_view buffer) {
+    { S::ParseBuffer(buffer) } -> std::same_as<StatusOr<Value>>;
+};
+
+/// @brief How a file is brought into memory before parsing.
+enum class FileRead : std::uint8_t {
+    /// Memory map large regular files.  The file must not be truncated
+    /// while it is parsed: accessing pages past the new end raises
+    /// @c SIGBUS.  Files replaced by renaming (as @c WriteFile does) are safe.
+    kMapped,
+    /// Always copy the file into a buffer; safe against concurrent writers.
+    kCopied,
+};
+
+/// @brief Concept for serializers that also report the text of values they read as lists.
+///
+/// Such serializers provide
+/// @code
+/// static auto ParseBuffer(std::string_view buffer, Value& list_texts) -> StatusOr<Value>;
+/// @endcode
+/// which records, at the path of each list value, the value's text as
+/// written.  Configurations use it to give string settings their text back.
+template <typename S>
+concept HasListTexts = HasParseBuffer<S> && requires(std::string_view buffer, Value& list_texts) {
+    { S::ParseBuffer(buffer, list_texts) } -> std::same_as<StatusOr<Value>>;
+};
+
+namespace detail {
+
+    /// @brief Parses @p buffer with @p S, recording list texts when the serializer reports them.
+    template <typename S>
+        requires HasParseBuffer<S>
+    auto ParseBuffer(std::string_view buffer, Value& list_texts) -> StatusOr<Value>
+    {
+        if constexpr (HasListTexts<S>) {
+            return S::ParseBuffer(buffer, list_texts);
+        }
+        else {
+            return S::ParseBuffer(buffer);
+        }
+    }
+
+    /// @brief Read-only contents of a whole file.
+    ///
+    /// On POSIX, with @c FileRead::kMapped, regular files of at least
+    /// @c k_mmap_threshold bytes are memory mapped; smaller files (where
+    /// page-fault and unmap costs dominate) are read with a single @c read
+    /// call.  Other platforms and non-regular files fall back to buffered reads.
+    class FileContents {
+    public:
+        static constexpr std::size_t k_mmap_threshold = 64 * 1024;
+
+        /// @brief Opens and reads (or maps) the file at @p path.
+        [[nodiscard]] static auto Open(const std::string& path, FileRead read = FileRead::kMapped)
+            -> StatusOr<FileContents>
+        {
+#if defined(CPPFIG_HAS_POSIX_FILES)
+            const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+            if (fd < 0) {
+                return NotFoundError("Could not open file: " + path);
+            }
+
+            FileContents contents;
+            struct stat info { };
+            if (::fstat(fd, &info) == 0 && read == FileRead::kMapped && S_ISREG(info.st_mode)
+                && static_cast<std::size_t>(info.st_size) >= k_mmap_threshold) {
+                const auto size = static_cast<std::size_t>(info.st_size);
+                void* mapping = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+                if (mapping != MAP_FAILED) {
+                    ::close(fd);
+                    contents.mapping_ = mapping;
+                    contents.view_ = std::string_view(static_cast<const char*>(mapping), size);
+                    return contents;
+                }
+            }
+
+            // Copied, small, non-regular or unmappable file: read it in as few calls as possible
+            if (S_ISREG(info.st_mode)) {
+                contents.buffer_.reserve(static_cast<std::size_t>(info.st_size));
+            }
+            std::array<char, 64 * 1024> chunk {};
+            while (true) {
+                const auto count = ::read(fd, chunk.data(), chunk.size());
+                if (count < 0) {
+                    if (errno == EINTR) {
+                        continue;
+                    }
+                    ::close(fd);
+                    return InternalError("Failed to read file: " + path);
+                }
+                if (count == 0) {
+                    break;
+                }
+                contents.buffer_.append(chunk.data(), static_cast<std::size_t>(count));
+            }
+            ::close(fd);
+            contents.view_ = contents.buffer_;
+            return contents;
+#else
+            (void)read;
+            std::ifstream file(path, std::ios::binary);
+            if (!file.is_open()) {
+                return NotFoundError("Could not open file: " + path);
+            }
+            FileContents contents;
+            std::ostringstream stream;
+            stream << file.rdbuf();
+            contents.buffer_ = std::move(stream).str();
+            contents.view_ = contents.buffer_;
+            return contents;
+#endif
+        }
+
+        FileContents(FileContents&& other) noexcept
+            : buffer_(std::move(other.buffer_))
+            , mapping_(std::exchange(other.mapping_, nullptr))
+            , view_(mapping_ != nullptr ? other.view_ : std::string_view(buffer_))
+        {
+            other.view_ = {};
+        }
+
+        auto operator=(FileContents&& other) noexcept -> FileContents&
+        {
+            if (this != &other) {
+                Unmap();
+                buffer_ = std::move(other.buffer_);
+                mapping_ = std::exchange(other.mapping_, nullptr);
+                view_ = mapping_ != nullptr ? other.view_ : std::string_view(buffer_);
+                other.view_ = {};
+            }
+            return *this;
+        }
+
+        FileContents(const FileContents&) = delete;
+        auto operator=(const FileContents&) -> FileContents& = delete;
+
+        ~FileContents() { Unmap(); }
+
+        /// @brief Returns whether the contents are memory mapped.
+        [[nodiscard]] auto IsMapped() const -> bool { return mapping_ != nullptr; }
+
+        /// @brief Returns the file contents.
+        [[nodiscard]] auto View() const -> std::string_view { return view_; }
+
+    private:
+        FileContents() = default;
+
+        void Unmap()
+        {
+#if defined(CPPFIG_HAS_POSIX_FILES)
+            if (mapping_ != nullptr) {
+                ::munmap(mapping_, view_.size());
+                mapping_ = nullptr;
+            }
+#endif
+        }
+
+        std::string buffer_;
+        void* mapping_ = nullptr;
+        std::string_view view_;
+    };
+
+    /// @brief Returns a temporary file name next to @p target, unique within the process.
+    [[nodiscard]] inline auto TemporarySibling(const std::filesystem::path& target) -> std::filesystem::path
+    {
+        static std::atomic<unsigned> counter { 0 };
+        std::string name = target.filename().string() + ".tmp.";
+#if defined(CPPFIG_HAS_POSIX_FILES)
+        name += std::to_string(::getpid()) + ".";
+#endif
+        name += std::to_string(counter.fetch_add(1, std::memory_order_relaxed));
+        return target.parent_path() / name;
+    }
+
+#if defined(CPPFIG_HAS_POSIX_FILES)
+    /// @brief Writes all of @p contents to @p fd, retrying short writes.
+    [[nodiscard]] inline auto WriteAll(int fd, std::string_view contents) -> bool
+    {
+        while (!contents.empty()) {
+            const auto count = ::write(fd, contents.data(), contents.size());
+            if (count < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                return false;
+            }
+            contents.remove_prefix(static_cast<std::size_t>(count));
+        }
+        return true;
+    }
+
+    /// @brief Overwrites a file in place.
+    ///
+    /// Used for non-regular files (devices, FIFOs), which cannot be renamed
+    /// over, and for files in directories where no temporary file can be created.
+    [[nodiscard]] inline auto WriteInPlace(const std::string& path, std::string_view contents) -> Status
+    {
+        const int fd = ::open(path.c_str(), O_WRONLY | O_TRUNC | O_CLOEXEC);
+        if (fd < 0) {
+            return InternalError("Could not write to file: " + path);
+        }
+        const bool written = WriteAll(fd, contents);
+        if (::close(fd) != 0 || !written) {
+            return InternalError("Failed to write to file: " + path);
+        }
+        return OkStatus();
+    }
+#endif
+
+    /// @brief Atomically replaces the file at @p path with @p contents.
+    ///
+    /// The contents are written to a temporary file in the same directory,
+    /// flushed to disk and renamed over the target, so readers (and a crash
+    /// at any point) see either the old or the new file, never a truncated
+    /// one.  Symbolic links are followed and kept; the file's permission bits
+    /// (and, where permitted, its owner) are preserved.  A target that is not
+    /// writable is refused as before rather than silently replaced.
+    /// Non-regular targets such as devices, and existing files in a
+    /// directory where the temporary file cannot be created, are written in
+    /// place without the atomicity guarantee.
+    [[nodiscard]] inline auto WriteFileAtomically(const std::string& path, std::string_view contents) -> Status
+    {
+        namespace fs = std::filesystem;
+
+        std::error_code error_code;
+        fs::path target(path);
+        if (fs::is_symlink(target, error_code)) {
+            auto resolved = fs::canonical(target, error_code);
+            if (!error_code) {
+                target = std::move(resolved);
+            }
+        }
+
+#if defined(CPPFIG_HAS_POSIX_FILES)
+        struct stat info { };
+        const bool exists = ::stat(target.c_str(), &info) == 0;
+        if (exists && !S_ISREG(info.st_mode)) {
+            return WriteInPlace(path, contents);
+        }
+        if (exists && ::faccessat(AT_FDCWD, target.c_str(), W_OK, AT_EACCESS) != 0) {
+            return InternalError("Could not write to file: " + path);
+        }
+
+        const fs::path temporary = TemporarySibling(target);
+        // New files get the usual 0666 & ~umask; replacements copy the old mode below
+        const int fd = ::open(temporary.c_str(), O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC, 0666);
+        if (fd < 0) {
+            // E.g. a writable file in a read-only directory
+            return exists ? WriteInPlace(path, contents) : InternalError("Could not write to file: " + path);
+        }
+        if (exists) {
+            // Keeping the owner requires privileges; the mode is still preserved
+            (void)::fchown(fd, info.st_uid, info.st_gid);
+            if (::fchmod(fd, info.st_mode & 07777) != 0) {
+                ::close(fd);
+                ::unlink(temporary.c_str());
+                return InternalError("Failed to write to file: " + path);
+            }
+        }
+
+        const bool written = WriteAll(fd, contents) && ::fsync(fd) == 0;
+        if (::close(fd) != 0 || !written || ::rename(temporary.c_str(), target.c_str()) != 0) {
+            ::unlink(temporary.c_str());
+            return InternalError("Failed to write to file: " + path);
+        }
+
+        // Make the rename itself durable
+        const fs::path directory = target.has_parent_path() ? target.parent_path() : fs::path(".");
+        const int dir_fd = ::open(directory.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+        if (dir_fd >= 0) {
+            (void)::fsync(dir_fd);
+            ::close(dir_fd);
+        }
+        return OkStatus();
+#else
+        const fs::path temporary = TemporarySibling(target);
+        {
+            std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+            if (!file.is_open()) {
+                return InternalError("Could not write to file: " + path);
+            }
+            file.write(contents.data(), static_cast<std::streamsize>(contents.size()));
+            file.flush();
+            if (file.fail()) {
+                file.close();
+                fs::remove(temporary, error_code);
+                return InternalError("Failed to write to file: " + path);
+            }
+        }
+        fs::rename(temporary, target, error_code);
+        if (error_code) {
+            fs::remove(temporary, error_code);
+            return InternalError("Failed to write to file: " + path);
+        }
+        return OkStatus();
+#endif
+    }
+
+}  // namespace detail
+
 /// @brief Helper to read a file into a Value tree via a serializer.
+///
+/// Serializers satisfying @c HasParseBuffer parse the whole file contents
+/// directly (memory mapped for large files unless @p read is
+/// @c FileRead::kCopied); others get an @c std::ifstream.
 template <Serializer S>
-auto ReadFile(const std::string& path) -> StatusOr<Value>
+auto ReadFile(const std::string& path, FileRead read = FileRead::kMapped) -> StatusOr<Value>
 {
-    std::ifstream file(path);
-    if (!file.is_open()) {
-        return NotFoundError("Could not open file: " + path);
+    if constexpr (HasParseBuffer<S>) {
+        auto contents = detail::FileContents::Open(path, read);
+        if (!contents.ok()) {
+            return contents.status();
+        }
+        return S::ParseBuffer(contents->View());
+    }
+    else {
+        std::ifstream file(path);
+        if (!file.is_open()) {
+            return NotFoundError("Could not open file: " + path);
+        }
+        return S::Parse(file);
     }
-    return S::Parse(file);
 }
 
-/// @brief Helper to write a Value tree to a file via a serializer.
+/// @brief Like @c ReadFile, also recording list texts (see @c HasListTexts) in @p list_texts.
 template <Serializer S>
-auto WriteFile(const std::string& path, const Value& data) -> Status
+auto ReadFile(const std::string& path, FileRead read, Value& list_texts) -> StatusOr<Value>
 {
-    std::ofstream file(path);
-    if (!file.is_open()) {
-        return InternalError("Could not write to file: " + path);
+    if constexpr (HasListTexts<S>) {
+        auto contents = detail::FileContents::Open(path, read);
+        if (!contents.ok()) {
+            return contents.status();
+        }
+        return S::ParseBuffer(contents->View(), list_texts);
     }
-    file << S::Stringify(data);
-    if (file.fail()) {
-        return InternalError("Failed to write to file: " + path);
+    else {
+        return ReadFile<S>(path, read);
     }
-    return OkStatus();
+}
+
+/// @brief Helper to write a Value tree to a file via a serializer.
+///
+/// The file is replaced atomically and durably (see
+/// @c detail::WriteFileAtomically): a failed or interrupted write leaves
+/// the previous contents intact.
+template <Serializer S>
+auto WriteFile(const std::string& path, const Value& data) -> Status
+{
+    return detail::WriteFileAtomically(path, S::Stringify(data));
 }
 
 }  // namespace cppfig
@@ -19,7 +19,8 @@ namespace cppfig {
 ///
 /// Optional:
 /// - env_override: std::string_view with environment variable name
-/// - validator(): Static function returning a Validator<value_type>
+/// - validator(): Static function returning a validator for value_type, either
+///   a concrete composition (`static auto validator()`) or a Validator<value_type>
 ///
 /// Example:
 /// @code
@@ -28,7 +29,7 @@ namespace cppfig {
 ///     static constexpr std::string_view env_override = "SERVER_HOST";
 ///     using value_type = std::string;
 ///     static auto default_value() -> value_type { return "localhost"; }
-///     static auto validator() -> Validator<value_type> { return NotEmpty(); }
+///     static auto validator() { return NotEmpty(); }
 /// };
 /// @endcode
 template <typename S>
@@ -47,7 +48,7 @@ concept HasEnvOverride = IsSetting<S> && requires {
 /// @brief Concept for settings with custom validator.
 template <typename S>
 concept HasValidator = IsSetting<S> && requires {
-    { S::validator() } -> std::same_as<Validator<typename S::value_type>>;
+    { S::validator() } -> ValidatorFor<typename S::value_type>;
 };
 
 /// @brief Helper to get environment override for a setting (empty if not defined).
@@ -63,14 +64,20 @@ constexpr auto GetEnvOverride() -> std::string_view
 }
 
 /// @brief Helper to get validator for a setting (always-valid if not defined).
+///
+/// The validator is built by the first call and reused afterwards, so
+/// @c S::validator() runs once per process and must not depend on state that
+/// changes at runtime.
 template <IsSetting S>
-auto GetSettingValidator() -> Validator<typename S::value_type>
+auto GetSettingValidator() -> const auto&
 {
     if constexpr (HasValidator<S>) {
-        return S::validator();
+        static const auto validator = S::validator();
+        return validator;
     }
     else {
-        return AlwaysValid<typename S::value_type>();
+        static const AlwaysValidValidator<typename S::value_type> validator;
+        return validator;
     }
 }
 
@@ -0,0 +1,367 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "cppfig/setting.h"
+#include "cppfig/traits.h"
+#include "cppfig/value.h"
+
+namespace cppfig {
+
+/// @brief Where the value held by a typed slot came from.
+enum class SlotSource : std::uint8_t {
+    kDefault,  ///< No file value; the slot holds the setting's default.
+    kFile,         ///< The slot holds the deserialized file value.
+    kEnvironment,  ///< The slot holds the parsed environment variable value.
+    kInvalid,      ///< A value exists but failed to parse; the slot holds the fallback.
+};
+
+namespace detail {
+
+    /// @brief Maps std::tuple<Ts...> to std::tuple<std::optional<Ts>...>.
+    template <typename Tuple>
+    struct OptionalTuple;
+
+    template <typename... Ts>
+    struct OptionalTuple<std::tuple<Ts...>> {
+        using type = std::tuple<std::optional<Ts>...>;
+    };
+
+    /// @brief Null-terminated copy of a setting's environment variable name.
+    template <IsSetting S>
+    inline constexpr auto kEnvName = [] {
+        constexpr std::string_view name = GetEnvOverride<S>();
+        std::array<char, name.size() + 1> buffer {};
+        for (std::size_t i = 0; i < name.size(); ++i) {
+            buffer[i] = name[i];
+        }
+        return buffer;
+    }();
+
+    /// @brief Whether slots of @p T defer deserialization to the first read.
+    ///
+    /// Scalars and strings deserialize as cheaply as a lazy slot can be
+    /// checked; everything else (containers, custom types converted through
+    /// JSON) is parsed once, on first access.
+    template <typename T>
+    inline constexpr bool kDeferredSlot = !std::is_arithmetic_v<T> && !std::is_same_v<T, std::string>;
+
+    /// @brief Slot value of a deferred setting, deserialized on first read.
+    ///
+    /// Holds either a resolved value or the raw file value together with a
+    /// once-flag.  Once resolved it never changes, so tables copied for a
+    /// snapshot share it and concurrent readers resolve it exactly once.
+    template <IsSetting S>
+    class LazySlot {
+    public:
+        using value_type = typename S::value_type;
+
+        /// @brief A slot holding @p value, already resolved.
+        LazySlot(value_type value, SlotSource source)
+            : value_(std::move(value))
+            , source_(source)
+        {
+        }
+
+        /// @brief A slot deserializing @p raw on first read.
+        explicit LazySlot(Value raw)
+            : raw_(std::move(raw))
+        {
+        }
+
+        [[nodiscard]] auto Get() const -> const value_type&
+        {
+            Resolve();
+            return *value_;
+        }
+
+        [[nodiscard]] auto Source() const -> SlotSource
+        {
+            Resolve();
+            return source_;
+        }
+
+    private:
+        void Resolve() const
+        {
+            std::call_once(once_, [this] {
+                if (value_.has_value()) {
+                    return;
+                }
+                value_ = ConfigTraits<value_type>::Deserialize(raw_);
+                if (!value_.has_value()) {
+                    value_ = S::default_value();
+                    source_ = SlotSource::kInvalid;
+                }
+                raw_ = Value();
+            });
+        }
+
+        mutable std::once_flag once_;
+        mutable Value raw_;
+        mutable std::optional<value_type> value_;
+        mutable SlotSource source_ = SlotSource::kFile;
+    };
+
+    /// @brief Storage of one slot: the value itself, or a shared @c LazySlot for deferred types.
+    template <IsSetting S>
+    using SlotStorage = std::conditional_t<kDeferredSlot<typename S::value_type>, std::shared_ptr<const LazySlot<S>>,
+                                           typename S::value_type>;
+
+    /// @brief Maps ConfigSchema<Settings...> to std::tuple<SlotStorage<Settings>...>.
+    template <typename Schema>
+    struct SlotTuple;
+
+    template <template <typename...> typename SchemaT, typename... Settings>
+    struct SlotTuple<SchemaT<Settings...>> {
+        using type = std::tuple<SlotStorage<Settings>...>;
+    };
+
+    /// @brief Gives string settings that a serializer read as lists their text back.
+    ///
+    /// `name = [prod]` in a `.conf` file is read as a list; a string setting
+    /// at that path gets the value's text as written instead (see @c HasListTexts).
+    template <typename Schema>
+    void RestoreListTexts(Value& tree, const Value& list_texts)
+    {
+        if (!list_texts.IsObject()) {
+            return;
+        }
+        Schema::ForEachSetting([&tree, &list_texts]<typename S>() {
+            if constexpr (std::is_same_v<typename S::value_type, std::string>) {
+                const Value* text = list_texts.FindAtPath(S::path);
+                if (text != nullptr && text->IsString()) {
+                    tree.SetAtPath(S::path, *text);
+                }
+            }
+        });
+    }
+
+}  // namespace detail
+
+/// @brief Flat, compile-time indexed storage of resolved setting values.
+///
+/// Every setting of the schema owns one slot, addressed by its position in
+/// the `ConfigSchema` pack.  Slots hold the already-deserialized
+/// `value_type`, so reading a setting is a single indexed load instead of a
+/// dot-path walk through the Value tree followed by deserialization.
+///
+/// Slots of non-scalar types (see @c detail::kDeferredSlot) keep the raw
+/// file value instead and deserialize it on the first @c Get or @c Source,
+/// memoizing the result until the slot is resolved or assigned again.
+///
+/// The table does not own the Value tree it is resolved from; callers
+/// re-resolve it whenever the tree is replaced.
+///
+/// @tparam Schema The ConfigSchema type defining all settings.
+template <typename Schema>
+class SlotTable {
+public:
+    /// @brief Creates a table where every slot holds its default value.
+    SlotTable()
+    {
+        Schema::ForEachSetting([this]<typename S>() { AssignDefault<S>(); });
+    }
+
+    /// @brief Returns the value held by the slot of setting S.
+    ///
+    /// Deserializes a deferred slot on its first read.
+    template <IsSetting S>
+    [[nodiscard]] auto Get() const -> const typename S::value_type&
+    {
+        const auto& slot = std::get<Schema::template index_of<S>>(values_);
+        if constexpr (detail::kDeferredSlot<typename S::value_type>) {
+            return slot->Get();
+        }
+        else {
+            return slot;
+        }
+    }
+
+    /// @brief Returns where the value of setting S came from.
+    ///
+    /// Telling @c kFile from @c kInvalid deserializes a deferred slot.
+    template <IsSetting S>
+    [[nodiscard]] auto Source() const -> SlotSource
+    {
+        constexpr auto index = Schema::template index_of<S>;
+        if constexpr (detail::kDeferredSlot<typename S::value_type>) {
+            if (sources_[index] != SlotSource::kDefault) {
+                return std::get<index>(values_)->Source();
+            }
+        }
+        return sources_[index];
+    }
+
+    /// @brief Checks whether setting S was resolved from a file value, without deserializing it.
+    template <IsSetting S>
+    [[nodiscard]] auto HasFileValue() const -> bool
+    {
+        return sources_[Schema::template index_of<S>] != SlotSource::kDefault;
+    }
+
+    /// @brief Stores a value into the slot of setting S.
+    template <IsSetting S>
+    void Assign(typename S::value_type value, SlotSource source)
+    {
+        constexpr auto index = Schema::template index_of<S>;
+        if constexpr (detail::kDeferredSlot<typename S::value_type>) {
+            std::get<index>(values_) = std::make_shared<const detail::LazySlot<S>>(std::move(value), source);
+        }
+        else {
+            std::get<index>(values_) = std::move(value);
+        }
+        sources_[index] = source;
+    }
+
+    /// @brief Re-resolves the slot of setting S from a Value tree.
+    ///
+    /// The file value wins when present and deserializable; otherwise the
+    /// slot falls back to the setting's default.  Deferred slots only keep
+    /// a reference to the file value here.
+    template <IsSetting S>
+    void Resolve(const Value& tree)
+    {
+        using value_type = typename S::value_type;
+
+        const Value* file_value = tree.FindAtPath(S::path);
+        if (file_value == nullptr) {
+            AssignDefault<S>();
+            return;
+        }
+
+        if constexpr (detail::kDeferredSlot<value_type>) {
+            constexpr auto index = Schema::template index_of<S>;
+            std::get<index>(values_) = std::make_shared<const detail::LazySlot<S>>(*file_value);
+            sources_[index] = SlotSource::kFile;
+        }
+        else {
+            auto parsed = ConfigTraits<value_type>::Deserialize(*file_value);
+            if (parsed.has_value()) {
+                Assign<S>(std::move(*parsed), SlotSource::kFile);
+            }
+            else {
+                Assign<S>(S::default_value(), SlotSource::kInvalid);
+            }
+        }
+    }
+
+    /// @brief Re-resolves every slot from a Value tree.
+    void ResolveAll(const Value& tree)
+    {
+        Schema::ForEachSetting([this, &tree]<typename S>() { Resolve<S>(tree); });
+    }
+
+private:
+    /// @brief Stores the default of setting S; deferred slots share one default per setting.
+    template <IsSetting S>
+    void AssignDefault()
+    {
+        if constexpr (detail::kDeferredSlot<typename S::value_type>) {
+            static const auto slot = std::make_shared<const detail::LazySlot<S>>(S::default_value(), SlotSource::kDefault);
+            constexpr auto index = Schema::template index_of<S>;
+            std::get<index>(values_) = slot;
+            sources_[index] = SlotSource::kDefault;
+        }
+        else {
+            Assign<S>(S::default_value(), SlotSource::kDefault);
+        }
+    }
+
+    typename detail::SlotTuple<Schema>::type values_;
+    std::array<SlotSource, Schema::size> sources_ {};
+};
+
+/// @brief Snapshot of the environment variable overrides of a schema.
+///
+/// @c ResolveAll reads and parses the environment variable of every setting
+/// with an @c env_override once; lookups afterwards never touch the process
+/// environment.  Settings without an override always report
+/// @c SlotSource::kDefault.
+///
+/// @tparam Schema The ConfigSchema type defining all settings.
+template <typename Schema>
+class EnvironmentTable {
+public:
+    /// @brief Returns the parsed override of setting S, or nullptr if none applies.
+    template <IsSetting S>
+    [[nodiscard]] auto Find() const -> const typename S::value_type*
+    {
+        const auto& value = std::get<Schema::template index_of<S>>(values_);
+        return value.has_value() ? &*value : nullptr;
+    }
+
+    /// @brief Returns whether the override of setting S is unset, parsed or invalid.
+    template <IsSetting S>
+    [[nodiscard]] auto Source() const -> SlotSource
+    {
+        return sources_[Schema::template index_of<S>];
+    }
+
+    /// @brief Returns the raw text of the environment variable of setting S (empty if unset).
+    template <IsSetting S>
+    [[nodiscard]] auto Text() const -> std::string_view
+    {
+        return text_[Schema::template index_of<S>];
+    }
+
+    /// @brief Returns the raw text of an override that failed to parse.
+    template <IsSetting S>
+    [[nodiscard]] auto InvalidText() const -> std::string_view
+    {
+        return Source<S>() == SlotSource::kInvalid ? Text<S>() : std::string_view();
+    }
+
+    /// @brief Checks whether setting S resolves to the same override in both tables.
+    template <IsSetting S>
+    [[nodiscard]] auto SameOverride(const EnvironmentTable& other) const -> bool
+    {
+        return Source<S>() == other.template Source<S>() && Text<S>() == other.template Text<S>();
+    }
+
+    /// @brief Re-reads the environment variable of setting S.
+    template <IsSetting S>
+    void Resolve()
+    {
+        if constexpr (HasEnvOverride<S>) {
+            constexpr auto index = Schema::template index_of<S>;
+            auto& value = std::get<index>(values_);
+            value.reset();
+            text_[index].clear();
+            sources_[index] = SlotSource::kDefault;
+
+            const char* env_value = std::getenv(detail::kEnvName<S>.data());
+            if (env_value == nullptr) {
+                return;
+            }
+
+            text_[index] = env_value;
+            value = ConfigTraits<typename S::value_type>::FromString(text_[index]);
+            sources_[index] = value.has_value() ? SlotSource::kEnvironment : SlotSource::kInvalid;
+        }
+    }
+
+    /// @brief Re-reads the environment variables of every setting.
+    void ResolveAll()
+    {
+        Schema::ForEachSetting([this]<typename S>() { Resolve<S>(); });
+    }
+
+private:
+    typename detail::OptionalTuple<typename Schema::value_tuple>::type values_;
+    std::array<SlotSource, Schema::size> sources_ {};
+    std::array<std::string, Schema::size> text_;
+};
+
+}  // namespace cppfig
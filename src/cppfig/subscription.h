@@ -0,0 +1,108 @@
+#pragma once
+
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "cppfig/setting.h"
+
+namespace cppfig {
+
+/// @brief Identifier of a change subscription, used to unsubscribe.
+using SubscriptionId = std::uint64_t;
+
+/// @brief Callback invoked with the new value of a setting.
+template <IsSetting S>
+using ChangeCallback = std::function<void(const typename S::value_type&)>;
+
+namespace detail {
+
+    /// @brief Maps std::tuple<Ts...> to a tuple of (id, callback) lists, one per value type.
+    template <typename Tuple>
+    struct CallbackListTuple;
+
+    template <typename... Ts>
+    struct CallbackListTuple<std::tuple<Ts...>> {
+        using type = std::tuple<std::vector<std::pair<SubscriptionId, std::function<void(const Ts&)>>>...>;
+    };
+
+}  // namespace detail
+
+/// @brief Per-setting registry of change callbacks.
+///
+/// Callbacks are stored in one list per schema slot, so notifying the
+/// subscribers of a setting never looks at the subscribers of any other.
+/// The table is not synchronized; the owning configuration guards it.
+///
+/// @tparam Schema The ConfigSchema type defining all settings.
+template <typename Schema>
+class SubscriptionTable {
+public:
+    /// @brief Bit set of schema slots, indexed by @c Schema::index_of.
+    using change_set = std::bitset<Schema::size>;
+
+    /// @brief Registers a callback for setting S and returns its id.
+    template <IsSetting S>
+    auto Add(ChangeCallback<S> callback) -> SubscriptionId
+    {
+        const SubscriptionId id = ++last_id_;
+        std::get<Schema::template index_of<S>>(callbacks_).emplace_back(id, std::move(callback));
+        ++size_;
+        return id;
+    }
+
+    /// @brief Removes a callback; returns false if the id is unknown.
+    auto Remove(SubscriptionId id) -> bool
+    {
+        bool removed = false;
+        Schema::ForEachSetting([this, id, &removed]<typename S>() {
+            if (removed) {
+                return;
+            }
+            auto& list = std::get<Schema::template index_of<S>>(callbacks_);
+            removed = std::erase_if(list, [id](const auto& entry) { return entry.first == id; }) > 0;
+        });
+        if (removed) {
+            --size_;
+        }
+        return removed;
+    }
+
+    /// @brief Returns the total number of registered callbacks.
+    [[nodiscard]] auto Size() const -> std::size_t { return size_; }
+
+    /// @brief Returns the slots that have at least one callback.
+    [[nodiscard]] auto Subscribed() const -> change_set
+    {
+        change_set subscribed;
+        Schema::ForEachSetting([this, &subscribed]<typename S>() {
+            constexpr auto index = Schema::template index_of<S>;
+            subscribed[index] = !std::get<index>(callbacks_).empty();
+        });
+        return subscribed;
+    }
+
+    /// @brief Returns a copy of the callbacks of setting S (safe to invoke without the table's guard).
+    template <IsSetting S>
+    [[nodiscard]] auto Callbacks() const -> std::vector<ChangeCallback<S>>
+    {
+        const auto& list = std::get<Schema::template index_of<S>>(callbacks_);
+        std::vector<ChangeCallback<S>> result;
+        result.reserve(list.size());
+        for (const auto& entry : list) {
+            result.push_back(entry.second);
+        }
+        return result;
+    }
+
+private:
+    typename detail::CallbackListTuple<typename Schema::value_tuple>::type callbacks_;
+    SubscriptionId last_id_ = 0;
+    std::size_t size_ = 0;
+};
+
+}  // namespace cppfig
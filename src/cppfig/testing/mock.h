@@ -47,7 +47,12 @@ class MockConfiguration {
 public:
     using schema_type = Schema;
 
-    MockConfiguration() { BuildDefaults(); }
+    /// @brief Constructs a mock holding only defaults.
+    ///
+    /// Defaults are not materialized: @c Get falls back to
+    /// @c S::default_value() for every setting without an override, so
+    /// construction does not allocate.
+    MockConfiguration() = default;
 
     /// @brief Gets the value for a setting type.
     template <IsSetting S>
@@ -84,7 +89,7 @@ public:
         requires(Schema::template has_setting<S>)
     auto Set(typename S::value_type value) -> Status
     {
-        auto validator = GetSettingValidator<S>();
+        const auto& validator = GetSettingValidator<S>();
         auto validation = validator(value);
         if (!validation) {
             return InvalidArgumentError(validation.error_message);
@@ -101,11 +106,7 @@ public:
     [[nodiscard]] auto Save() const -> Status { return OkStatus(); }
 
     /// @brief Resets all values to defaults.
-    void Reset()
-    {
-        values_.clear();
-        BuildDefaults();
-    }
+    void Reset() { values_.clear(); }
 
     /// @brief Sets a raw Value for testing parse failure scenarios.
     ///
@@ -123,15 +124,6 @@ public:
     void ClearValue(std::string_view path) { values_.erase(std::string(path)); }
 
 private:
-    void BuildDefaults()
-    {
-        Schema::ForEachSetting([this]<typename S>() {
-            using value_type = typename S::value_type;
-            std::string key(S::path);
-            values_[key] = ConfigTraits<value_type>::Serialize(S::default_value());
-        });
-    }
-
     std::unordered_map<std::string, Value> values_;
 };
 
@@ -154,6 +146,8 @@ public:
     MOCK_METHOD(std::string_view, GetFilePath, (), (const, override));
     MOCK_METHOD(Status, ValidateAll, (), (const, override));
     MOCK_METHOD(std::string, GetDiffString, (), (const, override));
+    MOCK_METHOD(StatusOr<Value>, GetByPath, (std::string_view path), (const, override));
+    MOCK_METHOD(Status, SetByPath, (std::string_view path, const Value& value), (override));
 };
 
 /// @brief Test fixture helper for configuration tests.
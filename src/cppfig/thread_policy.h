@@ -1,7 +1,13 @@
 #pragma once
 
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
 #include <mutex>
 #include <shared_mutex>
+#include <utility>
 
 namespace cppfig {
 
@@ -69,4 +75,272 @@ struct MultiThreadedPolicy {
     using unique_lock = std::unique_lock<std::shared_mutex>;
 };
 
+namespace detail {
+
+    /// @brief Assumed cache-line size used to pad independently locked stripes.
+    ///
+    /// @c std::hardware_destructive_interference_size is not used because its
+    /// value may differ between translation units compiled with different flags.
+    inline constexpr std::size_t k_cache_line_size = 64;
+
+    /// @brief Stripe set of a policy without stripes; locking it is a no-op.
+    struct NoStripes {
+        template <typename Lock>
+        struct all_lock {  // NOLINT(readability-identifier-naming)
+            explicit all_lock(NoStripes& /*unused*/) { }
+        };
+    };
+
+}  // namespace detail
+
+/// @brief Fixed set of reader-writer locks, each on its own cache line.
+///
+/// @tparam Stripes Number of stripes.
+template <std::size_t Stripes>
+class StripeSet {
+public:
+    static constexpr std::size_t size = Stripes;
+
+    /// @brief Returns the mutex of stripe @p index.
+    [[nodiscard]] auto operator[](std::size_t index) -> std::shared_mutex& { return stripes_[index].mutex; }
+
+    /// @brief Locks every stripe in index order and releases them on destruction.
+    ///
+    /// @tparam Lock @c std::shared_lock or @c std::unique_lock of @c std::shared_mutex.
+    template <typename Lock>
+    class all_lock {  // NOLINT(readability-identifier-naming)
+    public:
+        explicit all_lock(StripeSet& stripes)
+        {
+            for (std::size_t i = 0; i < Stripes; ++i) {
+                locks_[i] = Lock(stripes[i]);
+            }
+        }
+
+    private:
+        std::array<Lock, Stripes> locks_;
+    };
+
+private:
+    struct alignas(detail::k_cache_line_size) Stripe {
+        std::shared_mutex mutex;
+    };
+
+    std::array<Stripe, Stripes> stripes_;
+};
+
+/// @brief Thread policy for write-heavy multi-threaded usage (lock striping).
+///
+/// Settings are partitioned at compile time into @p Stripes stripes by the
+/// hash of their top-level section (@c "feature" for @c "feature.beta"), so
+/// all settings of one section share a stripe.  @c Get takes only the shared
+/// lock of its setting's stripe, and @c Set the exclusive lock of that stripe
+/// plus the lock guarding the Value tree, so toggling @c feature.x does not
+/// stall readers of @c server.port.  Whole-state operations (@c Load,
+/// @c ValidateAll, @c Save, transactions, diffs) acquire every stripe in
+/// index order first.
+///
+/// Prefer this policy when @c Set is frequent and spread over sections; for
+/// read-mostly workloads @c SnapshotPolicy is cheaper.
+///
+/// Usage:
+/// @code
+/// cppfig::Configuration<MySchema, cppfig::ConfSerializer, cppfig::ShardedPolicy<>>
+///     config("config.conf");
+/// @endcode
+///
+/// @tparam Stripes Number of independently locked stripes.
+template <std::size_t Stripes = 16>
+struct ShardedPolicy {
+    static_assert(Stripes > 0, "ShardedPolicy needs at least one stripe");
+
+    /// @brief Mutex guarding the Value tree and the non-setting state.
+    using mutex_type = std::shared_mutex;
+
+    /// @brief Shared (reader) lock.
+    using shared_lock = std::shared_lock<std::shared_mutex>;
+
+    /// @brief Unique (writer) lock.
+    using unique_lock = std::unique_lock<std::shared_mutex>;
+
+    /// @brief Per-section stripe locks.
+    using stripe_set = StripeSet<Stripes>;  // NOLINT(readability-identifier-naming)
+};
+
+/// @brief Concept satisfied by thread policies that stripe their locks per section.
+template <typename P>
+concept IsShardedPolicy = requires { typename P::stripe_set; };
+
+namespace detail {
+
+    /// @brief Returns a process-wide unique, never-reused snapshot cell id.
+    inline auto NextSnapshotCellId() -> std::uint64_t
+    {
+        static std::atomic<std::uint64_t> next_id { 1 };
+        return next_id.fetch_add(1, std::memory_order_relaxed);
+    }
+
+}  // namespace detail
+
+/// @brief Holder of an immutable, atomically replaceable snapshot (RCU-style).
+///
+/// Writers build a complete new @c T and @c Publish it; readers never block
+/// and never wait for writers.  Each reader thread keeps its own reference
+/// to the last snapshot it saw together with the version it was published
+/// under, so the read fast path is a single acquire load of the version
+/// counter and a compare — no reference-count or reader-count traffic on
+/// shared cache lines.  Only when a newer version has been published does a
+/// reader take the slow path and re-acquire the current snapshot.
+///
+/// Each thread keeps a small table of cached snapshots per @c T, indexed by
+/// cell id, so a thread reading several cells of the same @c T (tenants,
+/// validators that consult another configuration) keeps all of them on the
+/// fast path.  An entry is pinned while a @c Read callback runs on it and is
+/// never replaced until the callback returns, so @p fn may freely read other
+/// cells, or the same cell again, without retiring the snapshot it is
+/// looking at; reads that would have to replace a pinned entry acquire a
+/// private reference instead.
+///
+/// A retired snapshot is freed once the writer and every reader thread that
+/// cached it have moved on (or exited).
+///
+/// @tparam T The snapshot type.
+template <typename T>
+class SnapshotCell {
+public:
+    /// @brief Creates a cell holding an initial snapshot.
+    explicit SnapshotCell(std::shared_ptr<const T> initial)
+        : current_(std::move(initial))
+    {
+    }
+
+    ~SnapshotCell() = default;
+
+    SnapshotCell(const SnapshotCell&) = delete;
+    auto operator=(const SnapshotCell&) -> SnapshotCell& = delete;
+    SnapshotCell(SnapshotCell&&) = delete;
+    auto operator=(SnapshotCell&&) -> SnapshotCell& = delete;
+
+    /// @brief Invokes @p fn with the current snapshot on the lock-free fast path.
+    ///
+    /// The snapshot stays alive until @p fn returns, even if @p fn reads
+    /// other cells or a writer publishes in the meantime.
+    template <typename Fn>
+    auto Read(Fn&& fn) const -> decltype(auto)
+    {
+        LocalEntry* entry = LocalSnapshot();
+        if (entry == nullptr) {
+            const auto pinned = current_.load(std::memory_order_acquire);
+            return std::forward<Fn>(fn)(*pinned);
+        }
+        const PinGuard guard(*entry);
+        return std::forward<Fn>(fn)(*entry->snapshot);
+    }
+
+    /// @brief Returns an owning reference to the current snapshot.
+    ///
+    /// Safe to hold for any duration; costs one reference-count increment.
+    [[nodiscard]] auto Acquire() const -> std::shared_ptr<const T>
+    {
+        const LocalEntry* entry = LocalSnapshot();
+        return entry != nullptr ? entry->snapshot : current_.load(std::memory_order_acquire);
+    }
+
+    /// @brief Replaces the current snapshot; subsequent reads observe @p next.
+    ///
+    /// Callers must serialize concurrent writers.
+    void Publish(std::shared_ptr<const T> next)
+    {
+        current_.store(std::move(next), std::memory_order_release);
+        version_.fetch_add(1, std::memory_order_release);
+    }
+
+private:
+    /// @brief Number of cells of one @c T a thread keeps on the fast path.
+    static constexpr std::size_t k_local_entries = 16;
+
+    struct LocalEntry {
+        std::uint64_t cell_id = 0;
+        std::uint64_t version = 0;
+        std::shared_ptr<const T> snapshot;
+        std::uint32_t pins = 0;
+    };
+
+    /// @brief Keeps an entry from being replaced while a @c Read callback uses it.
+    class PinGuard {
+    public:
+        explicit PinGuard(LocalEntry& entry)
+            : entry_(entry)
+        {
+            ++entry_.pins;
+        }
+
+        ~PinGuard() { --entry_.pins; }
+
+        PinGuard(const PinGuard&) = delete;
+        auto operator=(const PinGuard&) -> PinGuard& = delete;
+        PinGuard(PinGuard&&) = delete;
+        auto operator=(PinGuard&&) -> PinGuard& = delete;
+
+    private:
+        LocalEntry& entry_;
+    };
+
+    /// @brief Returns this thread's up-to-date entry for the cell, or
+    ///        @c nullptr when its slot is pinned by an enclosing read.
+    [[nodiscard]] auto LocalSnapshot() const -> LocalEntry*
+    {
+        thread_local std::array<LocalEntry, k_local_entries> entries;
+        LocalEntry& entry = entries[id_ % k_local_entries];
+        const auto version = version_.load(std::memory_order_acquire);
+        if (entry.cell_id == id_ && entry.version == version && entry.snapshot) {
+            return &entry;
+        }
+        if (entry.pins != 0) {
+            return nullptr;
+        }
+        entry.snapshot = current_.load(std::memory_order_acquire);
+        entry.cell_id = id_;
+        entry.version = version;
+        return &entry;
+    }
+
+    const std::uint64_t id_ = detail::NextSnapshotCellId();
+    std::atomic<std::uint64_t> version_ { 0 };
+    std::atomic<std::shared_ptr<const T>> current_;
+};
+
+/// @brief Thread policy for read-mostly multi-threaded usage (RCU-style snapshots).
+///
+/// The configuration state is published as an immutable snapshot through a
+/// @c SnapshotCell.  @c Get never takes a lock and performs no shared
+/// writes, so readers on different cores do not contend with each other.
+/// @c Set and @c Load copy the current snapshot, apply the change to the
+/// copy and publish it; writers are serialized by a plain @c std::mutex.
+///
+/// Prefer this policy when reads vastly outnumber writes (e.g. writes only
+/// on reload).  Each write copies the whole state, so write-heavy workloads
+/// are better served by @c MultiThreadedPolicy.
+///
+/// Usage:
+/// @code
+/// cppfig::Configuration<MySchema, cppfig::ConfSerializer, cppfig::SnapshotPolicy>
+///     config("config.conf");
+/// @endcode
+struct SnapshotPolicy {
+    /// @brief Mutex serializing writers (readers never lock).
+    using mutex_type = std::mutex;
+
+    /// @brief Writer lock.
+    using unique_lock = std::unique_lock<std::mutex>;
+
+    /// @brief Snapshot holder used for the configuration state.
+    template <typename T>
+    using snapshot_type = SnapshotCell<T>;  // NOLINT(readability-identifier-naming)
+};
+
+/// @brief Concept satisfied by thread policies that publish immutable snapshots.
+template <typename P>
+concept IsSnapshotPolicy = requires { typename P::template snapshot_type<int>; };
+
 }  // namespace cppfig
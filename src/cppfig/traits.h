@@ -1,10 +1,16 @@
 #pragma once
 
+#include <algorithm>
+#include <array>
 #include <concepts>
+#include <cstddef>
+#include <cstdint>
 #include <optional>
 #include <string>
 #include <string_view>
 #include <type_traits>
+#include <utility>
+#include <vector>
 
 #include "cppfig/value.h"
 
@@ -215,4 +221,167 @@ struct ConfigTraits<std::string> {
     static auto FromString(std::string_view str) -> std::optional<std::string> { return std::string(str); }
 };
 
+namespace detail {
+
+    /// @brief Serializes the elements of @p values, packing integers and floating-point values contiguously.
+    template <typename T, typename Range>
+    auto SerializeSequence(const Range& values) -> Value
+    {
+        if constexpr (std::is_same_v<T, int> || std::is_same_v<T, std::int64_t>) {
+            return Value::Array(Value::IntegerArrayType(values.begin(), values.end()));
+        }
+        else if constexpr (std::is_same_v<T, double> || std::is_same_v<T, float>) {
+            return Value::Array(Value::DoubleArrayType(values.begin(), values.end()));
+        }
+        else {
+            Value::ArrayType elements;
+            elements.reserve(values.size());
+            for (const auto& element : values) {
+                elements.push_back(ConfigTraits<T>::Serialize(element));
+            }
+            return Value::Array(std::move(elements));
+        }
+    }
+
+    /// @brief Deserializes every element of the array @p value into @p out.
+    ///
+    /// Contiguous integer arrays are converted in bulk to @c int and
+    /// @c std::int64_t elements, contiguous double arrays to @c float and @c double.
+    /// Returns false if @p value is not an array or any element fails to deserialize.
+    template <typename T>
+    auto DeserializeSequence(const Value& value, std::vector<T>& out) -> bool
+    {
+        if (!value.IsArray()) {
+            return false;
+        }
+        out.clear();
+        if constexpr (std::is_same_v<T, std::int64_t> || std::is_same_v<T, int>) {
+            if (const auto integers = value.Integers(); integers.size() == value.Size()) {
+                out.resize(integers.size());
+                std::ranges::transform(integers, out.begin(), [](std::int64_t element) { return static_cast<T>(element); });
+                return true;
+            }
+        }
+        else if constexpr (std::is_same_v<T, double> || std::is_same_v<T, float>) {
+            if (const auto doubles = value.Doubles(); doubles.size() == value.Size()) {
+                out.resize(doubles.size());
+                std::ranges::transform(doubles, out.begin(), [](double element) { return static_cast<T>(element); });
+                return true;
+            }
+        }
+        out.reserve(value.Size());
+        bool ok = true;
+        value.ForEachElement([&out, &ok](const Value& element) {
+            if (!ok) {
+                return;
+            }
+            auto result = ConfigTraits<T>::Deserialize(element);
+            if (!result.has_value()) {
+                ok = false;
+                return;
+            }
+            out.push_back(std::move(*result));
+        });
+        return ok;
+    }
+
+    /// @brief Parses a list from a string: a list literal ("[a, b]") or bare comma-separated elements ("a, b").
+    ///
+    /// Quoted elements are decoded with @c UnquoteListElement before they are
+    /// parsed with @c ConfigTraits<T>::FromString.
+    template <typename T>
+    auto SequenceFromString(std::string_view str, std::vector<T>& out) -> bool
+    {
+        std::string bracketed;
+        if (str.empty() || str.front() != '[') {
+            bracketed.reserve(str.size() + 2);
+            bracketed.push_back('[');
+            bracketed.append(str);
+            bracketed.push_back(']');
+            str = bracketed;
+        }
+        out.clear();
+        bool ok = true;
+        const bool balanced = ForEachListElement(str, [&out, &ok](std::string_view element) {
+            if (!ok) {
+                return;
+            }
+            auto result = ConfigTraits<T>::FromString(UnquoteListElement(element));
+            if (!result.has_value()) {
+                ok = false;
+                return;
+            }
+            out.push_back(std::move(*result));
+        });
+        return balanced && ok;
+    }
+
+}  // namespace detail
+
+/// @brief Lists of any configurable type, stored as Value arrays.
+///
+/// Lists of @c int, @c std::int64_t, @c float and @c double are stored as
+/// contiguous arrays, so serializing and deserializing them is a bulk copy.
+template <Configurable T>
+struct ConfigTraits<std::vector<T>> {
+    static auto Serialize(const std::vector<T>& value) -> Value { return detail::SerializeSequence<T>(value); }
+
+    static auto Deserialize(const Value& value) -> std::optional<std::vector<T>>
+    {
+        std::vector<T> result;
+        if (!detail::DeserializeSequence(value, result)) {
+            return std::nullopt;
+        }
+        return result;
+    }
+
+    static auto ToString(const std::vector<T>& value) -> std::string { return Serialize(value).Dump(); }
+
+    static auto FromString(std::string_view str) -> std::optional<std::vector<T>>
+    {
+        std::vector<T> result;
+        if (!detail::SequenceFromString(str, result)) {
+            return std::nullopt;
+        }
+        return result;
+    }
+};
+
+/// @brief Fixed-size lists; deserialization requires exactly @p N elements.
+template <Configurable T, std::size_t N>
+struct ConfigTraits<std::array<T, N>> {
+    static auto Serialize(const std::array<T, N>& value) -> Value { return detail::SerializeSequence<T>(value); }
+
+    static auto Deserialize(const Value& value) -> std::optional<std::array<T, N>>
+    {
+        std::vector<T> elements;
+        if (!detail::DeserializeSequence(value, elements)) {
+            return std::nullopt;
+        }
+        return FromElements(std::move(elements));
+    }
+
+    static auto ToString(const std::array<T, N>& value) -> std::string { return Serialize(value).Dump(); }
+
+    static auto FromString(std::string_view str) -> std::optional<std::array<T, N>>
+    {
+        std::vector<T> elements;
+        if (!detail::SequenceFromString(str, elements)) {
+            return std::nullopt;
+        }
+        return FromElements(std::move(elements));
+    }
+
+private:
+    static auto FromElements(std::vector<T> elements) -> std::optional<std::array<T, N>>
+    {
+        if (elements.size() != N) {
+            return std::nullopt;
+        }
+        std::array<T, N> result {};
+        std::move(elements.begin(), elements.end(), result.begin());
+        return result;
+    }
+};
+
 }  // namespace cppfig
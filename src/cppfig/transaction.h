@@ -0,0 +1,100 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <tuple>
+#include <utility>
+
+#include "cppfig/setting.h"
+#include "cppfig/slots.h"
+#include "cppfig/status.h"
+
+namespace cppfig {
+
+/// @brief Batch of setting updates applied to a configuration all at once.
+///
+/// Values are staged with @c Set and applied by @c Commit, which validates
+/// every staged value before taking any lock, then applies the whole batch
+/// under a single exclusive lock acquisition.  Readers see either none or
+/// all of the updates; the batch bumps the generation once and notifies
+/// each changed setting's subscribers once.  If any value fails validation,
+/// nothing is applied.
+///
+/// Usage:
+/// @code
+/// auto status = config.Transaction()
+///                   .Set<settings::ServerHost>("example.com")
+///                   .Set<settings::ServerPort>(8443)
+///                   .Commit();
+/// @endcode
+///
+/// Staging the same setting twice keeps the last value.  A transaction is
+/// not synchronized and must not outlive its configuration.
+///
+/// @tparam Config The configuration type the transaction applies to.
+template <typename Config>
+class Transaction {
+public:
+    using schema_type = typename Config::schema_type;
+
+    /// @brief Creates an empty transaction on @p config.
+    explicit Transaction(Config& config)
+        : config_(&config)
+    {
+    }
+
+    /// @brief Stages a new value for setting S.
+    template <IsSetting S>
+        requires(schema_type::template has_setting<S>)
+    auto Set(typename S::value_type value) -> Transaction&
+    {
+        auto& slot = std::get<schema_type::template index_of<S>>(values_);
+        if (!slot.has_value()) {
+            ++staged_;
+        }
+        slot = std::move(value);
+        return *this;
+    }
+
+    /// @brief Returns whether no value is staged.
+    [[nodiscard]] auto Empty() const -> bool { return staged_ == 0; }
+
+    /// @brief Validates and applies all staged values; the transaction is empty afterwards.
+    ///
+    /// Returns the first validation error (prefixed with the setting path)
+    /// and applies nothing in that case; the staged values are kept.
+    /// Committing an empty transaction is a no-op.
+    [[nodiscard]] auto Commit() -> Status
+    {
+        if (staged_ == 0) {
+            return OkStatus();
+        }
+
+        Status status = OkStatus();
+        schema_type::ForEachSetting([this, &status]<typename S>() {
+            const auto& value = std::get<schema_type::template index_of<S>>(values_);
+            if (!status.ok() || !value.has_value()) {
+                return;
+            }
+            auto validation = GetSettingValidator<S>()(*value);
+            if (!validation) {
+                status = InvalidArgumentError(std::string(S::path) + ": " + validation.error_message);
+            }
+        });
+        if (!status.ok()) {
+            return status;
+        }
+
+        config_->ApplyTransaction(values_);
+        values_ = {};
+        staged_ = 0;
+        return OkStatus();
+    }
+
+private:
+    Config* config_;
+    typename detail::OptionalTuple<typename schema_type::value_tuple>::type values_;
+    std::size_t staged_ = 0;
+};
+
+}  // namespace cppfig
@@ -1,9 +1,11 @@
 #pragma once
 
 #include <concepts>
+#include <cstddef>
 #include <functional>
 #include <string>
 #include <type_traits>
+#include <utility>
 #include <vector>
 
 namespace cppfig {
@@ -14,7 +16,7 @@ struct ValidationResult {
     std::string error_message;
 
     /// @brief Creates a successful validation result.
-    static auto Ok() -> ValidationResult { return { .is_valid = true, .error_message = "" }; }
+    static auto Ok() -> ValidationResult { return { .is_valid = true, .error_message = {} }; }
 
     /// @brief Creates a failed validation result with an error message.
     static auto Error(std::string message) -> ValidationResult { return { .is_valid = false, .error_message = std::move(message) }; }
@@ -28,10 +30,146 @@ concept ValidatorFor = requires(const V& validator, const T& value) {
     { validator(value) } -> std::same_as<ValidationResult>;
 };
 
+template <typename Derived, typename T>
+class ValidatorExpression;
+
+/// @brief Concept for the concrete validator types that support @c && and @c || composition.
+template <typename V>
+concept ComposableValidator = requires { typename V::value_type; }
+    && std::derived_from<V, ValidatorExpression<V, typename V::value_type>>;
+
+template <typename Lhs, typename Rhs>
+class AndValidator;
+
+template <typename Lhs, typename Rhs>
+class OrValidator;
+
+/// @brief Base of the concrete validator types, providing composition and result construction.
+///
+/// The built-in validators (@c Min, @c Range, @c NotEmpty, ...) return
+/// distinct concrete types rather than a type-erased @c Validator, so that a
+/// composition such as `Range(1, 65535) && Positive<int>()` is a plain
+/// struct whose checks inline into the caller.  A derived type provides:
+///
+/// - `IsValid(value) -> bool`: the check itself, which must not allocate;
+/// - `ErrorMessage(value) -> std::string`: called only when the check fails.
+///
+/// @tparam Derived The concrete validator type (CRTP).
+/// @tparam T The validated value type.
+template <typename Derived, typename T>
+class ValidatorExpression {
+public:
+    using value_type = T;
+
+    /// @brief Validates a value, formatting the error message only on failure.
+    auto operator()(const T& value) const -> ValidationResult
+    {
+        const auto& self = static_cast<const Derived&>(*this);
+        if (self.IsValid(value)) {
+            return ValidationResult::Ok();
+        }
+        return ValidationResult::Error(self.ErrorMessage(value));
+    }
+
+    /// @brief Combines this validator with another (both must pass).
+    template <ComposableValidator Other>
+    [[nodiscard]] auto And(Other other) const -> AndValidator<Derived, Other>
+    {
+        return { static_cast<const Derived&>(*this), std::move(other) };
+    }
+
+    /// @brief Combines this validator with another (either must pass).
+    template <ComposableValidator Other>
+    [[nodiscard]] auto Or(Other other) const -> OrValidator<Derived, Other>
+    {
+        return { static_cast<const Derived&>(*this), std::move(other) };
+    }
+};
+
+/// @brief Validator that passes when both operands pass; reports the first failure.
+template <typename Lhs, typename Rhs>
+class AndValidator : public ValidatorExpression<AndValidator<Lhs, Rhs>, typename Lhs::value_type> {
+    static_assert(std::same_as<typename Lhs::value_type, typename Rhs::value_type>, "combined validators must validate the same type");
+
+public:
+    using value_type = typename Lhs::value_type;
+
+    AndValidator(Lhs lhs, Rhs rhs)
+        : lhs_(std::move(lhs))
+        , rhs_(std::move(rhs))
+    {
+    }
+
+    [[nodiscard]] auto IsValid(const value_type& value) const -> bool { return lhs_.IsValid(value) && rhs_.IsValid(value); }
+
+    auto operator()(const value_type& value) const -> ValidationResult
+    {
+        // Each side is checked once; a passing result carries an empty message and does not allocate
+        auto result = lhs_(value);
+        if (!result) {
+            return result;
+        }
+        return rhs_(value);
+    }
+
+private:
+    [[no_unique_address]] Lhs lhs_;
+    [[no_unique_address]] Rhs rhs_;
+};
+
+/// @brief Validator that passes when either operand passes; reports the second operand's failure.
+template <typename Lhs, typename Rhs>
+class OrValidator : public ValidatorExpression<OrValidator<Lhs, Rhs>, typename Lhs::value_type> {
+    static_assert(std::same_as<typename Lhs::value_type, typename Rhs::value_type>, "combined validators must validate the same type");
+
+public:
+    using value_type = typename Lhs::value_type;
+
+    OrValidator(Lhs lhs, Rhs rhs)
+        : lhs_(std::move(lhs))
+        , rhs_(std::move(rhs))
+    {
+    }
+
+    [[nodiscard]] auto IsValid(const value_type& value) const -> bool { return lhs_.IsValid(value) || rhs_.IsValid(value); }
+
+    auto operator()(const value_type& value) const -> ValidationResult
+    {
+        if (lhs_.IsValid(value)) {
+            return ValidationResult::Ok();
+        }
+        return rhs_(value);
+    }
+
+private:
+    [[no_unique_address]] Lhs lhs_;
+    [[no_unique_address]] Rhs rhs_;
+};
+
+/// @brief Combines two validators (both must pass); equivalent to `lhs.And(rhs)`.
+template <ComposableValidator Lhs, ComposableValidator Rhs>
+auto operator&&(Lhs lhs, Rhs rhs) -> AndValidator<Lhs, Rhs>
+{
+    return { std::move(lhs), std::move(rhs) };
+}
+
+/// @brief Combines two validators (either must pass); equivalent to `lhs.Or(rhs)`.
+template <ComposableValidator Lhs, ComposableValidator Rhs>
+auto operator||(Lhs lhs, Rhs rhs) -> OrValidator<Lhs, Rhs>
+{
+    return { std::move(lhs), std::move(rhs) };
+}
+
 /// @brief Type-erased validator that can hold any validation function.
+///
+/// Every concrete validator converts to it implicitly, so a setting may
+/// declare `validator() -> Validator<T>` to hide the composed type.  Calls
+/// go through a @c std::function; prefer returning the concrete type
+/// (`static auto validator()`) on hot paths.
 template <typename T>
-class Validator {
+class Validator : public ValidatorExpression<Validator<T>, T> {
 public:
+    using value_type = T;
     using validator_fn = std::function<ValidationResult(const T&)>;
 
     /// @brief Creates an always-valid validator.
@@ -46,166 +184,258 @@ public:
     {
     }
 
+    /// @brief Type-erases a concrete validator.
+    template <ComposableValidator V>
+        requires(!std::same_as<V, Validator> && ValidatorFor<V, T>)
+    Validator(V validator)  // NOLINT(google-explicit-constructor)
+        : fn_(std::move(validator))
+    {
+    }
+
+    [[nodiscard]] auto IsValid(const T& value) const -> bool { return fn_(value).is_valid; }
+
     /// @brief Validates a value.
     auto operator()(const T& value) const -> ValidationResult { return fn_(value); }
 
-    /// @brief Combines this validator with another (both must pass).
-    [[nodiscard]] auto And(Validator<T> other) const -> Validator<T>
-    {
-        auto this_fn = fn_;
-        auto other_fn = other.fn_;
-        return Validator<T>([this_fn, other_fn](const T& value) -> ValidationResult {
-            auto result = this_fn(value);
-            if (!result) {
-                return result;
-            }
-            return other_fn(value);
-        });
+private:
+    validator_fn fn_;
+};
+
+/// @brief Checks that a numeric value is at least a minimum; see @c Min.
+template <typename T>
+class MinValidator : public ValidatorExpression<MinValidator<T>, T> {
+public:
+    explicit MinValidator(T min_value)
+        : min_value_(min_value)
+    {
     }
 
-    /// @brief Combines this validator with another (either must pass).
-    [[nodiscard]] auto Or(Validator<T> other) const -> Validator<T>
-    {
-        auto this_fn = fn_;
-        auto other_fn = other.fn_;
-        return Validator<T>([this_fn, other_fn](const T& value) -> ValidationResult {
-            auto result = this_fn(value);
-            if (result) {
-                return result;
+    [[nodiscard]] auto IsValid(const T& value) const -> bool { return !(value < min_value_); }
+
+    [[nodiscard]] auto ErrorMessage(const T& value) const -> std::string
+    {
+        return "Value " + std::to_string(value) + " is less than minimum " + std::to_string(min_value_);
+    }
+
+private:
+    T min_value_;
+};
+
+/// @brief Checks that a numeric value is at most a maximum; see @c Max.
+template <typename T>
+class MaxValidator : public ValidatorExpression<MaxValidator<T>, T> {
+public:
+    explicit MaxValidator(T max_value)
+        : max_value_(max_value)
+    {
+    }
+
+    [[nodiscard]] auto IsValid(const T& value) const -> bool { return !(value > max_value_); }
+
+    [[nodiscard]] auto ErrorMessage(const T& value) const -> std::string
+    {
+        return "Value " + std::to_string(value) + " exceeds maximum " + std::to_string(max_value_);
+    }
+
+private:
+    T max_value_;
+};
+
+/// @brief Checks that a numeric value is positive; see @c Positive.
+template <typename T>
+class PositiveValidator : public ValidatorExpression<PositiveValidator<T>, T> {
+public:
+    [[nodiscard]] auto IsValid(const T& value) const -> bool { return value > T { 0 }; }
+
+    [[nodiscard]] auto ErrorMessage(const T& /*value*/) const -> std::string { return "Value must be positive"; }
+};
+
+/// @brief Checks that a numeric value is non-negative; see @c NonNegative.
+template <typename T>
+class NonNegativeValidator : public ValidatorExpression<NonNegativeValidator<T>, T> {
+public:
+    [[nodiscard]] auto IsValid(const T& value) const -> bool { return !(value < T { 0 }); }
+
+    [[nodiscard]] auto ErrorMessage(const T& /*value*/) const -> std::string { return "Value must be non-negative"; }
+};
+
+/// @brief Checks that a string is not empty; see @c NotEmpty.
+class NotEmptyValidator : public ValidatorExpression<NotEmptyValidator, std::string> {
+public:
+    [[nodiscard]] auto IsValid(const std::string& value) const -> bool { return !value.empty(); }
+
+    [[nodiscard]] auto ErrorMessage(const std::string& /*value*/) const -> std::string { return "Value must not be empty"; }
+};
+
+/// @brief Checks that a string length is at most a maximum; see @c MaxLength.
+class MaxLengthValidator : public ValidatorExpression<MaxLengthValidator, std::string> {
+public:
+    explicit MaxLengthValidator(std::size_t max_len)
+        : max_len_(max_len)
+    {
+    }
+
+    [[nodiscard]] auto IsValid(const std::string& value) const -> bool { return value.size() <= max_len_; }
+
+    [[nodiscard]] auto ErrorMessage(const std::string& value) const -> std::string
+    {
+        return "String length " + std::to_string(value.size()) + " exceeds maximum " + std::to_string(max_len_);
+    }
+
+private:
+    std::size_t max_len_;
+};
+
+/// @brief Checks that a string length is at least a minimum; see @c MinLength.
+class MinLengthValidator : public ValidatorExpression<MinLengthValidator, std::string> {
+public:
+    explicit MinLengthValidator(std::size_t min_len)
+        : min_len_(min_len)
+    {
+    }
+
+    [[nodiscard]] auto IsValid(const std::string& value) const -> bool { return value.size() >= min_len_; }
+
+    [[nodiscard]] auto ErrorMessage(const std::string& value) const -> std::string
+    {
+        return "String length " + std::to_string(value.size()) + " is less than minimum " + std::to_string(min_len_);
+    }
+
+private:
+    std::size_t min_len_;
+};
+
+/// @brief Checks that a value is one of a fixed list; see @c OneOf.
+template <typename T>
+class OneOfValidator : public ValidatorExpression<OneOfValidator<T>, T> {
+public:
+    explicit OneOfValidator(std::vector<T> allowed_values)
+        : allowed_(std::move(allowed_values))
+    {
+    }
+
+    [[nodiscard]] auto IsValid(const T& value) const -> bool
+    {
+        for (const auto& allowed_value : allowed_) {
+            if (value == allowed_value) {
+                return true;
             }
-            return other_fn(value);
-        });
+        }
+        return false;
     }
 
+    [[nodiscard]] auto ErrorMessage(const T& /*value*/) const -> std::string { return "Value is not in the list of allowed values"; }
+
 private:
-    validator_fn fn_;
+    std::vector<T> allowed_;
+};
+
+/// @brief Checks a value against a predicate; see @c Predicate.
+template <typename T, typename Pred>
+class PredicateValidator : public ValidatorExpression<PredicateValidator<T, Pred>, T> {
+public:
+    PredicateValidator(Pred pred, std::string error_message)
+        : pred_(std::move(pred))
+        , error_message_(std::move(error_message))
+    {
+    }
+
+    [[nodiscard]] auto IsValid(const T& value) const -> bool { return static_cast<bool>(pred_(value)); }
+
+    [[nodiscard]] auto ErrorMessage(const T& /*value*/) const -> std::string { return error_message_; }
+
+private:
+    [[no_unique_address]] Pred pred_;
+    std::string error_message_;
+};
+
+/// @brief Accepts every value; see @c AlwaysValid.
+template <typename T>
+class AlwaysValidValidator : public ValidatorExpression<AlwaysValidValidator<T>, T> {
+public:
+    [[nodiscard]] auto IsValid(const T& /*value*/) const -> bool { return true; }
+
+    [[nodiscard]] auto ErrorMessage(const T& /*value*/) const -> std::string { return {}; }
 };
 
 /// @brief Creates a validator that checks if a numeric value is at least min.
 template <typename T>
     requires std::is_arithmetic_v<T>
-auto Min(T min_value) -> Validator<T>
+auto Min(T min_value) -> MinValidator<T>
 {
-    return Validator<T>([min_value](const T& value) -> ValidationResult {
-        if (value < min_value) {
-            return ValidationResult::Error("Value " + std::to_string(value) + " is less than minimum " + std::to_string(min_value));
-        }
-        return ValidationResult::Ok();
-    });
+    return MinValidator<T>(min_value);
 }
 
 /// @brief Creates a validator that checks if a numeric value is at most max.
 template <typename T>
     requires std::is_arithmetic_v<T>
-auto Max(T max_value) -> Validator<T>
+auto Max(T max_value) -> MaxValidator<T>
 {
-    return Validator<T>([max_value](const T& value) -> ValidationResult {
-        if (value > max_value) {
-            return ValidationResult::Error("Value " + std::to_string(value) + " exceeds maximum " + std::to_string(max_value));
-        }
-        return ValidationResult::Ok();
-    });
+    return MaxValidator<T>(max_value);
 }
 
 /// @brief Creates a validator that checks if a numeric value is within [min, max].
 template <typename T>
     requires std::is_arithmetic_v<T>
-auto Range(T min_value, T max_value) -> Validator<T>
+auto Range(T min_value, T max_value) -> AndValidator<MinValidator<T>, MaxValidator<T>>
 {
-    return Min(min_value).And(Max(max_value));
+    return Min(min_value) && Max(max_value);
 }
 
 /// @brief Creates a validator that checks if a numeric value is positive.
 template <typename T>
     requires std::is_arithmetic_v<T>
-auto Positive() -> Validator<T>
+auto Positive() -> PositiveValidator<T>
 {
-    return Validator<T>([](const T& value) -> ValidationResult {
-        if (value <= T { 0 }) {
-            return ValidationResult::Error("Value must be positive");
-        }
-        return ValidationResult::Ok();
-    });
+    return {};
 }
 
 /// @brief Creates a validator that checks if a numeric value is non-negative.
 template <typename T>
     requires std::is_arithmetic_v<T>
-auto NonNegative() -> Validator<T>
+auto NonNegative() -> NonNegativeValidator<T>
 {
-    return Validator<T>([](const T& value) -> ValidationResult {
-        if (value < T { 0 }) {
-            return ValidationResult::Error("Value must be non-negative");
-        }
-        return ValidationResult::Ok();
-    });
+    return {};
 }
 
 /// @brief Creates a validator that checks if a string is not empty.
-inline auto NotEmpty() -> Validator<std::string>
+inline auto NotEmpty() -> NotEmptyValidator
 {
-    return Validator<std::string>([](const std::string& value) -> ValidationResult {
-        if (value.empty()) {
-            return ValidationResult::Error("Value must not be empty");
-        }
-        return ValidationResult::Ok();
-    });
+    return {};
 }
 
 /// @brief Creates a validator that checks if a string length is at most max.
-inline auto MaxLength(std::size_t max_len) -> Validator<std::string>
+inline auto MaxLength(std::size_t max_len) -> MaxLengthValidator
 {
-    return Validator<std::string>([max_len](const std::string& value) -> ValidationResult {
-        if (value.size() > max_len) {
-            return ValidationResult::Error("String length " + std::to_string(value.size()) + " exceeds maximum " + std::to_string(max_len));
-        }
-        return ValidationResult::Ok();
-    });
+    return MaxLengthValidator(max_len);
 }
 
 /// @brief Creates a validator that checks if a string length is at least min.
-inline auto MinLength(std::size_t min_len) -> Validator<std::string>
+inline auto MinLength(std::size_t min_len) -> MinLengthValidator
 {
-    return Validator<std::string>([min_len](const std::string& value) -> ValidationResult {
-        if (value.size() < min_len) {
-            return ValidationResult::Error("String length " + std::to_string(value.size()) + " is less than minimum " + std::to_string(min_len));
-        }
-        return ValidationResult::Ok();
-    });
+    return MinLengthValidator(min_len);
 }
 
 /// @brief Creates a validator that checks if a value is one of the allowed values.
 template <typename T>
-auto OneOf(std::vector<T> allowed_values) -> Validator<T>
+auto OneOf(std::vector<T> allowed_values) -> OneOfValidator<T>
 {
-    return Validator<T>([allowed = std::move(allowed_values)](const T& value) -> ValidationResult {
-        for (const auto& allowed_value : allowed) {
-            if (value == allowed_value) {
-                return ValidationResult::Ok();
-            }
-        }
-        return ValidationResult::Error("Value is not in the list of allowed values");
-    });
+    return OneOfValidator<T>(std::move(allowed_values));
 }
 
 /// @brief Creates a validator from a predicate function.
 template <typename T, typename Pred>
     requires std::predicate<Pred, const T&>
-auto Predicate(Pred pred, std::string error_message) -> Validator<T>
+auto Predicate(Pred pred, std::string error_message) -> PredicateValidator<T, Pred>
 {
-    return Validator<T>([p = std::move(pred), msg = std::move(error_message)](const T& value) -> ValidationResult {
-        if (!p(value)) {
-            return ValidationResult::Error(msg);
-        }
-        return ValidationResult::Ok();
-    });
+    return { std::move(pred), std::move(error_message) };
 }
 
 /// @brief Creates an always-valid validator.
 template <typename T>
-auto AlwaysValid() -> Validator<T>
+auto AlwaysValid() -> AlwaysValidValidator<T>
 {
-    return Validator<T>();
+    return {};
 }
 
 }  // namespace cppfig
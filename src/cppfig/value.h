@@ -1,38 +1,261 @@
 #pragma once
 
+#include <array>
+#include <atomic>
+#include <bit>
+#include <charconv>
+#include <cmath>
+#include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <map>
 #include <memory>
-#include <sstream>
+#include <span>
 #include <string>
 #include <string_view>
 #include <type_traits>
 #include <variant>
 #include <vector>
 
+#include "cppfig/flat_map.h"
 #include "cppfig/status.h"
 
 namespace cppfig {
 
+namespace detail {
+
+    inline constexpr std::uint64_t kHashMultiplier = 0x9e3779b97f4a7c15ULL;
+
+    /// @brief Bijective 64-bit finalizer (splitmix64) spreading every input bit over the output.
+    [[nodiscard]] inline auto HashMix(std::uint64_t value) -> std::uint64_t
+    {
+        value ^= value >> 30U;
+        value *= 0xbf58476d1ce4e5b9ULL;
+        value ^= value >> 27U;
+        value *= 0x94d049bb133111ebULL;
+        value ^= value >> 31U;
+        return value;
+    }
+
+    /// @brief Hashes @p bytes eight at a time, seeded with @p seed.
+    [[nodiscard]] inline auto HashBytes(std::string_view bytes, std::uint64_t seed) -> std::uint64_t
+    {
+        std::uint64_t hash = seed ^ (bytes.size() * kHashMultiplier);
+        std::size_t offset = 0;
+        for (; offset + sizeof(std::uint64_t) <= bytes.size(); offset += sizeof(std::uint64_t)) {
+            std::uint64_t chunk = 0;
+            std::memcpy(&chunk, bytes.data() + offset, sizeof(chunk));
+            hash = HashMix(hash ^ chunk);
+        }
+        if (offset < bytes.size()) {
+            // Assembled bytewise: a variable-length memcpy would be a library call
+            std::uint64_t chunk = 0;
+            for (std::size_t i = offset; i < bytes.size(); ++i) {
+                chunk = (chunk << 8U) | static_cast<unsigned char>(bytes[i]);
+            }
+            hash = HashMix(hash ^ chunk);
+        }
+        return HashMix(hash);
+    }
+
+    /// @brief Appends the decimal digits of @p value.
+    inline void AppendInteger(std::string& out, std::int64_t value)
+    {
+        std::array<char, 24> buffer {};
+        const auto result = std::to_chars(buffer.data(), buffer.data() + buffer.size(), value);
+        out.append(buffer.data(), result.ptr);
+    }
+
+    /// @brief Appends the shortest representation of @p value that parses back to it.
+    ///
+    /// Finite integral values keep a trailing ".0" so they stay doubles.
+    inline void AppendDouble(std::string& out, double value)
+    {
+        std::array<char, 32> buffer {};
+        const auto result = std::to_chars(buffer.data(), buffer.data() + buffer.size(), value);
+        const std::string_view text(buffer.data(), static_cast<std::size_t>(result.ptr - buffer.data()));
+        out.append(text);
+        if (std::isfinite(value) && text.find_first_of(".e") == std::string_view::npos) {
+            out.append(".0");
+        }
+    }
+
+    /// @brief Invokes @p fn with each top-level element of the list literal @p text (e.g. "[a, "b,c", [1, 2]]").
+    ///
+    /// Elements are separated by commas and passed trimmed of spaces and tabs.
+    /// Commas inside double-quoted elements or nested brackets do not
+    /// separate; inside quotes a backslash escapes the next character.
+    /// Quoted elements are passed through as written, for the caller to
+    /// decode with @c UnquoteListElement.  An empty list ("[]") has no
+    /// elements.
+    ///
+    /// @return false (without calling @p fn) when @p text is not enclosed in
+    ///         brackets or its quotes and brackets are unbalanced.
+    template <typename Fn>
+    auto ForEachListElement(std::string_view text, Fn&& fn) -> bool
+    {
+        constexpr std::string_view k_spaces = " \t";
+        if (text.size() < 2 || text.front() != '[' || text.back() != ']') {
+            return false;
+        }
+        const auto inner = text.substr(1, text.size() - 2);
+
+        // Validate first, so that fn only sees complete lists
+        int depth = 0;
+        bool quoted = false;
+        for (std::size_t i = 0; i < inner.size(); ++i) {
+            const char c = inner[i];
+            if (quoted && c == '\\') {
+                ++i;
+            }
+            else if (c == '"') {
+                quoted = !quoted;
+            }
+            else if (!quoted && c == '[') {
+                ++depth;
+            }
+            else if (!quoted && c == ']' && --depth < 0) {
+                return false;
+            }
+        }
+        if (quoted || depth != 0) {
+            return false;
+        }
+        if (inner.find_first_not_of(k_spaces) == std::string_view::npos) {
+            return true;
+        }
+
+        const auto emit = [&fn, k_spaces](std::string_view element) {
+            const auto begin = element.find_first_not_of(k_spaces);
+            if (begin == std::string_view::npos) {
+                fn(std::string_view());
+                return;
+            }
+            fn(element.substr(begin, element.find_last_not_of(k_spaces) - begin + 1));
+        };
+        std::size_t begin = 0;
+        for (std::size_t i = 0; i < inner.size(); ++i) {
+            const char c = inner[i];
+            if (quoted && c == '\\') {
+                ++i;
+            }
+            else if (c == '"') {
+                quoted = !quoted;
+            }
+            else if (!quoted && c == '[') {
+                ++depth;
+            }
+            else if (!quoted && c == ']') {
+                --depth;
+            }
+            else if (!quoted && depth == 0 && c == ',') {
+                emit(inner.substr(begin, i - begin));
+                begin = i + 1;
+            }
+        }
+        emit(inner.substr(begin));
+        return true;
+    }
+
+    /// @brief Checks whether a list element passed by @c ForEachListElement is double-quoted.
+    constexpr auto IsQuotedListElement(std::string_view element) -> bool
+    {
+        return element.size() >= 2 && element.front() == '"' && element.back() == '"';
+    }
+
+    /// @brief Decodes a list element: strips its quotes and resolves the \" and \\ escapes.
+    ///
+    /// Unquoted elements are returned unchanged, and a backslash before any
+    /// other character is kept.
+    inline auto UnquoteListElement(std::string_view element) -> std::string
+    {
+        if (!IsQuotedListElement(element)) {
+            return std::string(element);
+        }
+        element = element.substr(1, element.size() - 2);
+        std::string result;
+        result.reserve(element.size());
+        for (std::size_t i = 0; i < element.size(); ++i) {
+            if (element[i] == '\\' && i + 1 < element.size() && (element[i + 1] == '"' || element[i + 1] == '\\')) {
+                ++i;
+            }
+            result.push_back(element[i]);
+        }
+        return result;
+    }
+
+    /// @brief Appends @p text as a list element, quoted and escaped unless it reads back verbatim unquoted.
+    inline void AppendListString(std::string& out, std::string_view text)
+    {
+        const bool needs_quoting = text.empty() || text.front() == ' ' || text.back() == ' ' || text.front() == '\t'
+                                   || text.back() == '\t' || text.find_first_of("=#\n\r,[]\"\\") != std::string_view::npos;
+        if (!needs_quoting) {
+            out.append(text);
+            return;
+        }
+        out.push_back('"');
+        for (const char c : text) {
+            if (c == '"' || c == '\\') {
+                out.push_back('\\');
+            }
+            out.push_back(c);
+        }
+        out.push_back('"');
+    }
+
+}  // namespace detail
+
 /// @brief A self-contained, recursive value type for configuration data.
 ///
 /// This type replaces external JSON dependencies in the core library.
 /// It supports: null, bool, int64, double, string, object (map), and array.
 ///
+/// Arrays have one canonical representation per content: a non-empty array
+/// whose elements are all integers (or all doubles) is stored as one
+/// contiguous @c std::int64_t (or @c double) buffer, readable in bulk through
+/// @c Integers() / @c Doubles(); every other array is a vector of Values.
+/// Both representations behave identically through @c Size(), @c At() and
+/// @c ForEachElement().
+///
 /// Objects use `std::map` with transparent comparison for efficient
-/// `std::string_view` lookups.  Recursive containers are heap-allocated
-/// via `std::shared_ptr` to keep the variant's inline size small; a
-/// custom copy constructor ensures full deep-copy (value) semantics.
+/// `std::string_view` lookups; defining @c CPPFIG_FLAT_OBJECTS (CMake
+/// option of the same name) switches them to a sorted @c FlatMap, which
+/// keeps each object's entries in one contiguous buffer.  Pointers into an
+/// object are then invalidated by any insertion into that same object.
+/// Recursive containers are heap-allocated
+/// via `std::shared_ptr` and shared copy-on-write: copying a Value only
+/// bumps reference counts, and a container is cloned the first time it is
+/// mutated while shared.  Mutating a nested value therefore clones just
+/// the path from the root to it; untouched subtrees stay shared.  Value
+/// semantics are preserved — a mutation is never visible through a copy.
+/// References returned by the mutating accessors (@c operator[],
+/// @c Items()) must be re-acquired after the value or one of its ancestors
+/// has been copied; writing through an older reference would reach the
+/// shared node.
+///
+/// Distinct Value objects may be used from different threads even when
+/// they share nodes; a single Value object is not synchronized.
 class Value {
 public:
     /// @brief Ordered map of string keys to Value children.
+#if defined(CPPFIG_FLAT_OBJECTS)
+    using ObjectType = FlatMap<std::string, Value, std::less<>>;
+#else
     using ObjectType = std::map<std::string, Value, std::less<>>;
+#endif
 
     /// @brief Ordered sequence of Value elements.
     using ArrayType = std::vector<Value>;
 
+    /// @brief Contiguous storage of an all-integer array.
+    using IntegerArrayType = std::vector<std::int64_t>;
+
+    /// @brief Contiguous storage of an all-double array.
+    using DoubleArrayType = std::vector<double>;
+
 private:
-    using DataVariant = std::variant<std::nullptr_t, bool, std::int64_t, double, std::string, std::shared_ptr<ObjectType>, std::shared_ptr<ArrayType>>;
+    using DataVariant = std::variant<std::nullptr_t, bool, std::int64_t, double, std::string, std::shared_ptr<ObjectType>,
+                                     std::shared_ptr<ArrayType>, std::shared_ptr<IntegerArrayType>, std::shared_ptr<DoubleArrayType>>;
 
     DataVariant data_;
 
@@ -43,6 +266,8 @@ private:
     static constexpr std::size_t idx_string = 4;
     static constexpr std::size_t idx_object = 5;
     static constexpr std::size_t idx_array = 6;
+    static constexpr std::size_t idx_integer_array = 7;
+    static constexpr std::size_t idx_double_array = 8;
 
 public:
     /// @brief Constructs a null value.
@@ -105,20 +330,11 @@ public:
     {
     }
 
-    /// @brief Deep-copies the value (recursive for objects / arrays).
-    Value(const Value& other)
-        : data_(DeepCopy(other.data_))
-    {
-    }
+    /// @brief Copies the value, sharing objects / arrays until either side mutates them.
+    Value(const Value&) = default;
 
-    /// @brief Deep-copy assignment.
-    auto operator=(const Value& other) -> Value&
-    {
-        if (this != &other) {
-            data_ = DeepCopy(other.data_);
-        }
-        return *this;
-    }
+    /// @brief Copy assignment (shares objects / arrays copy-on-write).
+    auto operator=(const Value&) -> Value& = default;
 
     /// @brief Move constructor (default, transfers ownership).
     Value(Value&&) noexcept = default;
@@ -145,6 +361,60 @@ public:
         return v;
     }
 
+    /// @brief Creates an array of @p elements, packing all-integer or all-double content contiguously.
+    [[nodiscard]] static auto Array(ArrayType elements) -> Value
+    {
+        const auto all_of = [&elements](std::size_t index) {
+            for (const auto& element : elements) {
+                if (element.data_.index() != index) {
+                    return false;
+                }
+            }
+            return !elements.empty();
+        };
+        if (all_of(idx_int)) {
+            IntegerArrayType integers;
+            integers.reserve(elements.size());
+            for (const auto& element : elements) {
+                integers.push_back(std::get<std::int64_t>(element.data_));
+            }
+            return Array(std::move(integers));
+        }
+        if (all_of(idx_double)) {
+            DoubleArrayType doubles;
+            doubles.reserve(elements.size());
+            for (const auto& element : elements) {
+                doubles.push_back(std::get<double>(element.data_));
+            }
+            return Array(std::move(doubles));
+        }
+        Value v;
+        v.data_ = std::make_shared<ArrayType>(std::move(elements));
+        return v;
+    }
+
+    /// @brief Creates an array of integers stored in one contiguous buffer.
+    [[nodiscard]] static auto Array(IntegerArrayType integers) -> Value
+    {
+        if (integers.empty()) {
+            return Array();
+        }
+        Value v;
+        v.data_ = std::make_shared<IntegerArrayType>(std::move(integers));
+        return v;
+    }
+
+    /// @brief Creates an array of doubles stored in one contiguous buffer.
+    [[nodiscard]] static auto Array(DoubleArrayType doubles) -> Value
+    {
+        if (doubles.empty()) {
+            return Array();
+        }
+        Value v;
+        v.data_ = std::make_shared<DoubleArrayType>(std::move(doubles));
+        return v;
+    }
+
     /// @brief Returns true if this value is null.
     [[nodiscard]] auto IsNull() const -> bool { return data_.index() == idx_null; }
 
@@ -167,7 +437,7 @@ public:
     [[nodiscard]] auto IsObject() const -> bool { return data_.index() == idx_object; }
 
     /// @brief Returns true if this value is an array.
-    [[nodiscard]] auto IsArray() const -> bool { return data_.index() == idx_array; }
+    [[nodiscard]] auto IsArray() const -> bool { return KindIndex() == idx_array; }
 
     /// @brief Extracts the stored value as the requested type.
     ///
@@ -206,39 +476,149 @@ public:
         }
     }
 
+    /// @brief Returns a view of the stored string without copying it (requires IsString()).
+    [[nodiscard]] auto AsStringView() const -> std::string_view { return std::get<std::string>(data_); }
+
     /// @brief Checks whether the given key exists in an object value.
-    [[nodiscard]] auto Contains(std::string_view key) const -> bool
+    [[nodiscard]] auto Contains(std::string_view key) const -> bool { return Find(key) != nullptr; }
+
+    /// @brief Returns the child stored under @p key without copying it.
+    ///
+    /// @return A pointer to the child, or nullptr if this value is not an
+    ///         object or has no such key.  The pointer is invalidated by any
+    ///         mutation of this value.
+    [[nodiscard]] auto Find(std::string_view key) const -> const Value*
     {
         if (!IsObject()) {
-            return false;
+            return nullptr;
         }
         const auto& obj = *std::get<std::shared_ptr<ObjectType>>(data_);
-        return obj.find(key) != obj.end();
+        auto iter = obj.find(key);
+        if (iter == obj.end()) {
+            return nullptr;
+        }
+        return &iter->second;
     }
 
     /// @brief Accesses or creates a child by key, promoting null → object.
-    auto operator[](const std::string& key) -> Value&
+    auto operator[](std::string_view key) -> Value&
     {
-        if (!IsObject()) {
-            data_ = std::make_shared<ObjectType>();
+        auto& obj = MutableObject();
+        auto iter = obj.find(key);
+        if (iter == obj.end()) {
+            iter = obj.emplace(std::string(key), Value()).first;
         }
-        auto& obj = *std::get<std::shared_ptr<ObjectType>>(data_);
-        return obj[key];
+        return iter->second;
     }
 
     /// @brief Read-only access to a child by key (returns static null for missing keys).
-    auto operator[](const std::string& key) const -> const Value&
+    auto operator[](std::string_view key) const -> const Value&
     {
         static const Value null_value;
-        if (!IsObject()) {
-            return null_value;
+        const Value* child = Find(key);
+        return child != nullptr ? *child : null_value;
+    }
+
+    /// @brief Returns the number of array elements (0 if this value is not an array).
+    [[nodiscard]] auto Size() const -> std::size_t
+    {
+        if (const auto* integers = std::get_if<std::shared_ptr<IntegerArrayType>>(&data_)) {
+            return (*integers)->size();
         }
-        const auto& obj = *std::get<std::shared_ptr<ObjectType>>(data_);
-        auto iter = obj.find(key);
-        if (iter == obj.end()) {
-            return null_value;
+        if (const auto* doubles = std::get_if<std::shared_ptr<DoubleArrayType>>(&data_)) {
+            return (*doubles)->size();
         }
-        return iter->second;
+        if (const auto* elements = std::get_if<std::shared_ptr<ArrayType>>(&data_)) {
+            return (*elements)->size();
+        }
+        return 0;
+    }
+
+    /// @brief Returns a copy of array element @p index (requires @p index < Size()).
+    [[nodiscard]] auto At(std::size_t index) const -> Value
+    {
+        if (const auto* integers = std::get_if<std::shared_ptr<IntegerArrayType>>(&data_)) {
+            return (**integers)[index];
+        }
+        if (const auto* doubles = std::get_if<std::shared_ptr<DoubleArrayType>>(&data_)) {
+            return (**doubles)[index];
+        }
+        return (*std::get<std::shared_ptr<ArrayType>>(data_))[index];
+    }
+
+    /// @brief Invokes @p fn with each array element in order (nothing if this value is not an array).
+    ///
+    /// Elements of a contiguous array are passed as temporaries.
+    template <typename Fn>
+    void ForEachElement(Fn&& fn) const
+    {
+        if (const auto* integers = std::get_if<std::shared_ptr<IntegerArrayType>>(&data_)) {
+            for (const auto integer : **integers) {
+                fn(Value(integer));
+            }
+        }
+        else if (const auto* doubles = std::get_if<std::shared_ptr<DoubleArrayType>>(&data_)) {
+            for (const auto number : **doubles) {
+                fn(Value(number));
+            }
+        }
+        else if (const auto* elements = std::get_if<std::shared_ptr<ArrayType>>(&data_)) {
+            for (const auto& element : **elements) {
+                fn(element);
+            }
+        }
+    }
+
+    /// @brief Returns the elements of an all-integer array (empty for any other value).
+    [[nodiscard]] auto Integers() const -> std::span<const std::int64_t>
+    {
+        if (const auto* integers = std::get_if<std::shared_ptr<IntegerArrayType>>(&data_)) {
+            return **integers;
+        }
+        return {};
+    }
+
+    /// @brief Returns the elements of an all-double array (empty for any other value).
+    [[nodiscard]] auto Doubles() const -> std::span<const double>
+    {
+        if (const auto* doubles = std::get_if<std::shared_ptr<DoubleArrayType>>(&data_)) {
+            return **doubles;
+        }
+        return {};
+    }
+
+    /// @brief Appends @p element to an array, promoting null and non-arrays to an empty array first.
+    ///
+    /// Keeps the canonical representation: a contiguous array receiving an
+    /// element of another type is converted to a vector of Values.
+    void Append(Value element)
+    {
+        if (!IsArray()) {
+            *this = Array();
+        }
+        if (std::holds_alternative<std::shared_ptr<IntegerArrayType>>(data_) && element.IsInteger()) {
+            MutableBuffer<IntegerArrayType>().push_back(std::get<std::int64_t>(element.data_));
+            return;
+        }
+        if (std::holds_alternative<std::shared_ptr<DoubleArrayType>>(data_) && element.IsDouble()) {
+            MutableBuffer<DoubleArrayType>().push_back(std::get<double>(element.data_));
+            return;
+        }
+        if (Size() == 0 && element.IsInteger()) {
+            *this = Array(IntegerArrayType { std::get<std::int64_t>(element.data_) });
+            return;
+        }
+        if (Size() == 0 && element.IsDouble()) {
+            *this = Array(DoubleArrayType { std::get<double>(element.data_) });
+            return;
+        }
+        if (!std::holds_alternative<std::shared_ptr<ArrayType>>(data_)) {
+            ArrayType elements;
+            elements.reserve(Size() + 1);
+            ForEachElement([&elements](const Value& existing) { elements.push_back(existing); });
+            data_ = std::make_shared<ArrayType>(std::move(elements));
+        }
+        MutableBuffer<ArrayType>().push_back(std::move(element));
     }
 
     /// @brief Returns const reference to the object entries.
@@ -253,61 +633,127 @@ public:
 
     /// @brief Returns mutable reference to the object entries,
     ///        promoting null → object.
-    auto Items() -> ObjectType&
+    auto Items() -> ObjectType& { return MutableObject(); }
+
+    /// @brief Finds a value at a dot-separated path without copying it.
+    ///
+    /// Path segments are sliced out of @p path in place; no allocation is
+    /// performed on either a hit or a miss.  An empty path refers to this value.
+    ///
+    /// @return A pointer to the value, or nullptr if any segment is missing
+    ///         or traverses a non-object.  The pointer is invalidated by any
+    ///         mutation of this value.
+    [[nodiscard]] auto FindAtPath(std::string_view path) const -> const Value*
     {
-        if (!IsObject()) {
-            data_ = std::make_shared<ObjectType>();
-        }
-        return *std::get<std::shared_ptr<ObjectType>>(data_);
+        const Value* current = this;
+        ForEachSegment(path, [&current](std::string_view segment, bool /*is_last*/) {
+            if (current != nullptr) {
+                current = current->Find(segment);
+            }
+        });
+        return current;
     }
 
-    /// @brief Gets a value at a dot-separated path.
+    /// @brief Gets a copy of the value at a dot-separated path.
+    ///
+    /// Prefer @c FindAtPath on hot paths: this overload copies the value
+    /// and builds an error message on a miss.
     [[nodiscard]] auto GetAtPath(std::string_view path) const -> StatusOr<Value>
     {
-        const Value* current = this;
-        std::string path_str(path);
-        std::istringstream stream(path_str);
-        std::string segment;
+        if (const Value* found = FindAtPath(path)) {
+            return *found;
+        }
 
-        while (std::getline(stream, segment, '.')) {
+        // Slow path: locate the failing segment to report it
+        const Value* current = this;
+        std::string_view missing;
+        bool parent_not_object = false;
+        ForEachSegment(path, [&](std::string_view segment, bool /*is_last*/) {
+            if (current == nullptr) {
+                return;
+            }
             if (!current->IsObject()) {
-                return NotFoundError("Path segment '" + segment + "' not found: parent is not an object");
+                parent_not_object = true;
             }
-            if (!current->Contains(segment)) {
-                return NotFoundError("Path segment '" + segment + "' not found");
+            const Value* next = current->Find(segment);
+            if (next == nullptr) {
+                missing = segment;
             }
-            current = &(*current)[segment];
+            current = next;
+        });
+
+        if (parent_not_object) {
+            return NotFoundError("Path segment '" + std::string(missing) + "' not found: parent is not an object");
         }
-        return *current;
+        return NotFoundError("Path segment '" + std::string(missing) + "' not found");
     }
 
     /// @brief Sets a value at a dot-separated path, creating intermediate objects.
+    ///
+    /// Intermediate non-object values are replaced by objects.  An empty
+    /// path is a no-op.
     void SetAtPath(std::string_view path, const Value& value)
     {
-        Value* current = this;
-        std::string path_str(path);
-        std::istringstream stream(path_str);
-        std::string segment;
-        std::vector<std::string> segments;
-
-        while (std::getline(stream, segment, '.')) {
-            segments.push_back(segment);
+        if (path.empty()) {
+            return;
         }
 
-        for (std::size_t i = 0; i < segments.size() - 1; ++i) {
-            if (!current->Contains(segments[i]) || !(*current)[segments[i]].IsObject()) {
-                (*current)[segments[i]] = Value::Object();
+        Value* current = this;
+        ForEachSegment(path, [&current, &value](std::string_view segment, bool is_last) {
+            Value& child = (*current)[segment];
+            if (is_last) {
+                child = value;
             }
-            current = &(*current)[segments[i]];
-        }
+            else if (!child.IsObject()) {
+                child = Value::Object();
+            }
+            current = &child;
+        });
+    }
 
-        if (!segments.empty()) {
-            (*current)[segments.back()] = value;
-        }
+    /// @brief Sets a value at a dot-separated path like @c SetAtPath, keeping @p hash up to date.
+    ///
+    /// @p hash must equal @c Hash() before the call and equals it afterwards.
+    /// Only the nodes on the path and the replaced subtree are hashed, in the
+    /// same single walk that performs the update.
+    void SetAtPath(std::string_view path, const Value& value, std::uint64_t& hash)
+    {
+        std::uint64_t seed = kHashRootSeed;
+        Value* current = this;
+        bool created = false;  // whether `current` did not exist before this call
+        ForEachSegment(path, [&](std::string_view segment, bool is_last) {
+            if (!current->IsObject()) {
+                // Promoted to an object below, dropping whatever it held
+                if (!created) {
+                    hash -= current->SubtreeHash(seed);
+                }
+                hash += ObjectNodeHash(seed);
+                created = true;
+            }
+            auto& obj = current->MutableObject();
+            const std::uint64_t child_seed = detail::HashBytes(segment, seed);
+            auto iter = obj.find(segment);
+            bool child_created = created;
+            if (iter == obj.end()) {
+                iter = obj.emplace(std::string(segment), Value()).first;
+                child_created = true;
+            }
+            Value& child = iter->second;
+            if (is_last) {
+                if (!child_created) {
+                    hash -= child.SubtreeHash(child_seed);
+                }
+                child = value;
+                hash += child.SubtreeHash(child_seed);
+            }
+            current = &child;
+            seed = child_seed;
+            created = child_created;
+        });
     }
 
     /// @brief Checks if a path exists in the data.
-    [[nodiscard]] auto HasPath(std::string_view path) const -> bool { return GetAtPath(path).ok(); }
+    [[nodiscard]] auto HasPath(std::string_view path) const -> bool { return FindAtPath(path) != nullptr; }
 
     /// @brief Deep-merges two object values; overlay takes precedence.
     ///
@@ -321,8 +767,9 @@ public:
 
         Value result = base;
         for (const auto& [key, value] : overlay.Items()) {
-            if (result.Contains(key) && result[key].IsObject() && value.IsObject()) {
-                result[key] = Merge(result[key], value);
+            const Value* existing = result.Find(key);
+            if (existing != nullptr && existing->IsObject() && value.IsObject()) {
+                result[key] = Merge(*existing, value);
             }
             else {
                 result[key] = value;
@@ -336,9 +783,9 @@ public:
     /// @param indent Number of spaces per indentation level (0 = compact).
     [[nodiscard]] auto Dump(int indent = 0) const -> std::string
     {
-        std::ostringstream stream;
-        DumpImpl(stream, indent, 0);
-        return stream.str();
+        std::string out;
+        DumpImpl(out, indent, 0);
+        return out;
     }
 
     /// @brief Value equality (deep comparison for objects/arrays).
@@ -366,10 +813,18 @@ public:
             return Get<std::string>() == other.Get<std::string>();
         }
         if (IsObject()) {
-            return Items() == other.Items();
+            const auto& lhs = std::get<std::shared_ptr<ObjectType>>(data_);
+            const auto& rhs = std::get<std::shared_ptr<ObjectType>>(other.data_);
+            return lhs == rhs || *lhs == *rhs;
         }
-        if (IsArray()) {
-            return *std::get<std::shared_ptr<ArrayType>>(data_) == *std::get<std::shared_ptr<ArrayType>>(other.data_);
+        if (data_.index() == idx_array) {
+            return SameContents<ArrayType>(other);
+        }
+        if (data_.index() == idx_integer_array) {
+            return SameContents<IntegerArrayType>(other);
+        }
+        if (data_.index() == idx_double_array) {
+            return SameContents<DoubleArrayType>(other);
         }
         return false;  // LCOV_EXCL_LINE
     }
@@ -377,121 +832,302 @@ public:
     /// @brief Value inequality.
     auto operator!=(const Value& other) const -> bool { return !(*this == other); }
 
+    /// @brief Returns a 64-bit structural hash of the value.
+    ///
+    /// Equal values hash equal; distinct values collide with probability
+    /// about 2^-64.  The hash is the sum of one contribution per node, each
+    /// keyed by the node's path, which lets the hashing @c SetAtPath overload
+    /// update a known hash without rehashing the rest of the tree.
+    /// Hashes depend on byte order and may change between versions, so they
+    /// must not be persisted.  Cost is linear in the size of the tree.
+    [[nodiscard]] auto Hash() const -> std::uint64_t { return SubtreeHash(kHashRootSeed); }
+
+    /// @brief Checks whether both values are containers sharing the same storage (and thus equal).
+    [[nodiscard]] auto SharesStorageWith(const Value& other) const -> bool
+    {
+        if (IsObject() && other.IsObject()) {
+            return std::get<std::shared_ptr<ObjectType>>(data_) == std::get<std::shared_ptr<ObjectType>>(other.data_);
+        }
+        if (IsArray() && other.IsArray()) {
+            return ArrayStorage() == other.ArrayStorage();
+        }
+        return false;
+    }
+
 private:
-    [[nodiscard]] static auto DeepCopy(const DataVariant& src) -> DataVariant
+    static constexpr std::uint64_t kHashRootSeed = 0x243f6a8885a308d3ULL;
+
+    /// @brief Hash of this node alone (type and scalar payload), keyed by its path seed.
+    [[nodiscard]] auto NodeHash(std::uint64_t seed) const -> std::uint64_t
     {
-        if (auto* obj = std::get_if<std::shared_ptr<ObjectType>>(&src)) {
-            return std::make_shared<ObjectType>(**obj);
+        const std::uint64_t node = TypeHash(seed, KindIndex());
+        if (IsBoolean()) {
+            return detail::HashMix(node ^ static_cast<std::uint64_t>(std::get<bool>(data_)));
+        }
+        if (IsInteger()) {
+            return detail::HashMix(node ^ static_cast<std::uint64_t>(std::get<std::int64_t>(data_)));
+        }
+        if (IsDouble()) {
+            // +0.0 == -0.0, so both must hash alike
+            double number = std::get<double>(data_);
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wfloat-equal"
+            if (number == 0.0) {
+                number = 0.0;
+            }
+#pragma GCC diagnostic pop
+            return detail::HashMix(node ^ std::bit_cast<std::uint64_t>(number));
         }
-        if (auto* arr = std::get_if<std::shared_ptr<ArrayType>>(&src)) {
-            return std::make_shared<ArrayType>(**arr);
+        if (IsString()) {
+            return detail::HashBytes(std::get<std::string>(data_), node);
         }
-        return src;
+        return node;
     }
 
-    static void EscapeString(std::ostringstream& stream, const std::string& str)
+    [[nodiscard]] static auto TypeHash(std::uint64_t seed, std::size_t index) -> std::uint64_t
     {
-        stream << '"';
+        return detail::HashMix(seed ^ ((index + 1) * detail::kHashMultiplier));
+    }
+
+    /// @brief @c NodeHash of an object (which has no payload of its own).
+    [[nodiscard]] static auto ObjectNodeHash(std::uint64_t seed) -> std::uint64_t { return TypeHash(seed, idx_object); }
+
+    /// @brief Sum of the hashes of this node and all its descendants.
+    [[nodiscard]] auto SubtreeHash(std::uint64_t seed) const -> std::uint64_t
+    {
+        std::uint64_t hash = NodeHash(seed);
+        if (IsObject()) {
+            for (const auto& [key, child] : *std::get<std::shared_ptr<ObjectType>>(data_)) {
+                hash += child.SubtreeHash(detail::HashBytes(key, seed));
+            }
+        }
+        else if (IsArray()) {
+            std::size_t i = 0;
+            ForEachElement([&hash, &i, seed](const Value& element) {
+                hash += element.SubtreeHash(detail::HashMix(seed + ((++i) * detail::kHashMultiplier)));
+            });
+        }
+        return hash;
+    }
+
+    /// @brief Variant index with both contiguous array representations reported as @c idx_array.
+    [[nodiscard]] auto KindIndex() const -> std::size_t
+    {
+        const auto index = data_.index();
+        return index == idx_integer_array || index == idx_double_array ? idx_array : index;
+    }
+
+    /// @brief Address of the array storage, whichever representation holds it (requires IsArray()).
+    [[nodiscard]] auto ArrayStorage() const -> const void*
+    {
+        if (const auto* integers = std::get_if<std::shared_ptr<IntegerArrayType>>(&data_)) {
+            return integers->get();
+        }
+        if (const auto* doubles = std::get_if<std::shared_ptr<DoubleArrayType>>(&data_)) {
+            return doubles->get();
+        }
+        return std::get<std::shared_ptr<ArrayType>>(data_).get();
+    }
+
+    /// @brief Compares the array storage @p T of this value and @p other, which must both hold it.
+    template <typename T>
+    [[nodiscard]] auto SameContents(const Value& other) const -> bool
+    {
+        const auto& lhs = std::get<std::shared_ptr<T>>(data_);
+        const auto& rhs = std::get<std::shared_ptr<T>>(other.data_);
+        return lhs == rhs || *lhs == *rhs;
+    }
+
+    /// @brief Returns the array storage @p T held by this value for mutation, cloning it if shared.
+    template <typename T>
+    auto MutableBuffer() -> T&
+    {
+        auto& buffer = std::get<std::shared_ptr<T>>(data_);
+        if (buffer.use_count() > 1) {
+            buffer = std::make_shared<T>(*buffer);
+        }
+        else {
+            // Pairs with the release decrement of the last other owner (see MutableObject)
+            std::atomic_thread_fence(std::memory_order_acquire);
+        }
+        return *buffer;
+    }
+
+    /// @brief Invokes @p fn for each dot-separated segment of @p path.
+    ///
+    /// @p fn receives the segment as a view into @p path and whether it is
+    /// the last segment.  An empty path has no segments.
+    template <typename Fn>
+    static void ForEachSegment(std::string_view path, Fn&& fn)
+    {
+        if (path.empty()) {
+            return;
+        }
+        std::size_t begin = 0;
+        while (true) {
+            auto end = path.find('.', begin);
+            if (end == std::string_view::npos) {
+                fn(path.substr(begin), true);
+                return;
+            }
+            fn(path.substr(begin, end - begin), false);
+            begin = end + 1;
+        }
+    }
+
+    /// @brief Returns this value's object for mutation, promoting non-objects to an empty object.
+    ///
+    /// Clones the object first if another Value shares it (copy-on-write).
+    /// The clone is shallow: children are shared until they are mutated.
+    auto MutableObject() -> ObjectType&
+    {
+        auto* obj = std::get_if<std::shared_ptr<ObjectType>>(&data_);
+        if (obj == nullptr) {
+            data_ = std::make_shared<ObjectType>();
+            return *std::get<std::shared_ptr<ObjectType>>(data_);
+        }
+        if (obj->use_count() > 1) {
+            *obj = std::make_shared<ObjectType>(**obj);
+        }
+        else {
+            // Pairs with the release decrement of the last other owner, so
+            // its reads of the object happen before our writes.
+            std::atomic_thread_fence(std::memory_order_acquire);
+        }
+        return **obj;
+    }
+
+    static void EscapeString(std::string& out, const std::string& str)
+    {
+        out.push_back('"');
         for (char ch : str) {
             switch (ch) {
             case '"':
-                stream << "\\\"";
+                out.append("\\\"");
                 break;
             case '\\':
-                stream << "\\\\";
+                out.append("\\\\");
                 break;
             case '\n':
-                stream << "\\n";
+                out.append("\\n");
                 break;
             case '\r':
-                stream << "\\r";
+                out.append("\\r");
                 break;
             case '\t':
-                stream << "\\t";
+                out.append("\\t");
                 break;
             default:
-                stream << ch;
+                out.push_back(ch);
             }
         }
-        stream << '"';
+        out.push_back('"');
     }
 
-    static void WriteIndent(std::ostringstream& stream, int indent, int depth)
+    static void WriteIndent(std::string& out, int indent, int depth)
     {
         if (indent > 0) {
-            stream << '\n';
-            for (int i = 0; i < indent * depth; ++i) {
-                stream << ' ';
-            }
+            out.push_back('\n');
+            out.append(static_cast<std::size_t>(indent * depth), ' ');
         }
     }
 
-    void DumpImpl(std::ostringstream& stream, int indent, int depth) const
+    void DumpImpl(std::string& out, int indent, int depth) const
     {
         if (IsNull()) {
-            stream << "null";
+            out.append("null");
         }
         else if (IsBoolean()) {
-            stream << (Get<bool>() ? "true" : "false");
+            out.append(Get<bool>() ? "true" : "false");
         }
         else if (IsInteger()) {
-            stream << Get<std::int64_t>();
+            detail::AppendInteger(out, Get<std::int64_t>());
         }
         else if (IsDouble()) {
-            std::ostringstream double_stream;
-            double_stream << Get<double>();
-            auto str = double_stream.str();
-            stream << str;
-            // Ensure there is always a decimal point for clarity
-            if (str.find('.') == std::string::npos && str.find('e') == std::string::npos && str.find('E') == std::string::npos) {
-                stream << ".0";
-            }
+            // Always has a decimal point (or exponent) for clarity
+            detail::AppendDouble(out, Get<double>());
         }
         else if (IsString()) {
-            EscapeString(stream, Get<std::string>());
+            EscapeString(out, Get<std::string>());
         }
         else if (IsObject()) {
             const auto& obj = Items();
-            stream << '{';
+            out.push_back('{');
             bool first = true;
             for (const auto& [key, val] : obj) {
                 if (!first) {
-                    stream << ',';
+                    out.push_back(',');
                 }
                 first = false;
-                WriteIndent(stream, indent, depth + 1);
+                WriteIndent(out, indent, depth + 1);
+                out.push_back('"');
+                out.append(key);
+                out.append("\":");
                 if (indent > 0) {
-                    // no space needed after newline+indent
+                    out.push_back(' ');
                 }
-                stream << '"' << key << '"' << ':';
-                if (indent > 0) {
-                    stream << ' ';
-                }
-                val.DumpImpl(stream, indent, depth + 1);
+                val.DumpImpl(out, indent, depth + 1);
             }
             if (!obj.empty()) {
-                WriteIndent(stream, indent, depth);
+                WriteIndent(out, indent, depth);
             }
-            stream << '}';
+            out.push_back('}');
         }
         else if (IsArray()) {
-            const auto& arr = *std::get<std::shared_ptr<ArrayType>>(data_);
-            stream << '[';
+            out.push_back('[');
             bool first = true;
-            for (const auto& val : arr) {
+            ForEachElement([&](const Value& val) {
                 if (!first) {
-                    stream << ',';
+                    out.push_back(',');
                 }
                 first = false;
-                WriteIndent(stream, indent, depth + 1);
-                val.DumpImpl(stream, indent, depth + 1);
-            }
-            if (!arr.empty()) {
-                WriteIndent(stream, indent, depth);
+                WriteIndent(out, indent, depth + 1);
+                val.DumpImpl(out, indent, depth + 1);
+            });
+            if (Size() != 0) {
+                WriteIndent(out, indent, depth);
             }
-            stream << ']';
+            out.push_back(']');
         }
     }
 };
 
+namespace detail {
+
+    /// @brief Appends the array @p value as a list literal (e.g. "[a, "b, c", [1, 2]]"), read back by @c ForEachListElement.
+    ///
+    /// Object and null elements have no list form and are written as empty strings.
+    inline void AppendListLiteral(std::string& out, const Value& value)
+    {
+        out.push_back('[');
+        bool first = true;
+        value.ForEachElement([&out, &first](const Value& element) {
+            if (!first) {
+                out.append(", ");
+            }
+            first = false;
+            if (element.IsBoolean()) {
+                out.append(element.Get<bool>() ? "true" : "false");
+            }
+            else if (element.IsInteger()) {
+                AppendInteger(out, element.Get<std::int64_t>());
+            }
+            else if (element.IsDouble()) {
+                AppendDouble(out, element.Get<double>());
+            }
+            else if (element.IsString()) {
+                AppendListString(out, element.AsStringView());
+            }
+            else if (element.IsArray()) {
+                AppendListLiteral(out, element);
+            }
+            else {
+                out.append("\"\"");
+            }
+        });
+        out.push_back(']');
+    }
+
+}  // namespace detail
+
 }  // namespace cppfig
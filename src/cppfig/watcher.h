@@ -0,0 +1,339 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <concepts>
+#include <condition_variable>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <stop_token>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+#if defined(__linux__)
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+#include "cppfig/logging.h"
+#include "cppfig/status.h"
+#include "cppfig/thread_policy.h"
+
+namespace cppfig {
+
+/// @brief Concept for configurations that can be hot-reloaded by a ConfigWatcher.
+///
+/// The configuration must support a non-blocking @c Reload and must not use
+/// @c SingleThreadedPolicy, since the watcher reloads from its own thread.
+template <typename Config>
+concept IsWatchable = requires(Config& config) {
+    typename Config::thread_policy;
+    { config.Reload() } -> std::same_as<Status>;
+    { config.GetFilePath() } -> std::convertible_to<std::string_view>;
+} && !std::is_same_v<typename Config::thread_policy, SingleThreadedPolicy>;
+
+/// @brief How a ConfigWatcher detects changes of the configuration file.
+enum class WatchMode : std::uint8_t {
+    kAuto,     ///< inotify where available, polling otherwise.
+    kPolling,  ///< Compare modification time, size and symlink target every poll interval.
+};
+
+/// @brief Options for a ConfigWatcher.
+struct WatchOptions {
+    WatchMode mode = WatchMode::kAuto;
+
+    /// @brief Polling period, and the longest time @c Stop waits for the watch thread.
+    std::chrono::milliseconds poll_interval { 250 };
+};
+
+/// @brief Background hot-reloader for a configuration file.
+///
+/// Watches the configuration file (through its parent directory, so editors
+/// that save by renaming a temporary file are detected) and calls
+/// @c Configuration::Reload from a background thread whenever it changes.
+/// Parsing and validation run on the watch thread without holding the
+/// configuration lock; readers are only excluded while the new state is
+/// swapped in.  The callback runs on the watch thread after every reload
+/// attempt, with the reload status.
+///
+/// Under inotify, the file is reloaded only once a writer has finished with
+/// it: when a handle open for writing is closed (@c IN_CLOSE_WRITE) or an
+/// entry is renamed into place (@c IN_MOVED_TO).  A rename of another entry
+/// in the directory (e.g. the `..data` symlink swap of Kubernetes ConfigMap
+/// mounts) reloads when the file's stamp, including the target it resolves
+/// to through symlinks, has changed.  After a queue overflow the watcher
+/// falls back to polling the stamp until it changes.
+///
+/// In polling mode a changed stamp must be seen unchanged by two
+/// consecutive polls before the file is reloaded, so a writer that pauses
+/// for less than one poll interval is never observed half-way.
+///
+/// Usage:
+/// @code
+/// cppfig::Configuration<MySchema, cppfig::ConfSerializer, cppfig::SnapshotPolicy> config("app.conf");
+/// (void)config.Load();
+///
+/// cppfig::ConfigWatcher watcher(config, [](const cppfig::Status& status) {
+///     if (!status.ok()) { /* keep running on the previous configuration */ }
+/// });
+/// auto status = watcher.Start();
+/// @endcode
+///
+/// The watcher must be destroyed (or stopped) before the configuration.
+///
+/// @tparam Config The watched configuration type.
+template <IsWatchable Config>
+class ConfigWatcher {
+public:
+    using callback_type = std::function<void(const Status&)>;
+
+    /// @brief Creates a stopped watcher.
+    ///
+    /// @param config The configuration to reload.
+    /// @param on_reload Called on the watch thread after each reload attempt (may be empty).
+    /// @param options Change detection options.
+    explicit ConfigWatcher(Config& config, callback_type on_reload = {}, WatchOptions options = {})
+        : config_(config)
+        , on_reload_(std::move(on_reload))
+        , options_(options)
+    {
+    }
+
+    ~ConfigWatcher() { Stop(); }
+
+    ConfigWatcher(const ConfigWatcher&) = delete;
+    auto operator=(const ConfigWatcher&) -> ConfigWatcher& = delete;
+    ConfigWatcher(ConfigWatcher&&) = delete;
+    auto operator=(ConfigWatcher&&) -> ConfigWatcher& = delete;
+
+    /// @brief Starts the watch thread.
+    ///
+    /// Returns an error if the watcher is already running.
+    [[nodiscard]] auto Start() -> Status
+    {
+        if (thread_.joinable()) {
+            return InternalError("ConfigWatcher is already running");
+        }
+
+        std::optional<int> inotify_fd;
+#if defined(__linux__)
+        if (options_.mode == WatchMode::kAuto) {
+            inotify_fd = OpenInotify();
+        }
+#endif
+
+        // Stamp the file before the thread starts so changes made right after
+        // Start() returns are never mistaken for the initial state.
+        const FileStamp initial = CurrentStamp();
+        thread_ = std::jthread([this, inotify_fd, initial](std::stop_token stop_token) {
+#if defined(__linux__)
+            if (inotify_fd.has_value()) {
+                RunInotify(stop_token, *inotify_fd, initial);
+                ::close(*inotify_fd);
+                return;
+            }
+#endif
+            RunPolling(stop_token, initial);
+        });
+        return OkStatus();
+    }
+
+    /// @brief Stops the watch thread and waits for it to exit (no-op if not running).
+    void Stop()
+    {
+        if (!thread_.joinable()) {
+            return;
+        }
+        thread_.request_stop();
+        {
+            std::lock_guard lock(wake_mutex_);
+        }
+        wake_.notify_all();
+        thread_.join();
+    }
+
+    /// @brief Returns whether the watch thread is running.
+    [[nodiscard]] auto IsRunning() const -> bool { return thread_.joinable(); }
+
+private:
+    /// @brief Modification time, size and symlink target of a file, used to detect changes.
+    struct FileStamp {
+        std::filesystem::file_time_type mtime {};
+        std::uintmax_t size = 0;
+        std::filesystem::path target;  ///< The file the path resolves to through symlinks.
+        bool exists = false;
+
+        auto operator==(const FileStamp&) const -> bool = default;
+    };
+
+    [[nodiscard]] auto CurrentStamp() const -> FileStamp
+    {
+        namespace fs = std::filesystem;
+
+        std::error_code error_code;
+        const fs::path path(std::string(config_.GetFilePath()));
+        FileStamp stamp;
+        stamp.mtime = fs::last_write_time(path, error_code);
+        if (error_code) {
+            return stamp;
+        }
+        stamp.size = fs::file_size(path, error_code);
+        if (error_code) {
+            return stamp;
+        }
+        stamp.target = fs::canonical(path, error_code);
+        stamp.exists = !error_code;
+        return stamp;
+    }
+
+    void ReloadAndNotify()
+    {
+        auto status = config_.Reload();
+        if (!status.ok()) {
+            Logger::WarnF("Failed to reload configuration '%.*s': %s",
+                          static_cast<int>(config_.GetFilePath().size()), config_.GetFilePath().data(),
+                          std::string(status.message()).c_str());
+        }
+        if (on_reload_) {
+            on_reload_(status);
+        }
+    }
+
+    /// @brief Returns whether @p current differs from @p last and was already seen by the previous check.
+    ///
+    /// @p pending holds the stamp of the previous check while a change is settling.
+    [[nodiscard]] static auto Settled(const FileStamp& current, const FileStamp& last,
+                                      std::optional<FileStamp>& pending) -> bool
+    {
+        if (current == last) {
+            pending.reset();
+            return false;
+        }
+        if (pending != current) {
+            pending = current;
+            return false;
+        }
+        pending.reset();
+        return true;
+    }
+
+    void RunPolling(const std::stop_token& stop_token, FileStamp last)
+    {
+        std::optional<FileStamp> pending;
+        std::unique_lock lock(wake_mutex_);
+        while (!stop_token.stop_requested()) {
+            wake_.wait_for(lock, options_.poll_interval, [&stop_token] { return stop_token.stop_requested(); });
+            if (stop_token.stop_requested()) {
+                break;
+            }
+
+            const FileStamp current = CurrentStamp();
+            if (!Settled(current, last, pending)) {
+                continue;
+            }
+            last = current;
+            if (current.exists) {
+                lock.unlock();
+                ReloadAndNotify();
+                lock.lock();
+            }
+        }
+    }
+
+#if defined(__linux__)
+    /// @brief Opens an inotify descriptor watching the file's directory, or nullopt on failure.
+    [[nodiscard]] auto OpenInotify() const -> std::optional<int>
+    {
+        namespace fs = std::filesystem;
+
+        const int inotify_fd = ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if (inotify_fd < 0) {
+            return std::nullopt;
+        }
+
+        fs::path directory = fs::path(std::string(config_.GetFilePath())).parent_path();
+        if (directory.empty()) {
+            directory = ".";
+        }
+        constexpr std::uint32_t k_mask = IN_CLOSE_WRITE | IN_MOVED_TO;
+        if (::inotify_add_watch(inotify_fd, directory.c_str(), k_mask) < 0) {
+            ::close(inotify_fd);
+            return std::nullopt;
+        }
+        return inotify_fd;
+    }
+
+    /// @brief Reloads when the file is closed after writing or renamed into place.
+    ///
+    /// Renames of other entries (a symlink swapped in the directory) reload
+    /// when the stamp differs from @p last.  After a queue overflow, poll
+    /// timeouts compare the stamp until it has settled.
+    void RunInotify(const std::stop_token& stop_token, int inotify_fd, FileStamp last)
+    {
+        namespace fs = std::filesystem;
+
+        const std::string file_name = fs::path(std::string(config_.GetFilePath())).filename().string();
+        alignas(inotify_event) std::array<char, 4096> buffer {};
+        bool overflowed = false;
+        std::optional<FileStamp> pending;
+
+        while (!stop_token.stop_requested()) {
+            pollfd poll_fd { inotify_fd, POLLIN, 0 };
+            const int ready = ::poll(&poll_fd, 1, static_cast<int>(options_.poll_interval.count()));
+            if (ready < 0 || stop_token.stop_requested()) {
+                continue;  // EINTR, or re-check the stop token
+            }
+
+            bool written = false;
+            bool renamed = false;
+            ssize_t length = 0;
+            while ((length = ::read(inotify_fd, buffer.data(), buffer.size())) > 0) {
+                for (ssize_t offset = 0; offset < length;) {
+                    const auto* event = reinterpret_cast<const inotify_event*>(buffer.data() + offset);
+                    if ((event->mask & IN_Q_OVERFLOW) != 0) {
+                        overflowed = true;
+                    } else if (event->len > 0 && file_name == event->name) {
+                        written = true;
+                    } else if ((event->mask & IN_MOVED_TO) != 0) {
+                        renamed = true;
+                    }
+                    offset += static_cast<ssize_t>(sizeof(inotify_event) + event->len);
+                }
+            }
+
+            const FileStamp current = CurrentStamp();
+            bool changed = written || (renamed && current != last);
+            if (!changed && overflowed && ready == 0) {
+                changed = Settled(current, last, pending);
+            }
+            if (!changed) {
+                continue;
+            }
+            last = current;
+            overflowed = false;
+            pending.reset();
+            if (current.exists) {
+                ReloadAndNotify();
+            }
+        }
+    }
+#endif
+
+    Config& config_;
+    callback_type on_reload_;
+    WatchOptions options_;
+
+    std::mutex wake_mutex_;
+    std::condition_variable wake_;
+    std::jthread thread_;
+};
+
+}  // namespace cppfig
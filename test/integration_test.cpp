@@ -3,10 +3,14 @@
 #include <cppfig/testing/mock.h>
 #include <gtest/gtest.h>
 
+#include <array>
 #include <cstdlib>
 #include <filesystem>
 #include <fstream>
+#include <memory>
+#include <sstream>
 #include <string>
+#include <vector>
 
 namespace cppfig::test {
 
@@ -108,6 +112,20 @@ namespace settings {
         static auto default_value() -> std::int64_t { return 0; }
     };
 
+    // List settings
+    struct UpstreamHosts {
+        static constexpr std::string_view path = "upstream.hosts";
+        static constexpr std::string_view env_override = "TEST_UPSTREAM_HOSTS";
+        using value_type = std::vector<std::string>;
+        static auto default_value() -> std::vector<std::string> { return { "localhost" }; }
+    };
+
+    struct UpstreamWeights {
+        static constexpr std::string_view path = "upstream.weights";
+        using value_type = std::vector<double>;
+        static auto default_value() -> std::vector<double> { return { 1.0 }; }
+    };
+
 }  // namespace settings
 
 class ConfigurationIntegrationTest : public ::testing::Test {
@@ -155,6 +173,536 @@ TEST_F(ConfigurationIntegrationTest, LoadExistingFile)
     EXPECT_EQ(config.Get<settings::AppPort>(), 9000);
 }
 
+TEST_F(ConfigurationIntegrationTest, ReloadRefreshesTypedSlots)
+{
+    {
+        std::ofstream file(file_path_);
+        file << R"({"app": {"name": "First", "port": 9000}})";
+    }
+
+    using Schema = ConfigSchema<settings::AppName, settings::AppPort>;
+    Configuration<Schema, JsonSerializer> config(file_path_);
+    ASSERT_TRUE(config.Load().ok());
+    EXPECT_EQ(config.Get<settings::AppName>(), "First");
+
+    {
+        std::ofstream file(file_path_);
+        file << R"({"app": {"name": "Second", "port": 9001}})";
+    }
+
+    ASSERT_TRUE(config.Load().ok());
+    EXPECT_EQ(config.Get<settings::AppName>(), "Second");
+    EXPECT_EQ(config.Get<settings::AppPort>(), 9001);
+}
+
+TEST_F(ConfigurationIntegrationTest, ReloadSwapsInNewState)
+{
+    using Schema = ConfigSchema<settings::AppName, settings::ServerPort>;
+    Configuration<Schema, JsonSerializer> config(file_path_);
+    ASSERT_TRUE(config.Load().ok());
+
+    {
+        std::ofstream file(file_path_);
+        file << R"({"app": {"name": "Reloaded"}, "server": {"port": 9443}})";
+    }
+
+    const auto generation = config.Generation();
+    ASSERT_TRUE(config.Reload().ok());
+    EXPECT_GT(config.Generation(), generation);
+    EXPECT_EQ(config.Get<settings::AppName>(), "Reloaded");
+    EXPECT_EQ(config.Get<settings::ServerPort>(), 9443);
+}
+
+TEST_F(ConfigurationIntegrationTest, ReloadKeepsStateOnInvalidFile)
+{
+    using Schema = ConfigSchema<settings::AppName, settings::ServerPort>;
+    Configuration<Schema, JsonSerializer> config(file_path_);
+    ASSERT_TRUE(config.Load().ok());
+    ASSERT_TRUE(config.Set<settings::ServerPort>(9000).ok());
+
+    // Fails validation: the previous state stays in place
+    {
+        std::ofstream file(file_path_);
+        file << R"({"app": {"name": "Broken"}, "server": {"port": 70000}})";
+    }
+    const auto generation = config.Generation();
+    auto status = config.Reload();
+    EXPECT_TRUE(cppfig::IsInvalidArgument(status));
+    EXPECT_EQ(config.Generation(), generation);
+    EXPECT_EQ(config.Get<settings::AppName>(), "TestApp");
+    EXPECT_EQ(config.Get<settings::ServerPort>(), 9000);
+
+    // Missing file: Reload never recreates it
+    std::filesystem::remove(file_path_);
+    EXPECT_TRUE(cppfig::IsNotFound(config.Reload()));
+    EXPECT_FALSE(std::filesystem::exists(file_path_));
+    EXPECT_EQ(config.Get<settings::ServerPort>(), 9000);
+}
+
+TEST_F(ConfigurationIntegrationTest, FingerprintTracksFileValues)
+{
+    using Schema = ConfigSchema<settings::AppName, settings::ServerPort>;
+    Configuration<Schema, JsonSerializer> config(file_path_);
+    ASSERT_TRUE(config.Load().ok());
+
+    const auto loaded = config.Fingerprint();
+    EXPECT_EQ(loaded, config.GetFileValues().Hash());
+
+    ASSERT_TRUE(config.Set<settings::ServerPort>(9000).ok());
+    EXPECT_NE(config.Fingerprint(), loaded);
+    EXPECT_EQ(config.Fingerprint(), config.GetFileValues().Hash());
+
+    ASSERT_TRUE(config.Transaction().Set<settings::AppName>("Other").Set<settings::ServerPort>(8080).Commit().ok());
+    EXPECT_EQ(config.Fingerprint(), config.GetFileValues().Hash());
+
+    ASSERT_TRUE(config.Set<settings::AppName>("TestApp").ok());
+    EXPECT_EQ(config.Fingerprint(), loaded);
+}
+
+TEST_F(ConfigurationIntegrationTest, ReloadOfUnchangedFileIsNoOp)
+{
+    using Schema = ConfigSchema<settings::AppName, settings::ServerPort>;
+    Configuration<Schema, JsonSerializer> config(file_path_);
+    ASSERT_TRUE(config.Load().ok());
+
+    int notifications = 0;
+    config.Subscribe<settings::ServerPort>([&notifications](const int& /*port*/) { ++notifications; });
+
+    const auto generation = config.Generation();
+    ASSERT_TRUE(config.Reload().ok());
+    EXPECT_EQ(config.Generation(), generation);
+    EXPECT_EQ(notifications, 0);
+
+    {
+        std::ofstream file(file_path_);
+        file << R"({"app": {"name": "TestApp"}, "server": {"port": 9000}})";
+    }
+    ASSERT_TRUE(config.Reload().ok());
+    EXPECT_NE(config.Generation(), generation);
+    EXPECT_EQ(notifications, 1);
+    EXPECT_EQ(config.Get<settings::ServerPort>(), 9000);
+    EXPECT_FALSE(config.IsDirty());
+}
+
+TEST_F(ConfigurationIntegrationTest, LoadSnapshotSkipsTextFile)
+{
+    using Schema = ConfigSchema<settings::AppName, settings::ServerPort>;
+    const std::string snapshot_path = file_path_ + ".bin";
+    {
+        std::ofstream file(file_path_);
+        file << R"({"app": {"name": "FromText"}, "server": {"port": 9000}})";
+    }
+
+    // No snapshot yet: loads the text file and writes one
+    {
+        Configuration<Schema, JsonSerializer> config(file_path_);
+        ASSERT_TRUE(config.LoadSnapshot(snapshot_path).ok());
+        EXPECT_EQ(config.Get<settings::ServerPort>(), 9000);
+        EXPECT_TRUE(std::filesystem::exists(snapshot_path));
+    }
+
+    // A valid snapshot is used as is: replace its contents but keep its stamp
+    {
+        auto contents = detail::FileContents::Open(snapshot_path);
+        ASSERT_TRUE(contents.ok());
+        auto stamp = BinarySerializer::ReadStamp(contents->View());
+        ASSERT_TRUE(stamp.ok());
+        auto values = Value::Object();
+        values.SetAtPath("app.name", "FromSnapshot");
+        values.SetAtPath("server.port", 9001);
+        ASSERT_TRUE(detail::WriteFileAtomically(snapshot_path, BinarySerializer::Stringify(values, *stamp)).ok());
+    }
+    {
+        Configuration<Schema, JsonSerializer> config(file_path_);
+        ASSERT_TRUE(config.LoadSnapshot(snapshot_path).ok());
+        EXPECT_EQ(config.Get<settings::AppName>(), "FromSnapshot");
+        EXPECT_EQ(config.Get<settings::ServerPort>(), 9001);
+        EXPECT_FALSE(config.IsDirty());
+    }
+
+    testing::ConfigurationTestFixture::RemoveFile(snapshot_path);
+}
+
+TEST_F(ConfigurationIntegrationTest, LoadSnapshotFallsBackWhenStale)
+{
+    using Schema = ConfigSchema<settings::AppName, settings::ServerPort>;
+    const std::string snapshot_path = file_path_ + ".bin";
+    {
+        Configuration<Schema, JsonSerializer> config(file_path_);
+        ASSERT_TRUE(config.Load().ok());
+        ASSERT_TRUE(config.SaveSnapshot(snapshot_path).ok());
+    }
+
+    // The text file changed: the snapshot no longer matches its size
+    {
+        std::ofstream file(file_path_);
+        file << R"({"app": {"name": "TestApp"}, "server": {"port": 12345}})";
+    }
+    {
+        Configuration<Schema, JsonSerializer> config(file_path_);
+        ASSERT_TRUE(config.LoadSnapshot(snapshot_path).ok());
+        EXPECT_EQ(config.Get<settings::ServerPort>(), 12345);
+    }
+
+    // A different schema never trusts the snapshot, even with the file unchanged
+    {
+        using OtherSchema = ConfigSchema<settings::AppName, settings::ServerPort, settings::LoggingLevel>;
+        static_assert(OtherSchema::hash != Schema::hash);
+        Configuration<OtherSchema, JsonSerializer> config(file_path_);
+        ASSERT_TRUE(config.LoadSnapshot(snapshot_path).ok());
+        EXPECT_EQ(config.Get<settings::ServerPort>(), 12345);
+        EXPECT_TRUE(config.GetFileValues().HasPath("logging.level"));
+    }
+
+    // A corrupt snapshot is replaced
+    {
+        std::ofstream file(snapshot_path, std::ios::trunc);
+        file << "garbage";
+    }
+    {
+        Configuration<Schema, JsonSerializer> config(file_path_);
+        ASSERT_TRUE(config.LoadSnapshot(snapshot_path).ok());
+        EXPECT_EQ(config.Get<settings::ServerPort>(), 12345);
+    }
+    auto contents = detail::FileContents::Open(snapshot_path);
+    ASSERT_TRUE(contents.ok());
+    EXPECT_TRUE(BinarySerializer::ParseBuffer(contents->View()).ok());
+
+    testing::ConfigurationTestFixture::RemoveFile(snapshot_path);
+}
+
+TEST_F(ConfigurationIntegrationTest, SaveSnapshotRequiresLoad)
+{
+    using Schema = ConfigSchema<settings::AppName>;
+    Configuration<Schema, JsonSerializer> config(file_path_);
+    EXPECT_TRUE(IsNotFound(config.SaveSnapshot(file_path_ + ".bin")));
+}
+
+TEST_F(ConfigurationIntegrationTest, SaveSnapshotRefusesFileChangedSinceLoad)
+{
+    using Schema = ConfigSchema<settings::AppName, settings::ServerPort>;
+    const std::string snapshot_path = file_path_ + ".bin";
+    Configuration<Schema, JsonSerializer> config(file_path_);
+    ASSERT_TRUE(config.Load().ok());
+
+    // Rewritten after the values were read: the loaded values must not be paired with the new stamp
+    {
+        std::ofstream file(file_path_);
+        file << R"({"app": {"name": "TestApp"}, "server": {"port": 12345}})";
+    }
+    EXPECT_FALSE(config.SaveSnapshot(snapshot_path).ok());
+    EXPECT_FALSE(std::filesystem::exists(snapshot_path));
+
+    Configuration<Schema, JsonSerializer> restarted(file_path_);
+    ASSERT_TRUE(restarted.LoadSnapshot(snapshot_path).ok());
+    EXPECT_EQ(restarted.Get<settings::ServerPort>(), 12345);
+    ASSERT_TRUE(restarted.SaveSnapshot(snapshot_path).ok());
+
+    testing::ConfigurationTestFixture::RemoveFile(snapshot_path);
+}
+
+TEST_F(ConfigurationIntegrationTest, ReloadDoesNotMigrate)
+{
+    {
+        std::ofstream file(file_path_);
+        file << R"({"app": {"name": "Partial"}})";
+    }
+
+    using Schema = ConfigSchema<settings::AppName, settings::AppPort>;
+    Configuration<Schema, JsonSerializer> config(file_path_);
+    ASSERT_TRUE(config.Reload().ok());
+    EXPECT_EQ(config.Get<settings::AppName>(), "Partial");
+    EXPECT_EQ(config.Get<settings::AppPort>(), 8080);
+
+    std::ifstream file(file_path_);
+    const std::string content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    EXPECT_EQ(content.find("port"), std::string::npos);
+}
+
+TEST_F(ConfigurationIntegrationTest, SaveSkippedWhenNothingChanged)
+{
+    using Schema = ConfigSchema<settings::AppName, settings::AppPort>;
+    Configuration<Schema> config(file_path_);
+    EXPECT_TRUE(config.IsDirty());
+    ASSERT_TRUE(config.Load().ok());
+    EXPECT_FALSE(config.IsDirty());
+    EXPECT_TRUE(config.DirtyPaths().empty());
+
+    // An unchanged configuration must not rewrite the file
+    const auto written = std::filesystem::last_write_time(file_path_);
+    ASSERT_TRUE(config.Save().ok());
+    EXPECT_EQ(std::filesystem::last_write_time(file_path_), written);
+
+    // ...unless the file was edited since: Save restores the configuration's values
+    {
+        std::ofstream file(file_path_, std::ios::app);
+        file << "# hand-written comment\n";
+    }
+    ASSERT_TRUE(config.Save().ok());
+    std::stringstream contents;
+    contents << std::ifstream(file_path_).rdbuf();
+    EXPECT_EQ(contents.str().find("# hand-written comment"), std::string::npos);
+
+    ASSERT_TRUE(config.Set<settings::AppPort>(9000).ok());
+    EXPECT_TRUE(config.IsDirty());
+    EXPECT_EQ(config.DirtyPaths(), std::vector<std::string_view> { settings::AppPort::path });
+
+    ASSERT_TRUE(config.Save().ok());
+    EXPECT_FALSE(config.IsDirty());
+
+    Configuration<Schema> reloaded(file_path_);
+    ASSERT_TRUE(reloaded.Load().ok());
+    EXPECT_EQ(reloaded.Get<settings::AppPort>(), 9000);
+}
+
+TEST_F(ConfigurationIntegrationTest, SaveRewritesDeletedFile)
+{
+    using Schema = ConfigSchema<settings::AppName>;
+    Configuration<Schema> config(file_path_);
+    ASSERT_TRUE(config.Load().ok());
+
+    std::filesystem::remove(file_path_);
+    ASSERT_TRUE(config.Save().ok());
+    EXPECT_TRUE(std::filesystem::exists(file_path_));
+}
+
+TEST_F(ConfigurationIntegrationTest, SaveReplacesFileAtomically)
+{
+    namespace fs = std::filesystem;
+    using Schema = ConfigSchema<settings::AppName, settings::AppPort>;
+    Configuration<Schema> config(file_path_);
+    ASSERT_TRUE(config.Load().ok());
+
+    fs::permissions(file_path_, fs::perms::owner_read | fs::perms::owner_write | fs::perms::group_read,
+                    fs::perm_options::replace);
+    ASSERT_TRUE(config.Set<settings::AppPort>(9100).ok());
+    ASSERT_TRUE(config.Save().ok());
+
+    // Permissions survive the rename and no temporary file is left behind
+    EXPECT_EQ(fs::status(file_path_).permissions(),
+              fs::perms::owner_read | fs::perms::owner_write | fs::perms::group_read);
+    const std::string prefix = fs::path(file_path_).filename().string() + ".tmp.";
+    for (const auto& entry : fs::directory_iterator(fs::path(file_path_).parent_path())) {
+        EXPECT_FALSE(entry.path().filename().string().starts_with(prefix)) << entry.path();
+    }
+}
+
+TEST_F(ConfigurationIntegrationTest, SaveThroughSymlinkKeepsLink)
+{
+    namespace fs = std::filesystem;
+    using Schema = ConfigSchema<settings::AppName, settings::AppPort>;
+
+    const std::string link_path = file_path_ + ".link";
+    fs::remove(link_path);
+    {
+        Configuration<Schema> target(file_path_);
+        ASSERT_TRUE(target.Load().ok());
+    }
+    fs::create_symlink(file_path_, link_path);
+
+    Configuration<Schema> config(link_path);
+    ASSERT_TRUE(config.Load().ok());
+    ASSERT_TRUE(config.Set<settings::AppPort>(9200).ok());
+    ASSERT_TRUE(config.Save().ok());
+
+    EXPECT_TRUE(fs::is_symlink(link_path));
+    Configuration<Schema> target(file_path_);
+    ASSERT_TRUE(target.Load().ok());
+    EXPECT_EQ(target.Get<settings::AppPort>(), 9200);
+    fs::remove(link_path);
+}
+
+TEST_F(ConfigurationIntegrationTest, SaveToFullDeviceFails)
+{
+    if (!std::filesystem::exists("/dev/full")) {
+        GTEST_SKIP() << "/dev/full not available";
+    }
+    using Schema = ConfigSchema<settings::AppName>;
+    Configuration<Schema> config("/dev/full");
+    ASSERT_TRUE(config.Set<settings::AppName>("FullDevice").ok());
+    auto status = config.Save();
+    EXPECT_FALSE(status.ok());
+    EXPECT_TRUE(std::filesystem::exists("/dev/full"));
+}
+
+TEST_F(ConfigurationIntegrationTest, CachedSettingRefreshesOnGeneration)
+{
+    using Schema = ConfigSchema<settings::AppName, settings::AppPort>;
+    Configuration<Schema, JsonSerializer> config(file_path_);
+    ASSERT_TRUE(config.Load().ok());
+
+    auto name = config.Cached<settings::AppName>();
+    auto port = config.Cached<settings::AppPort>();
+    EXPECT_EQ(*name, "TestApp");
+    EXPECT_EQ(name->size(), 7U);
+
+    const auto generation = config.Generation();
+    ASSERT_TRUE(config.Set<settings::AppPort>(9100).ok());
+    EXPECT_GT(config.Generation(), generation);
+    EXPECT_EQ(port.Get(), 9100);
+    EXPECT_EQ(name.Get(), "TestApp");
+
+    {
+        std::ofstream file(file_path_);
+        file << R"({"app": {"name": "Reloaded", "port": 9200}})";
+    }
+    ASSERT_TRUE(config.Load().ok());
+    EXPECT_EQ(name.Get(), "Reloaded");
+    EXPECT_EQ(port.Get(), 9200);
+}
+
+TEST_F(ConfigurationIntegrationTest, FailedSetKeepsGeneration)
+{
+    using Schema = ConfigSchema<settings::ServerPort>;
+    Configuration<Schema> config(file_path_);
+    ASSERT_TRUE(config.Load().ok());
+
+    const auto generation = config.Generation();
+    EXPECT_FALSE(config.Set<settings::ServerPort>(0).ok());
+    EXPECT_EQ(config.Generation(), generation);
+}
+
+TEST_F(ConfigurationIntegrationTest, TransactionAppliesAllValuesOnce)
+{
+    using Schema = ConfigSchema<settings::AppName, settings::AppPort, settings::ServerPort>;
+    Configuration<Schema, JsonSerializer> config(file_path_);
+    ASSERT_TRUE(config.Load().ok());
+
+    std::vector<int> ports;
+    config.Subscribe<settings::ServerPort>([&ports](const int& port) { ports.push_back(port); });
+
+    const auto generation = config.Generation();
+    auto status = config.Transaction()
+                      .Set<settings::AppName>("Batched")
+                      .Set<settings::ServerPort>(9000)
+                      .Set<settings::ServerPort>(9443)  // last value wins
+                      .Commit();
+    ASSERT_TRUE(status.ok()) << status.message();
+
+    EXPECT_EQ(config.Generation(), generation + 1);
+    EXPECT_EQ(config.Get<settings::AppName>(), "Batched");
+    EXPECT_EQ(config.Get<settings::ServerPort>(), 9443);
+    EXPECT_EQ(config.Get<settings::AppPort>(), 8080);
+    EXPECT_EQ(ports, std::vector<int> { 9443 });
+    EXPECT_EQ(config.DirtyPaths(), (std::vector<std::string_view> { settings::AppName::path, settings::ServerPort::path }));
+}
+
+TEST_F(ConfigurationIntegrationTest, TransactionIsAllOrNothing)
+{
+    using Schema = ConfigSchema<settings::AppName, settings::ServerPort>;
+    Configuration<Schema, JsonSerializer> config(file_path_);
+    ASSERT_TRUE(config.Load().ok());
+
+    const auto generation = config.Generation();
+    auto transaction = config.Transaction();
+    transaction.Set<settings::AppName>("Partial").Set<settings::ServerPort>(70000);
+    auto status = transaction.Commit();
+
+    EXPECT_TRUE(IsInvalidArgument(status));
+    EXPECT_NE(std::string(status.message()).find("server.port"), std::string::npos);
+    EXPECT_EQ(config.Generation(), generation);
+    EXPECT_EQ(config.Get<settings::AppName>(), "TestApp");
+    EXPECT_FALSE(config.IsDirty());
+
+    // The staged values survive a failed commit and can be corrected
+    EXPECT_FALSE(transaction.Empty());
+    ASSERT_TRUE(transaction.Set<settings::ServerPort>(7000).Commit().ok());
+    EXPECT_TRUE(transaction.Empty());
+    EXPECT_EQ(config.Get<settings::AppName>(), "Partial");
+    EXPECT_EQ(config.Get<settings::ServerPort>(), 7000);
+
+    // Empty commits change nothing
+    const auto committed = config.Generation();
+    ASSERT_TRUE(config.Transaction().Commit().ok());
+    EXPECT_EQ(config.Generation(), committed);
+}
+
+TEST_F(ConfigurationIntegrationTest, SubscribeFiresOnlyForChangedSetting)
+{
+    using Schema = ConfigSchema<settings::AppName, settings::AppPort>;
+    Configuration<Schema, JsonSerializer> config(file_path_);
+    ASSERT_TRUE(config.Load().ok());
+
+    std::vector<int> ports;
+    int name_changes = 0;
+    config.Subscribe<settings::AppPort>([&ports](const int& port) { ports.push_back(port); });
+    config.Subscribe<settings::AppName>([&name_changes](const std::string& /*name*/) { ++name_changes; });
+
+    ASSERT_TRUE(config.Set<settings::AppPort>(9000).ok());
+    ASSERT_TRUE(config.Set<settings::AppPort>(9000).ok());  // unchanged: no notification
+    ASSERT_TRUE(config.Set<settings::AppPort>(9001).ok());
+
+    EXPECT_EQ(ports, (std::vector<int> { 9000, 9001 }));
+    EXPECT_EQ(name_changes, 0);
+
+    {
+        std::ofstream file(file_path_);
+        file << R"({"app": {"name": "Renamed", "port": 9001}})";
+    }
+    ASSERT_TRUE(config.Reload().ok());
+    EXPECT_EQ(ports.size(), 2U);
+    EXPECT_EQ(name_changes, 1);
+
+    {
+        std::ofstream file(file_path_);
+        file << R"({"app": {"name": "Renamed", "port": 9002}})";
+    }
+    ASSERT_TRUE(config.Load().ok());
+    EXPECT_EQ(ports.back(), 9002);
+    EXPECT_EQ(name_changes, 1);
+}
+
+TEST_F(ConfigurationIntegrationTest, UnsubscribeStopsNotifications)
+{
+    using Schema = ConfigSchema<settings::AppPort>;
+    Configuration<Schema> config(file_path_);
+
+    int calls = 0;
+    auto id = config.Subscribe<settings::AppPort>([&calls](const int& /*port*/) { ++calls; });
+    ASSERT_TRUE(config.Set<settings::AppPort>(1000).ok());
+    EXPECT_TRUE(config.Unsubscribe(id));
+    EXPECT_FALSE(config.Unsubscribe(id));
+    ASSERT_TRUE(config.Set<settings::AppPort>(1001).ok());
+    EXPECT_EQ(calls, 1);
+}
+
+TEST_F(ConfigurationIntegrationTest, SubscribeSeesEnvironmentOverride)
+{
+    using Schema = ConfigSchema<settings::AppHost>;
+    Configuration<Schema> config(file_path_);
+    ASSERT_TRUE(config.Load().ok());
+
+    std::vector<std::string> hosts;
+    config.Subscribe<settings::AppHost>([&hosts](const std::string& host) { hosts.push_back(host); });
+
+    setenv("TEST_APP_HOST", "env.example.com", 1);
+    config.RefreshEnvironment();
+    ASSERT_EQ(hosts.size(), 1U);
+    EXPECT_EQ(hosts.back(), "env.example.com");
+
+    // The file value is masked by the override: nothing observable changed
+    ASSERT_TRUE(config.Set<settings::AppHost>("file.example.com").ok());
+    EXPECT_EQ(hosts.size(), 1U);
+
+    unsetenv("TEST_APP_HOST");
+    config.RefreshEnvironment();
+    ASSERT_EQ(hosts.size(), 2U);
+    EXPECT_EQ(hosts.back(), "file.example.com");
+}
+
+TEST_F(ConfigurationIntegrationTest, SubscriberMayCallBackIntoConfiguration)
+{
+    using Schema = ConfigSchema<settings::AppName, settings::AppPort>;
+    Configuration<Schema> config(file_path_);
+
+    config.Subscribe<settings::AppPort>([&config](const int& port) {
+        EXPECT_EQ(config.Get<settings::AppPort>(), port);
+        EXPECT_TRUE(config.Set<settings::AppName>("port-" + std::to_string(port)).ok());
+    });
+    ASSERT_TRUE(config.Set<settings::AppPort>(7000).ok());
+    EXPECT_EQ(config.Get<settings::AppName>(), "port-7000");
+}
+
 TEST_F(ConfigurationIntegrationTest, SchemaMigration)
 {
     // Create a config file with old schema (missing new setting)
@@ -236,6 +784,29 @@ TEST_F(ConfigurationIntegrationTest, EnvironmentVariableOverride)
     unsetenv("TEST_APP_HOST");
 }
 
+TEST_F(ConfigurationIntegrationTest, EnvironmentSnapshottedUntilRefresh)
+{
+    using Schema = ConfigSchema<settings::AppHost>;
+
+    setenv("TEST_APP_HOST", "first.example.com", 1);
+    Configuration<Schema> config(file_path_);
+    ASSERT_TRUE(config.Load().ok());
+    EXPECT_EQ(config.Get<settings::AppHost>(), "first.example.com");
+
+    // Changing the environment has no effect until the next refresh
+    setenv("TEST_APP_HOST", "second.example.com", 1);
+    EXPECT_EQ(config.Get<settings::AppHost>(), "first.example.com");
+
+    auto cached = config.Cached<settings::AppHost>();
+    config.RefreshEnvironment();
+    EXPECT_EQ(config.Get<settings::AppHost>(), "second.example.com");
+    EXPECT_EQ(*cached, "second.example.com");
+
+    unsetenv("TEST_APP_HOST");
+    ASSERT_TRUE(config.Load().ok());
+    EXPECT_EQ(config.Get<settings::AppHost>(), settings::AppHost::default_value());
+}
+
 TEST_F(ConfigurationIntegrationTest, DiffShowsModifications)
 {
     using Schema = ConfigSchema<settings::AppName, settings::AppPort>;
@@ -271,6 +842,126 @@ TEST_F(ConfigurationIntegrationTest, ValidateAll)
     EXPECT_FALSE(status.ok());
 }
 
+class LayeredConfigurationTest : public ::testing::Test {
+protected:
+    void SetUp() override
+    {
+        directory_ = std::filesystem::temp_directory_path() / ("layered_test_" + std::to_string(std::rand()));
+        std::filesystem::create_directories(directory_ / "conf.d");
+    }
+
+    void TearDown() override { std::filesystem::remove_all(directory_); }
+
+    auto Write(const std::string& name, const std::string& contents) const -> std::string
+    {
+        const auto path = (directory_ / name).string();
+        std::ofstream file(path);
+        file << contents;
+        return path;
+    }
+
+    std::filesystem::path directory_;
+};
+
+TEST_F(LayeredConfigurationTest, HighestLayerWins)
+{
+    using Schema = ConfigSchema<settings::AppName, settings::ServerPort, settings::LoggingLevel, settings::DatabasePort>;
+    const auto base = Write("base.conf", "app.name = Base\nserver.port = 1000\nlogging.level = warn\n");
+    const auto host = Write("host.conf", "server.port = 2000\n");
+    const auto second = Write("conf.d/20-port.conf", "server.port = 3000\n");
+    const auto first = Write("conf.d/10-level.conf", "logging.level = debug\nserver.port = 2500\n");
+    Write("conf.d/ignored.txt", "app.name = Ignored\n");
+
+    const std::array<const char*, 4> argv = { "app", "--app.name=FromFlag", "positional", "--no-value" };
+    LayeredConfiguration<Schema> config({
+        ConfigLayer::File(base, true),
+        ConfigLayer::File(host),
+        ConfigLayer::File((directory_ / "missing.conf").string()),
+        ConfigLayer::Directory((directory_ / "conf.d").string()),
+        ConfigLayer::Arguments(static_cast<int>(argv.size()), argv.data()),
+    });
+    ASSERT_TRUE(config.Load().ok());
+
+    EXPECT_EQ(config.Get<settings::AppName>(), "FromFlag");
+    EXPECT_EQ(config.Get<settings::ServerPort>(), 3000);
+    EXPECT_EQ(config.Get<settings::LoggingLevel>(), "debug");
+    EXPECT_EQ(config.Get<settings::DatabasePort>(), 5432);
+
+    const std::vector<std::string> expected_names = { base, host, first, second, "command line" };
+    EXPECT_EQ(config.LayerNames(), expected_names);
+    EXPECT_EQ(config.LayerOf<settings::AppName>(), 4U);
+    EXPECT_EQ(config.LayerOf<settings::ServerPort>(), 3U);
+    EXPECT_EQ(config.LayerName<settings::ServerPort>(), second);
+    EXPECT_EQ(config.LayerName<settings::LoggingLevel>(), first);
+    EXPECT_EQ(config.LayerOf<settings::DatabasePort>(), (LayeredConfiguration<Schema>::k_default_layer));
+    EXPECT_EQ(config.LayerName<settings::DatabasePort>(), "default");
+    EXPECT_EQ(config.GetMergedValues().FindAtPath("server.port")->Get<int>(), 3000);
+}
+
+TEST_F(LayeredConfigurationTest, EnvironmentOverridesLayers)
+{
+    using Schema = ConfigSchema<settings::AppHost>;
+    const auto base = Write("base.conf", "app.host = from-file\n");
+    setenv("TEST_APP_HOST", "from-env", 1);
+
+    LayeredConfiguration<Schema> config({ ConfigLayer::File(base) });
+    ASSERT_TRUE(config.Load().ok());
+    EXPECT_EQ(config.Get<settings::AppHost>(), "from-env");
+    EXPECT_EQ(config.LayerName<settings::AppHost>(), "environment");
+
+    unsetenv("TEST_APP_HOST");
+    ASSERT_TRUE(config.Load().ok());
+    EXPECT_EQ(config.Get<settings::AppHost>(), "from-file");
+    EXPECT_EQ(config.LayerOf<settings::AppHost>(), 0U);
+}
+
+TEST_F(LayeredConfigurationTest, ParallelLoadMatchesSequential)
+{
+    using Schema = ConfigSchema<settings::AppName, settings::ServerPort, settings::LoggingLevel>;
+    for (int i = 0; i < 16; ++i) {
+        Write("conf.d/" + std::to_string(10 + i) + ".conf", "server.port = " + std::to_string(1000 + i) + "\n");
+    }
+    Write("conf.d/50-name.conf", "app.name = Fragment\n");
+
+    LayeredConfiguration<Schema> sequential({ ConfigLayer::Directory((directory_ / "conf.d").string()) });
+    LayeredConfiguration<Schema, ConfSerializer, MultiThreadedPolicy> parallel({ ConfigLayer::Directory((directory_ / "conf.d").string()) });
+    ASSERT_TRUE(sequential.Load().ok());
+    ASSERT_TRUE(parallel.Load(ExecutionPolicy::kParallel).ok());
+
+    EXPECT_EQ(parallel.Get<settings::ServerPort>(), 1015);
+    EXPECT_EQ(parallel.Get<settings::AppName>(), "Fragment");
+    EXPECT_EQ(parallel.GetMergedValues(), sequential.GetMergedValues());
+    EXPECT_EQ(parallel.LayerNames(), sequential.LayerNames());
+    EXPECT_EQ(parallel.LayerOf<settings::ServerPort>(), sequential.LayerOf<settings::ServerPort>());
+}
+
+TEST_F(LayeredConfigurationTest, FailedLoadKeepsState)
+{
+    using Schema = ConfigSchema<settings::ServerPort>;
+    const auto base = Write("base.conf", "server.port = 1000\n");
+    LayeredConfiguration<Schema> config({ ConfigLayer::File(base), ConfigLayer::Directory((directory_ / "conf.d").string()) });
+    ASSERT_TRUE(config.Load().ok());
+    const auto generation = config.Generation();
+
+    // Merged value fails the validator
+    const auto fragment = Write("conf.d/10-port.conf", "server.port = 70000\n");
+    auto status = config.Load();
+    EXPECT_TRUE(IsInvalidArgument(status));
+
+    // Fragment fails to parse: the error names the file
+    Write("conf.d/10-port.conf", "not a setting\n");
+    status = config.Load();
+    ASSERT_FALSE(status.ok());
+    EXPECT_TRUE(std::string(status.message()).starts_with(fragment + ": "));
+
+    EXPECT_EQ(config.Get<settings::ServerPort>(), 1000);
+    EXPECT_EQ(config.Generation(), generation);
+
+    LayeredConfiguration<Schema> required({ ConfigLayer::File((directory_ / "missing.conf").string(), true) });
+    EXPECT_TRUE(IsNotFound(required.Load()));
+    EXPECT_EQ(required.Get<settings::ServerPort>(), 8080);
+}
+
 TEST_F(ConfigurationIntegrationTest, HierarchicalSettings)
 {
     using Schema = ConfigSchema<settings::DatabaseHost, settings::DatabasePort,
@@ -303,6 +994,110 @@ TEST_F(ConfigurationIntegrationTest, VirtualInterfaceWorks)
     EXPECT_TRUE(virtual_config.ValidateAll().ok());
 }
 
+TEST_F(ConfigurationIntegrationTest, GetAndSetByPath)
+{
+    using Schema = ConfigSchema<settings::AppName, settings::ServerPort, settings::AppHost>;
+    Configuration<Schema> config(file_path_);
+    ASSERT_TRUE(config.Load().ok());
+    IConfigurationProviderVirtual& virtual_config = config;
+
+    auto port = virtual_config.GetByPath("server.port");
+    ASSERT_TRUE(port.ok());
+    EXPECT_EQ(port->Get<int>(), 8080);
+
+    ASSERT_TRUE(virtual_config.SetByPath("server.port", Value(9000)).ok());
+    EXPECT_EQ(config.Get<settings::ServerPort>(), 9000);
+    EXPECT_TRUE(config.IsDirty());
+
+    EXPECT_TRUE(IsInvalidArgument(virtual_config.SetByPath("server.port", Value(70000))));
+    EXPECT_TRUE(IsInvalidArgument(virtual_config.SetByPath("server.port", Value("high"))));
+    EXPECT_TRUE(IsNotFound(virtual_config.SetByPath("server.missing", Value(1))));
+    EXPECT_TRUE(IsNotFound(virtual_config.GetByPath("server").status()));
+    EXPECT_EQ(config.Get<settings::ServerPort>(), 9000);
+
+    // Reads the effective value, including environment overrides
+    setenv("TEST_APP_HOST", "from-env", 1);
+    config.RefreshEnvironment();
+    auto host = virtual_config.GetByPath("app.host");
+    ASSERT_TRUE(host.ok());
+    EXPECT_EQ(host->Get<std::string>(), "from-env");
+    unsetenv("TEST_APP_HOST");
+}
+
+TEST_F(ConfigurationIntegrationTest, ListSettingsRoundTrip)
+{
+    using Schema = ConfigSchema<settings::UpstreamHosts, settings::UpstreamWeights>;
+    {
+        std::ofstream file(file_path_);
+        file << "upstream.hosts = [a.example.com, \"b.example.com\"]\nupstream.weights = [0.25, 0.75]\n";
+    }
+
+    Configuration<Schema> config(file_path_);
+    ASSERT_TRUE(config.Load().ok());
+    EXPECT_EQ(config.Get<settings::UpstreamHosts>(), (std::vector<std::string> { "a.example.com", "b.example.com" }));
+    EXPECT_EQ(config.Get<settings::UpstreamWeights>(), (std::vector<double> { 0.25, 0.75 }));
+
+    ASSERT_TRUE(config.Set<settings::UpstreamWeights>({ 0.5, 0.25, 0.25 }).ok());
+    ASSERT_TRUE(config.Save().ok());
+    {
+        Configuration<Schema, JsonSerializer> json_config(file_path_ + ".json");
+        ASSERT_TRUE(json_config.Set<settings::UpstreamWeights>(config.Get<settings::UpstreamWeights>()).ok());
+        ASSERT_TRUE(json_config.Save().ok());
+        Configuration<Schema, JsonSerializer> reloaded(file_path_ + ".json");
+        ASSERT_TRUE(reloaded.Load().ok());
+        EXPECT_EQ(reloaded.Get<settings::UpstreamWeights>(), (std::vector<double> { 0.5, 0.25, 0.25 }));
+        testing::ConfigurationTestFixture::RemoveFile(file_path_ + ".json");
+    }
+
+    Configuration<Schema> reloaded(file_path_);
+    ASSERT_TRUE(reloaded.Load().ok());
+    EXPECT_EQ(reloaded.Get<settings::UpstreamWeights>(), (std::vector<double> { 0.5, 0.25, 0.25 }));
+
+    setenv("TEST_UPSTREAM_HOSTS", "x.example.com,y.example.com", 1);
+    reloaded.RefreshEnvironment();
+    EXPECT_EQ(reloaded.Get<settings::UpstreamHosts>(), (std::vector<std::string> { "x.example.com", "y.example.com" }));
+    unsetenv("TEST_UPSTREAM_HOSTS");
+}
+
+TEST_F(ConfigurationIntegrationTest, BracketedStringValueStaysString)
+{
+    {
+        std::ofstream file(file_path_);
+        file << "app.name = [prod]\napp.version = [1.50,2]\n";
+    }
+
+    // The text is kept exactly as written, not re-rendered from the parsed list
+    Configuration<ConfigSchema<settings::AppName, settings::AppVersion>> config(file_path_);
+    ASSERT_TRUE(config.Load().ok());
+    EXPECT_EQ(config.Get<settings::AppName>(), "[prod]");
+    EXPECT_EQ(config.Get<settings::AppVersion>(), "[1.50,2]");
+    EXPECT_EQ(config.GetFileValues()["app"]["name"], "[prod]");
+
+    Value list_texts;
+    auto parsed = ConfSerializer::ParseBuffer("app.name = [prod]\napp.port = 8080\n", list_texts);
+    ASSERT_TRUE(parsed.ok());
+    EXPECT_TRUE((*parsed)["app"]["name"].IsArray());
+    EXPECT_EQ(list_texts["app"]["name"], "[prod]");
+    EXPECT_EQ(list_texts.FindAtPath("app.port"), nullptr);
+}
+
+TEST_F(ConfigurationIntegrationTest, ListElementsWithSpecialCharactersRoundTrip)
+{
+    using Schema = ConfigSchema<settings::UpstreamHosts>;
+    const std::vector<std::string> hosts = { R"(a"b)", "c, d", "[e]", R"(f\g)", R"(\"h\")", "" };
+    {
+        Configuration<Schema> config(file_path_);
+        ASSERT_TRUE(config.Set<settings::UpstreamHosts>(hosts).ok());
+        ASSERT_TRUE(config.Save().ok());
+    }
+
+    Configuration<Schema> reloaded(file_path_);
+    ASSERT_TRUE(reloaded.Load().ok());
+    EXPECT_EQ(reloaded.Get<settings::UpstreamHosts>(), hosts);
+    EXPECT_EQ(ConfigTraits<std::vector<std::string>>::FromString(R"(["a\"b", "c\\d", e\f])"),
+              (std::vector<std::string> { R"(a"b)", R"(c\d)", R"(e\f)" }));
+}
+
 struct Point {
     int x = 0;
     int y = 0;
@@ -378,6 +1173,100 @@ TEST_F(ConfigurationIntegrationTest, InvalidJsonFile)
     EXPECT_TRUE(cppfig::IsInvalidArgument(status));
 }
 
+TEST_F(ConfigurationIntegrationTest, MetricsInstrumentationCountsAccesses)
+{
+    {
+        std::ofstream file(file_path_);
+        file << R"({"app": {"name": "App"}, "server": {"port": "not_an_int"}})";
+    }
+    setenv("TEST_SERVER_PORT", "9100", 1);
+
+    using Schema = ConfigSchema<settings::AppName, settings::AppPort, settings::PortWithEnv>;
+    Configuration<Schema, JsonSerializer, MultiThreadedPolicy, MetricsInstrumentation> config(file_path_);
+    EXPECT_EQ(config.Get<settings::AppPort>(), 8080);
+    ASSERT_TRUE(config.Load().ok());
+
+    EXPECT_EQ(config.Get<settings::AppName>(), "App");
+    EXPECT_EQ(config.Get<settings::AppPort>(), 8080);
+    EXPECT_EQ(config.Get<settings::PortWithEnv>(), 9100);
+    ASSERT_TRUE(config.Set<settings::AppPort>(9000).ok());
+
+    auto cached = config.Cached<settings::AppName>();
+    EXPECT_EQ(*cached, "App");
+    EXPECT_EQ(*cached, "App");
+
+    unsetenv("TEST_SERVER_PORT");
+    config.RefreshEnvironment();
+    ::testing::internal::CaptureStderr();
+    EXPECT_EQ(config.Get<settings::PortWithEnv>(), 8080);
+    ::testing::internal::GetCapturedStderr();
+    ASSERT_TRUE(config.Save().ok());
+
+    const MetricsSnapshot metrics = config.Metrics();
+    ASSERT_EQ(metrics.settings.size(), 3U);
+    const auto& name = metrics.settings[0];
+    const auto& port = metrics.settings[1];
+    const auto& env_port = metrics.settings[2];
+    EXPECT_EQ(name.path, "app.name");
+    EXPECT_EQ(name.gets, 2U);  // one direct read, one to create the cached handle
+    EXPECT_EQ(name.cache_misses, 0U);
+    EXPECT_EQ(name.cache_hits, 2U);
+    EXPECT_EQ(port.gets, 2U);
+    EXPECT_EQ(port.defaults, 1U);  // before Load; migration then writes the default to the file
+    EXPECT_EQ(port.sets, 1U);
+    EXPECT_EQ(env_port.gets, 2U);
+    EXPECT_EQ(env_port.env_overrides, 1U);
+    EXPECT_EQ(env_port.fallbacks, 1U);
+
+    EXPECT_EQ(metrics.load.count, 1U);
+    EXPECT_EQ(metrics.load.failures, 0U);
+    EXPECT_GT(metrics.load.total.count(), 0);
+    EXPECT_GT(metrics.load.parse.count(), 0);
+    EXPECT_EQ(metrics.save.count, 1U);
+    EXPECT_GT(metrics.save.io.count(), 0);
+    EXPECT_GT(metrics.lock_waits, 0U);
+}
+
+TEST_F(ConfigurationIntegrationTest, LoadAllReportsEveryFailure)
+{
+    using Schema = ConfigSchema<settings::AppName, settings::AppPort>;
+    using Config = Configuration<Schema, JsonSerializer, MultiThreadedPolicy>;
+
+    std::vector<std::string> paths;
+    for (int i = 0; i < 8; ++i) {
+        paths.push_back(file_path_ + "_tenant" + std::to_string(i));
+    }
+    {
+        std::ofstream file(paths[3]);
+        file << "this is not valid json {{{";
+    }
+    {
+        std::ofstream file(paths[5]);
+        file << R"({"app": {"name": "Tenant5", "port": 9005}})";
+    }
+
+    std::vector<std::unique_ptr<Config>> configs;
+    std::vector<IConfigurationProviderVirtual*> providers;
+    for (const auto& path : paths) {
+        configs.push_back(std::make_unique<Config>(path));
+        providers.push_back(configs.back().get());
+    }
+
+    for (auto policy : { ExecutionPolicy::kSequential, ExecutionPolicy::kParallel }) {
+        auto errors = LoadAll(providers, policy, 3);
+        ASSERT_EQ(errors.size(), 1U);
+        EXPECT_TRUE(cppfig::IsInvalidArgument(errors[0]));
+        EXPECT_TRUE(errors[0].message().starts_with(paths[3] + ": "));
+    }
+    EXPECT_EQ(configs[5]->Get<settings::AppPort>(), 9005);
+    EXPECT_EQ(configs[0]->Get<settings::AppPort>(), 8080);
+    EXPECT_TRUE(std::filesystem::exists(paths[7]));
+
+    for (const auto& path : paths) {
+        std::filesystem::remove(path);
+    }
+}
+
 TEST_F(ConfigurationIntegrationTest, EnvironmentVariableParseFailure)
 {
     // Test when environment variable cannot be parsed
@@ -472,6 +1361,16 @@ TEST_F(ConfigurationIntegrationTest, GetDefaults)
     EXPECT_EQ(defaults["app"]["name"], "TestApp");
 }
 
+TEST_F(ConfigurationIntegrationTest, DefaultsSharedAcrossInstances)
+{
+    using Schema = ConfigSchema<settings::AppName, settings::AppPort>;
+    Configuration<Schema> first(file_path_);
+    Configuration<Schema> second(file_path_ + "_other");
+
+    EXPECT_EQ(&first.GetDefaults(), &second.GetDefaults());
+    EXPECT_EQ(second.GetDefaults()["app"]["port"], 8080);
+}
+
 TEST_F(ConfigurationIntegrationTest, SaveCreatesParentDirectories)
 {
     const std::string nested_path = file_path_ + "_nested/subdir/config.json";
@@ -525,6 +1424,75 @@ TEST_F(ConfigurationIntegrationTest, ReadFileNotFound)
     EXPECT_TRUE(cppfig::IsNotFound(result.status()));
 }
 
+/// @brief Serializer with only the stream entry point (no ParseBuffer).
+struct StreamOnlySerializer {
+    using data_type = Value;
+    static auto Parse(std::istream& is) -> StatusOr<Value> { return ConfSerializer::Parse(is); }
+    static auto Stringify(const Value& data) -> std::string { return ConfSerializer::Stringify(data); }
+};
+
+TEST_F(ConfigurationIntegrationTest, ReadFileUsesBufferParser)
+{
+    static_assert(HasParseBuffer<ConfSerializer>);
+    static_assert(HasParseBuffer<JsonSerializer>);
+    static_assert(!HasParseBuffer<StreamOnlySerializer>);
+
+    {
+        std::ofstream file(file_path_);
+        file << "app.name = Buffered\napp.port = 9000\n";
+    }
+
+    auto buffered = ReadFile<ConfSerializer>(file_path_);
+    auto streamed = ReadFile<StreamOnlySerializer>(file_path_);
+    ASSERT_TRUE(buffered.ok());
+    ASSERT_TRUE(streamed.ok());
+    EXPECT_EQ(*buffered, *streamed);
+    EXPECT_EQ((*buffered)["app"]["name"], "Buffered");
+}
+
+TEST_F(ConfigurationIntegrationTest, ReadFileMapsLargeFiles)
+{
+    {
+        std::ofstream file(file_path_);
+        for (int i = 0; file.tellp() < static_cast<std::streamoff>(detail::FileContents::k_mmap_threshold); ++i) {
+            file << "section.key" << i << " = " << i << "\n";
+        }
+    }
+
+    auto contents = detail::FileContents::Open(file_path_);
+    ASSERT_TRUE(contents.ok());
+    EXPECT_TRUE(contents->IsMapped());
+    EXPECT_GE(contents->View().size(), detail::FileContents::k_mmap_threshold);
+
+    // Copied reads never map, so a concurrent truncation cannot fault the parser
+    auto copied = detail::FileContents::Open(file_path_, FileRead::kCopied);
+    ASSERT_TRUE(copied.ok());
+    EXPECT_FALSE(copied->IsMapped());
+    EXPECT_EQ(copied->View(), contents->View());
+
+    auto result = ReadFile<ConfSerializer>(file_path_);
+    ASSERT_TRUE(result.ok());
+    EXPECT_EQ((*result)["section"]["key0"], 0);
+    EXPECT_EQ((*result)["section"]["key1000"], 1000);
+}
+
+TEST_F(ConfigurationIntegrationTest, ReadFileSmallFileIsNotMapped)
+{
+    {
+        std::ofstream file(file_path_);
+        file << "a = 1\n";
+    }
+
+    auto contents = detail::FileContents::Open(file_path_);
+    ASSERT_TRUE(contents.ok());
+    EXPECT_FALSE(contents->IsMapped());
+    EXPECT_EQ(contents->View(), "a = 1\n");
+
+    // Moving keeps the view pointing at the moved-to buffer
+    auto moved = *std::move(contents);
+    EXPECT_EQ(moved.View(), "a = 1\n");
+}
+
 TEST_F(ConfigurationIntegrationTest, WriteFileToInvalidPath)
 {
     // Test WriteFile to a path that cannot be opened (directory doesn't exist and path is invalid)
@@ -568,6 +1536,25 @@ TEST_F(ConfigurationIntegrationTest, FileValueSuccessfulParse)
     EXPECT_EQ(name, "FileApp");
 }
 
+TEST_F(ConfigurationIntegrationTest, SchemaMigrationKeepsScalarBlockingPath)
+{
+    // "app" is a scalar, so app.port is a modification of "app", not a new setting
+    {
+        std::ofstream file(file_path_);
+        file << R"({"app": 5})";
+    }
+
+    using Schema = ConfigSchema<settings::AppPort>;
+    Configuration<Schema, JsonSerializer> config(file_path_);
+    ASSERT_TRUE(config.Load().ok());
+
+    EXPECT_EQ(config.Get<settings::AppPort>(), 8080);
+    const Value* app = config.GetFileValues().Find("app");
+    ASSERT_NE(app, nullptr);
+    EXPECT_EQ(*app, Value(5));
+    EXPECT_FALSE(config.IsDirty());
+}
+
 TEST_F(ConfigurationIntegrationTest, SchemaMigrationAddsMultipleSettings)
 {
     // Create a config file with only one setting (covers migration loop lines 164-166)
@@ -768,6 +1755,38 @@ TEST_F(ConfigurationIntegrationTest, MultiThreadedEnvVarParseFailure)
     unsetenv("TEST_SERVER_PORT");
 }
 
+TEST_F(ConfigurationIntegrationTest, FileValueParseFailureWarnsOncePerGeneration)
+{
+    {
+        std::ofstream file(file_path_);
+        file << R"({"app": {"name": "App", "port": "not_an_int"}})";
+    }
+
+    using Schema = ConfigSchema<settings::AppName, settings::AppPort>;
+    Configuration<Schema, JsonSerializer> config(file_path_);
+    ASSERT_TRUE(config.Load().ok());
+
+    auto count_warnings = [](const std::string& output) {
+        std::size_t count = 0;
+        for (auto pos = output.find("app.port"); pos != std::string::npos; pos = output.find("app.port", pos + 1)) {
+            ++count;
+        }
+        return count;
+    };
+
+    ::testing::internal::CaptureStderr();
+    EXPECT_EQ(config.Get<settings::AppPort>(), 8080);
+    EXPECT_EQ(config.Get<settings::AppPort>(), 8080);
+    EXPECT_EQ(count_warnings(::testing::internal::GetCapturedStderr()), 1U);
+
+    // A new generation reports the still-invalid value again
+    ASSERT_TRUE(config.Set<settings::AppName>("Other").ok());
+    ::testing::internal::CaptureStderr();
+    EXPECT_EQ(config.Get<settings::AppPort>(), 8080);
+    EXPECT_EQ(config.Get<settings::AppPort>(), 8080);
+    EXPECT_EQ(count_warnings(::testing::internal::GetCapturedStderr()), 1U);
+}
+
 TEST_F(ConfigurationIntegrationTest, MultiThreadedFileValueParseFailure)
 {
     {
@@ -932,6 +1951,31 @@ TEST_F(ConfigurationIntegrationTest, ValidateAllStopsOnFirstError)
     EXPECT_NE(std::string(status.message()).find("val.a"), std::string::npos);
 }
 
+TEST_F(ConfigurationIntegrationTest, ValidateAllCollectsEveryFailure)
+{
+    using Schema3V = ConfigSchema<ValidatedA, settings::AppName, ValidatedB>;
+
+    {
+        std::ofstream file(file_path_);
+        file << R"({"app": {"name": "x"}, "val": {"a": 999, "b": 0}})";
+    }
+
+    Configuration<Schema3V, JsonSerializer> config(file_path_);
+    ASSERT_TRUE(config.Load().ok());
+
+    for (auto policy : { ExecutionPolicy::kSequential, ExecutionPolicy::kParallel }) {
+        auto failures = config.ValidateAll(policy);
+        ASSERT_EQ(failures.size(), 2U);
+        EXPECT_EQ(failures[0].code(), StatusCode::kInvalidArgument);
+        EXPECT_EQ(failures[0].message(), "val.a: Value 999 exceeds maximum 100");
+        EXPECT_EQ(failures[1].message(), "val.b: Value 0 is less than minimum 1");
+    }
+
+    ASSERT_TRUE(config.Set<ValidatedA>(50).ok());
+    ASSERT_TRUE(config.Set<ValidatedB>(50).ok());
+    EXPECT_TRUE(config.ValidateAll(ExecutionPolicy::kParallel).empty());
+}
+
 TEST_F(ConfigurationIntegrationTest, SingleThreadedSaveCreatesDeepNestedDirectories)
 {
     const std::string nested = file_path_ + "_deep/a/b/c/config.json";
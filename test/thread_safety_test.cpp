@@ -4,11 +4,13 @@
 #include <gtest/gtest.h>
 
 #include <atomic>
+#include <chrono>
 #include <cmath>
 #include <cstdlib>
 #include <filesystem>
 #include <fstream>
 #include <latch>
+#include <memory>
 #include <string>
 #include <string_view>
 #include <thread>
@@ -322,6 +324,39 @@ TEST_F(ThreadSafetyTest, ConcurrentDiffAndValidateAllWithWrites)
     EXPECT_TRUE(config.ValidateAll().ok());
 }
 
+TEST_F(ThreadSafetyTest, ParallelValidateAllWithWrites)
+{
+    ThreadSafeConfig config(file_path_);
+    ASSERT_TRUE(config.Load().ok());
+
+    constexpr int k_iters = 200;
+
+    std::latch start_latch(2);
+    std::atomic<int> failures { 0 };
+    std::vector<std::thread> threads;
+
+    threads.emplace_back([&] {
+        start_latch.arrive_and_wait();
+        for (int i = 0; i < k_iters * 10; ++i) {
+            (void)config.Set<settings::Counter>(i);
+            (void)config.Set<settings::ValidatedPort>(1024 + (i % 60000));
+        }
+    });
+
+    threads.emplace_back([&] {
+        start_latch.arrive_and_wait();
+        for (int i = 0; i < k_iters; ++i) {
+            failures += static_cast<int>(config.ValidateAll(cppfig::ExecutionPolicy::kParallel).size());
+        }
+    });
+
+    for (auto& th : threads) {
+        th.join();
+    }
+
+    EXPECT_EQ(failures.load(), 0);
+}
+
 TEST_F(ThreadSafetyTest, ConcurrentLoadAndSave)
 {
     // Create a valid initial file
@@ -680,6 +715,725 @@ TEST_F(ThreadSafetyTest, DefaultPolicyIsSingleThreaded)
     EXPECT_TRUE(config.Save().ok());
 }
 
+using SnapshotConfig = Configuration<TestSchema, JsonSerializer, SnapshotPolicy>;
+
+TEST_F(ThreadSafetyTest, SnapshotPolicyBasicOperations)
+{
+    SnapshotConfig config(file_path_);
+    ASSERT_TRUE(config.Load().ok());
+
+    EXPECT_EQ(config.Get<settings::Counter>(), 0);
+    EXPECT_EQ(config.Get<settings::Name>(), "default");
+
+    ASSERT_TRUE(config.Set<settings::Counter>(7).ok());
+    EXPECT_EQ(config.Get<settings::Counter>(), 7);
+    EXPECT_EQ(config.GetFileValues()["app"]["counter"], 7);
+
+    EXPECT_FALSE(config.Set<settings::ValidatedPort>(0).ok());
+    EXPECT_TRUE(config.Diff().HasDifferences());
+    EXPECT_TRUE(config.ValidateAll().ok());
+    ASSERT_TRUE(config.Save().ok());
+
+    SnapshotConfig reloaded(file_path_);
+    ASSERT_TRUE(reloaded.Load().ok());
+    EXPECT_EQ(reloaded.Get<settings::Counter>(), 7);
+}
+
+TEST_F(ThreadSafetyTest, SnapshotCellNestedReadsKeepOuterSnapshotAlive)
+{
+    auto initial = std::make_shared<const int>(1);
+    const std::weak_ptr<const int> watched = initial;
+    SnapshotCell<int> outer(std::move(initial));
+
+    // More cells than the per-thread table holds, so some share the outer cell's entry
+    std::vector<std::unique_ptr<SnapshotCell<int>>> others;
+    for (int i = 0; i < 40; ++i) {
+        others.push_back(std::make_unique<SnapshotCell<int>>(std::make_shared<const int>(100 + i)));
+    }
+
+    const int seen = outer.Read([&](const int& value) {
+        outer.Publish(std::make_shared<const int>(2));
+        int sum = 0;
+        for (const auto& cell : others) {
+            sum += cell->Read([](const int& other) { return other; });
+        }
+        EXPECT_EQ(sum, (100 * 40) + (39 * 40 / 2));
+        EXPECT_EQ(outer.Read([](const int& inner) { return inner; }), 2);
+        EXPECT_FALSE(watched.expired());
+        return value;
+    });
+
+    EXPECT_EQ(seen, 1);
+    EXPECT_EQ(outer.Read([](const int& value) { return value; }), 2);
+    EXPECT_TRUE(watched.expired());
+}
+
+TEST_F(ThreadSafetyTest, SnapshotPolicyConcurrentReadsAndWrites)
+{
+    SnapshotConfig config(file_path_);
+    ASSERT_TRUE(config.Load().ok());
+
+    constexpr int k_num_readers = 6;
+    constexpr int k_num_writes = 2'000;
+    constexpr int k_reads_per_thread = 20'000;
+
+    std::latch start_latch(k_num_readers + 1);
+    std::vector<std::thread> threads;
+    std::atomic<int> error_count { 0 };
+
+    threads.reserve(k_num_readers + 1);
+    threads.emplace_back([&] {
+        start_latch.arrive_and_wait();
+        for (int i = 1; i <= k_num_writes; ++i) {
+            if (!config.Set<settings::Counter>(i).ok()) {
+                error_count.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+    });
+
+    // Each reader must observe a non-decreasing counter: snapshots are published in order
+    for (int r = 0; r < k_num_readers; ++r) {
+        threads.emplace_back([&] {
+            start_latch.arrive_and_wait();
+            int last_seen = 0;
+            for (int i = 0; i < k_reads_per_thread; ++i) {
+                const int counter = config.Get<settings::Counter>();
+                if (counter < last_seen || counter > k_num_writes) {
+                    error_count.fetch_add(1, std::memory_order_relaxed);
+                }
+                last_seen = counter;
+            }
+        });
+    }
+
+    for (auto& th : threads) {
+        th.join();
+    }
+
+    EXPECT_EQ(error_count.load(), 0) << "Readers observed out-of-order or invalid snapshots";
+    EXPECT_EQ(config.Get<settings::Counter>(), k_num_writes);
+}
+
+TEST_F(ThreadSafetyTest, SnapshotPolicyConcurrentReload)
+{
+    {
+        SnapshotConfig config(file_path_);
+        ASSERT_TRUE(config.Load().ok());
+        ASSERT_TRUE(config.Set<settings::Counter>(55).ok());
+        ASSERT_TRUE(config.Save().ok());
+    }
+
+    SnapshotConfig config(file_path_);
+    ASSERT_TRUE(config.Load().ok());
+
+    constexpr int k_iters = 500;
+
+    std::latch start_latch(3);
+    std::vector<std::thread> threads;
+    std::atomic<int> error_count { 0 };
+
+    threads.reserve(3);
+    for (int t = 0; t < 2; ++t) {
+        threads.emplace_back([&] {
+            start_latch.arrive_and_wait();
+            for (int i = 0; i < k_iters; ++i) {
+                (void)config.Load();
+            }
+        });
+    }
+
+    threads.emplace_back([&] {
+        start_latch.arrive_and_wait();
+        for (int i = 0; i < k_iters * 10; ++i) {
+            if (config.Get<settings::Counter>() != 55) {
+                error_count.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+    });
+
+    for (auto& th : threads) {
+        th.join();
+    }
+
+    EXPECT_EQ(error_count.load(), 0);
+    EXPECT_EQ(config.Get<settings::Counter>(), 55);
+}
+
+TEST_F(ThreadSafetyTest, LayeredConcurrentLoad)
+{
+    {
+        SnapshotConfig config(file_path_);
+        ASSERT_TRUE(config.Load().ok());
+        ASSERT_TRUE(config.Set<settings::Counter>(55).ok());
+        ASSERT_TRUE(config.Save().ok());
+    }
+
+    auto overlay = Value::Object();
+    overlay.SetAtPath("app.name", "layered");
+    LayeredConfiguration<TestSchema, JsonSerializer, SnapshotPolicy> config({
+        ConfigLayer::File(file_path_, true),
+        ConfigLayer::Values("overlay", overlay),
+    });
+    ASSERT_TRUE(config.Load().ok());
+
+    constexpr int k_iters = 200;
+
+    std::latch start_latch(3);
+    std::vector<std::thread> threads;
+    std::atomic<int> error_count { 0 };
+
+    threads.reserve(3);
+    for (int t = 0; t < 2; ++t) {
+        threads.emplace_back([&] {
+            start_latch.arrive_and_wait();
+            for (int i = 0; i < k_iters; ++i) {
+                if (!config.Load(ExecutionPolicy::kParallel).ok()) {
+                    error_count.fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+        });
+    }
+
+    threads.emplace_back([&] {
+        start_latch.arrive_and_wait();
+        for (int i = 0; i < k_iters * 10; ++i) {
+            if (config.Get<settings::Counter>() != 55 || config.Get<settings::Name>() != "layered"
+                || config.LayerOf<settings::Name>() != 1) {
+                error_count.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+    });
+
+    for (auto& th : threads) {
+        th.join();
+    }
+
+    EXPECT_EQ(error_count.load(), 0);
+}
+
+TEST_F(ThreadSafetyTest, SnapshotPolicyIndependentInstances)
+{
+    // Two cells of the same state type read alternately from one thread
+    // share that thread's snapshot cache and must not leak values.
+    const std::string other_path = file_path_ + ".other";
+    SnapshotConfig first(file_path_);
+    SnapshotConfig second(other_path);
+    ASSERT_TRUE(first.Set<settings::Counter>(1).ok());
+    ASSERT_TRUE(second.Set<settings::Counter>(2).ok());
+
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_EQ(first.Get<settings::Counter>(), 1);
+        EXPECT_EQ(second.Get<settings::Counter>(), 2);
+    }
+}
+
+using ShardedConfig = Configuration<TestSchema, JsonSerializer, ShardedPolicy<4>>;
+
+TEST_F(ThreadSafetyTest, ShardedPolicyBasicOperations)
+{
+    ShardedConfig config(file_path_);
+    ASSERT_TRUE(config.Load().ok());
+
+    ASSERT_TRUE(config.Set<settings::Counter>(7).ok());
+    ASSERT_TRUE(config.Set<settings::ValidatedPort>(9000).ok());
+    EXPECT_EQ(config.Get<settings::Counter>(), 7);
+    EXPECT_EQ(config.Get<settings::ValidatedPort>(), 9000);
+    EXPECT_EQ(config.GetFileValues()["server"]["port"], 9000);
+
+    EXPECT_FALSE(config.Set<settings::ValidatedPort>(0).ok());
+    EXPECT_TRUE(config.IsDirty());
+    EXPECT_TRUE(config.ValidateAll().ok());
+    ASSERT_TRUE(config.Save().ok());
+
+    ShardedConfig reloaded(file_path_);
+    ASSERT_TRUE(reloaded.Load().ok());
+    EXPECT_EQ(reloaded.Get<settings::Counter>(), 7);
+    EXPECT_EQ(reloaded.Fingerprint(), config.Fingerprint());
+}
+
+TEST_F(ThreadSafetyTest, ShardedPolicyConcurrentSectionWrites)
+{
+    ShardedConfig config(file_path_);
+    ASSERT_TRUE(config.Load().ok());
+
+    std::atomic<int> port_calls { 0 };
+    config.Subscribe<settings::ValidatedPort>([&](const int& /*value*/) { port_calls.fetch_add(1); });
+
+    constexpr int k_num_readers = 4;
+    constexpr int k_num_writes = 2'000;
+
+    std::latch start_latch(k_num_readers + 3);
+    std::vector<std::thread> threads;
+    std::atomic<int> error_count { 0 };
+    std::atomic<bool> done { false };
+
+    // Writers of two sections, plus a whole-state reader that locks every stripe
+    threads.emplace_back([&] {
+        start_latch.arrive_and_wait();
+        for (int i = 1; i <= k_num_writes; ++i) {
+            if (!config.Set<settings::Counter>(i).ok()) {
+                error_count.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+    });
+    threads.emplace_back([&] {
+        start_latch.arrive_and_wait();
+        for (int i = 1; i <= k_num_writes; ++i) {
+            if (!config.Set<settings::ValidatedPort>(i).ok()) {
+                error_count.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+    });
+    threads.emplace_back([&] {
+        start_latch.arrive_and_wait();
+        while (!done.load(std::memory_order_relaxed)) {
+            if (!config.ValidateAll().ok()) {
+                error_count.fetch_add(1, std::memory_order_relaxed);
+            }
+            (void)config.Diff();
+        }
+    });
+
+    for (int r = 0; r < k_num_readers; ++r) {
+        threads.emplace_back([&] {
+            start_latch.arrive_and_wait();
+            int last_counter = 0;
+            while (!done.load(std::memory_order_relaxed)) {
+                const int counter = config.Get<settings::Counter>();
+                const int port = config.Get<settings::ValidatedPort>();
+                if (counter < last_counter || counter > k_num_writes || port < 1 || port > 8080) {
+                    error_count.fetch_add(1, std::memory_order_relaxed);
+                }
+                last_counter = counter;
+                if (config.Get<settings::Name>() != "default") {
+                    error_count.fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+        });
+    }
+
+    threads[0].join();
+    threads[1].join();
+    done.store(true, std::memory_order_relaxed);
+    for (std::size_t i = 2; i < threads.size(); ++i) {
+        threads[i].join();
+    }
+
+    EXPECT_EQ(error_count.load(), 0);
+    EXPECT_EQ(config.Get<settings::Counter>(), k_num_writes);
+    EXPECT_EQ(config.Get<settings::ValidatedPort>(), k_num_writes);
+    EXPECT_EQ(config.GetFileValues()["app"]["counter"], k_num_writes);
+    EXPECT_EQ(config.GetFileValues()["server"]["port"], k_num_writes);
+    EXPECT_EQ(port_calls.load(), k_num_writes);
+}
+
+TEST_F(ThreadSafetyTest, TransactionNeverExposesTornState)
+{
+    ThreadSafeConfig config(file_path_);
+    ASSERT_TRUE(config.Load().ok());
+
+    constexpr int k_num_readers = 4;
+    constexpr int k_num_commits = 2'000;
+
+    std::latch start_latch(k_num_readers + 1);
+    std::atomic<bool> writer_done { false };
+    std::vector<std::thread> threads;
+    std::atomic<int> error_count { 0 };
+
+    threads.reserve(k_num_readers + 1);
+    threads.emplace_back([&] {
+        start_latch.arrive_and_wait();
+        for (int i = 1; i <= k_num_commits; ++i) {
+            auto status = config.Transaction()
+                              .Set<settings::Counter>(i)
+                              .Set<settings::Ratio>(static_cast<double>(i))
+                              .Commit();
+            if (!status.ok()) {
+                error_count.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+        writer_done.store(true, std::memory_order_release);
+    });
+
+    // Both settings only ever grow together: reading Counter first, Ratio
+    // can never lag behind it unless a commit was observed half-applied.
+    for (int r = 0; r < k_num_readers; ++r) {
+        threads.emplace_back([&] {
+            start_latch.arrive_and_wait();
+            while (!writer_done.load(std::memory_order_acquire)) {
+                const int counter = config.Get<settings::Counter>();
+                const double ratio = config.Get<settings::Ratio>();
+                if (counter > 0 && ratio < static_cast<double>(counter)) {
+                    error_count.fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+        });
+    }
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(error_count.load(), 0);
+    EXPECT_EQ(config.Get<settings::Counter>(), k_num_commits);
+}
+
+TEST_F(ThreadSafetyTest, ConcurrentSavesNeverExposePartialFile)
+{
+    ThreadSafeConfig config(file_path_);
+    ASSERT_TRUE(config.Load().ok());
+
+    constexpr int k_num_writers = 4;
+    constexpr int k_num_saves = 100;
+
+    std::latch start_latch(k_num_writers + 1);
+    std::atomic<int> writers_left { k_num_writers };
+    std::vector<std::thread> threads;
+    std::atomic<int> error_count { 0 };
+
+    threads.reserve(k_num_writers + 1);
+    for (int w = 0; w < k_num_writers; ++w) {
+        threads.emplace_back([&, w] {
+            start_latch.arrive_and_wait();
+            for (int i = 0; i < k_num_saves; ++i) {
+                if (!config.Set<settings::Counter>(w * k_num_saves + i).ok() || !config.Save().ok()) {
+                    error_count.fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+            writers_left.fetch_sub(1, std::memory_order_release);
+        });
+    }
+
+    // The file is replaced by rename, so every read sees a complete document
+    threads.emplace_back([&] {
+        start_latch.arrive_and_wait();
+        while (writers_left.load(std::memory_order_acquire) > 0) {
+            if (!ReadFile<JsonSerializer>(file_path_).ok()) {
+                error_count.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+    });
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(error_count.load(), 0);
+    EXPECT_FALSE(config.IsDirty());
+
+    ThreadSafeConfig reloaded(file_path_);
+    ASSERT_TRUE(reloaded.Load().ok());
+    EXPECT_EQ(reloaded.Get<settings::Counter>(), config.Get<settings::Counter>());
+}
+
+TEST_F(ThreadSafetyTest, SharedValueCopiesMutatedConcurrently)
+{
+    auto shared = Value::Object();
+    for (int i = 0; i < 50; ++i) {
+        shared.SetAtPath("section" + std::to_string(i) + ".value", i);
+    }
+
+    constexpr int k_num_threads = 8;
+    constexpr int k_iterations = 500;
+
+    std::latch start_latch(k_num_threads);
+    std::vector<std::thread> threads;
+    std::atomic<int> error_count { 0 };
+
+    // Every thread copies the same tree and mutates its copy; the copies
+    // share nodes, so each write must clone instead of touching the original.
+    threads.reserve(k_num_threads);
+    for (int t = 0; t < k_num_threads; ++t) {
+        threads.emplace_back([&, t] {
+            start_latch.arrive_and_wait();
+            for (int i = 0; i < k_iterations; ++i) {
+                Value copy = shared;
+                const std::string path = "section" + std::to_string(i % 50) + ".value";
+                copy.SetAtPath(path, t * 1000 + i);
+                if (copy.GetAtPath(path).value() != Value(t * 1000 + i) || shared.GetAtPath(path).value() != Value(i % 50)) {
+                    error_count.fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(error_count.load(), 0);
+}
+
+TEST_F(ThreadSafetyTest, CachedSettingConcurrentWrites)
+{
+    ThreadSafeConfig config(file_path_);
+    ASSERT_TRUE(config.Load().ok());
+
+    constexpr int k_num_readers = 4;
+    constexpr int k_num_writes = 2'000;
+
+    std::latch start_latch(k_num_readers + 1);
+    std::atomic<bool> writer_done { false };
+    std::vector<std::thread> threads;
+    std::atomic<int> error_count { 0 };
+
+    threads.reserve(k_num_readers + 1);
+    threads.emplace_back([&] {
+        start_latch.arrive_and_wait();
+        for (int i = 1; i <= k_num_writes; ++i) {
+            if (!config.Set<settings::Counter>(i).ok()) {
+                error_count.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+        writer_done.store(true, std::memory_order_release);
+    });
+
+    // One handle per thread; each must converge on the final value
+    for (int r = 0; r < k_num_readers; ++r) {
+        threads.emplace_back([&] {
+            auto counter = config.Cached<settings::Counter>();
+            start_latch.arrive_and_wait();
+            int last_seen = 0;
+            while (!writer_done.load(std::memory_order_acquire)) {
+                const int value = *counter;
+                if (value < last_seen || value > k_num_writes) {
+                    error_count.fetch_add(1, std::memory_order_relaxed);
+                }
+                last_seen = value;
+            }
+            if (*counter != k_num_writes) {
+                error_count.fetch_add(1, std::memory_order_relaxed);
+            }
+        });
+    }
+
+    for (auto& th : threads) {
+        th.join();
+    }
+
+    EXPECT_EQ(error_count.load(), 0);
+}
+
+TEST_F(ThreadSafetyTest, SubscribeUnderConcurrentWrites)
+{
+    ThreadSafeConfig config(file_path_);
+    ASSERT_TRUE(config.Load().ok());
+
+    std::atomic<int> counter_calls { 0 };
+    std::atomic<int> name_calls { 0 };
+    config.Subscribe<settings::Counter>([&](const int& /*value*/) { counter_calls.fetch_add(1); });
+    config.Subscribe<settings::Name>([&](const std::string& /*value*/) { name_calls.fetch_add(1); });
+
+    constexpr int k_num_threads = 4;
+    constexpr int k_writes_per_thread = 250;
+
+    std::latch start_latch(k_num_threads);
+    std::vector<std::thread> threads;
+    threads.reserve(k_num_threads);
+    for (int t = 0; t < k_num_threads; ++t) {
+        threads.emplace_back([&, t] {
+            start_latch.arrive_and_wait();
+            for (int i = 1; i <= k_writes_per_thread; ++i) {
+                // Every write stores a distinct value, so every write notifies
+                (void)config.Set<settings::Counter>(t * k_writes_per_thread + i);
+            }
+        });
+    }
+    for (auto& th : threads) {
+        th.join();
+    }
+
+    EXPECT_EQ(counter_calls.load(), k_num_threads * k_writes_per_thread);
+    EXPECT_EQ(name_calls.load(), 0);
+}
+
+/// @brief Waits until @p predicate holds or a generous timeout expires.
+template <typename Predicate>
+auto WaitFor(Predicate predicate) -> bool
+{
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (!predicate()) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    return true;
+}
+
+void WriteCounterFile(const std::string& path, int counter)
+{
+    std::ofstream file(path);
+    file << R"({"app": {"counter": )" << counter << "}}";
+}
+
+TEST_F(ThreadSafetyTest, WatcherReloadsOnFileChange)
+{
+    SnapshotConfig config(file_path_);
+    ASSERT_TRUE(config.Load().ok());
+
+    std::atomic<int> reloads { 0 };
+    ConfigWatcher watcher(config, [&reloads](const Status& status) {
+        if (status.ok()) {
+            reloads.fetch_add(1, std::memory_order_relaxed);
+        }
+    });
+    ASSERT_TRUE(watcher.Start().ok());
+    EXPECT_TRUE(watcher.IsRunning());
+    EXPECT_FALSE(watcher.Start().ok());
+
+    WriteCounterFile(file_path_, 42);
+    EXPECT_TRUE(WaitFor([&] { return config.Get<settings::Counter>() == 42; }));
+    EXPECT_GE(reloads.load(), 1);
+
+    watcher.Stop();
+    EXPECT_FALSE(watcher.IsRunning());
+}
+
+TEST_F(ThreadSafetyTest, WatcherPollingReloadsOnFileChange)
+{
+    ThreadSafeConfig config(file_path_);
+    ASSERT_TRUE(config.Load().ok());
+
+    ConfigWatcher watcher(config, {}, WatchOptions { WatchMode::kPolling, std::chrono::milliseconds(10) });
+    ASSERT_TRUE(watcher.Start().ok());
+
+    WriteCounterFile(file_path_, 123);
+    EXPECT_TRUE(WaitFor([&] { return config.Get<settings::Counter>() == 123; }));
+}
+
+TEST_F(ThreadSafetyTest, WatcherFollowsSymlinkSwap)
+{
+    // Layout of a Kubernetes ConfigMap mount: config.json -> ..data/config.json, ..data -> ..v1
+    namespace fs = std::filesystem;
+    const fs::path mount = fs::path(file_path_).replace_extension(".mount");
+    fs::remove_all(mount);
+    fs::create_directories(mount / "..v1");
+    fs::create_directories(mount / "..v2");
+    WriteCounterFile((mount / "..v1" / "config.json").string(), 1);
+    WriteCounterFile((mount / "..v2" / "config.json").string(), 2);
+    fs::create_directory_symlink("..v1", mount / "..data");
+    fs::create_symlink("..data/config.json", mount / "config.json");
+
+    SnapshotConfig config((mount / "config.json").string());
+    ASSERT_TRUE(config.Load().ok());
+    ASSERT_EQ(config.Get<settings::Counter>(), 1);
+
+    // A long poll interval: the reload must come from the inotify event on ..data
+    ConfigWatcher watcher(config, {}, WatchOptions { WatchMode::kAuto, std::chrono::seconds(3) });
+    ASSERT_TRUE(watcher.Start().ok());
+
+    const auto swapped = std::chrono::steady_clock::now();
+    fs::create_directory_symlink("..v2", mount / "..data_tmp");
+    fs::rename(mount / "..data_tmp", mount / "..data");
+    EXPECT_TRUE(WaitFor([&] { return config.Get<settings::Counter>() == 2; }));
+    EXPECT_LT(std::chrono::steady_clock::now() - swapped, std::chrono::milliseconds(2500));
+
+    watcher.Stop();
+    fs::remove_all(mount);
+}
+
+TEST_F(ThreadSafetyTest, WatcherWaitsForWriterToFinish)
+{
+    SnapshotConfig config(file_path_);
+    ASSERT_TRUE(config.Load().ok());
+
+    std::atomic<int> reloads { 0 };
+    std::atomic<int> failures { 0 };
+    ConfigWatcher watcher(
+        config,
+        [&reloads, &failures](const Status& status) {
+            reloads.fetch_add(1, std::memory_order_relaxed);
+            if (!status.ok()) {
+                failures.fetch_add(1, std::memory_order_relaxed);
+            }
+        },
+        WatchOptions { WatchMode::kAuto, std::chrono::milliseconds(10) });
+    ASSERT_TRUE(watcher.Start().ok());
+
+    // Write the file in two steps; the half-written file must never be loaded
+    {
+        std::ofstream file(file_path_, std::ios::trunc);
+        file << R"({"app": {"coun)";
+        file.flush();
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+        EXPECT_EQ(reloads.load(), 0);
+        file << R"(ter": 9}})";
+    }
+    EXPECT_TRUE(WaitFor([&] { return config.Get<settings::Counter>() == 9; }));
+    watcher.Stop();
+
+    EXPECT_EQ(failures.load(), 0);
+}
+
+TEST_F(ThreadSafetyTest, WatcherKeepsServingDuringInvalidReload)
+{
+    SnapshotConfig config(file_path_);
+    ASSERT_TRUE(config.Load().ok());
+    ASSERT_TRUE(config.Set<settings::Counter>(5).ok());
+
+    std::atomic<int> failures { 0 };
+    ConfigWatcher watcher(
+        config,
+        [&failures](const Status& status) {
+            if (!status.ok()) {
+                failures.fetch_add(1, std::memory_order_relaxed);
+            }
+        },
+        WatchOptions { WatchMode::kPolling, std::chrono::milliseconds(10) });
+    ASSERT_TRUE(watcher.Start().ok());
+
+    ::testing::internal::CaptureStderr();
+    {
+        std::ofstream file(file_path_);
+        file << R"({"server": {"port": 0}})";  // fails validation
+    }
+    EXPECT_TRUE(WaitFor([&] { return failures.load() > 0; }));
+    watcher.Stop();
+    auto stderr_output = ::testing::internal::GetCapturedStderr();
+
+    EXPECT_NE(stderr_output.find("Failed to reload"), std::string::npos);
+    EXPECT_EQ(config.Get<settings::Counter>(), 5);
+}
+
+TEST_F(ThreadSafetyTest, WatcherConcurrentReaders)
+{
+    SnapshotConfig config(file_path_);
+    ASSERT_TRUE(config.Load().ok());
+
+    ConfigWatcher watcher(config, {}, WatchOptions { WatchMode::kPolling, std::chrono::milliseconds(1) });
+    ASSERT_TRUE(watcher.Start().ok());
+
+    constexpr int k_num_readers = 4;
+    constexpr int k_num_files = 20;
+    std::atomic<bool> done { false };
+    std::atomic<int> error_count { 0 };
+    std::vector<std::thread> readers;
+    readers.reserve(k_num_readers);
+    for (int r = 0; r < k_num_readers; ++r) {
+        readers.emplace_back([&] {
+            int last_seen = 0;
+            while (!done.load(std::memory_order_acquire)) {
+                const int counter = config.Get<settings::Counter>();
+                if (counter < last_seen || counter > k_num_files) {
+                    error_count.fetch_add(1, std::memory_order_relaxed);
+                }
+                last_seen = counter;
+            }
+        });
+    }
+
+    for (int i = 1; i <= k_num_files; ++i) {
+        WriteCounterFile(file_path_, i);
+        EXPECT_TRUE(WaitFor([&] { return config.Get<settings::Counter>() == i; }));
+    }
+    done.store(true, std::memory_order_release);
+
+    for (auto& th : readers) {
+        th.join();
+    }
+    EXPECT_EQ(error_count.load(), 0);
+}
+
 namespace edge_settings {
 
     struct PortWithEnv {
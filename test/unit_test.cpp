@@ -2,6 +2,19 @@
 #include <cppfig/json.h>
 #include <cppfig/testing/mock.h>
 #include <gtest/gtest.h>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <mutex>
+#include <numbers>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 namespace cppfig::test {
 
@@ -73,6 +86,7 @@ TEST(ConfigTraitsTest, StringFromJson)
 {
     EXPECT_EQ(ConfigTraits<std::string>::Deserialize(Value("hello")), "hello");
     EXPECT_EQ(ConfigTraits<std::string>::Deserialize(Value(42)), std::nullopt);
+    EXPECT_EQ(ConfigTraits<std::string>::Deserialize(Value::Array(Value::ArrayType { "prod" })), std::nullopt);
 }
 
 // Additional traits tests for coverage
@@ -243,6 +257,66 @@ TEST(ValidatorTest, NonNegativeValidator)
     EXPECT_FALSE(validator(-1));
 }
 
+TEST(ValidatorTest, OperatorsComposeConcreteTypes)
+{
+    auto validator = (Min(1) && Max(10)) || Predicate<int>([](int v) { return v == 100; }, "Must be 100");
+    static_assert(ComposableValidator<decltype(validator)>);
+    static_assert(!std::is_same_v<decltype(validator), Validator<int>>);
+
+    EXPECT_TRUE(validator(5));
+    EXPECT_TRUE(validator(100));
+    auto result = validator(50);
+    EXPECT_FALSE(result);
+    EXPECT_EQ(result.error_message, "Must be 100");
+}
+
+TEST(ValidatorTest, AndReportsFirstFailure)
+{
+    auto validator = Range(1, 10) && Predicate<int>([](int v) { return v % 2 == 0; }, "Must be even");
+    EXPECT_EQ(validator(0).error_message, "Value 0 is less than minimum 1");
+    EXPECT_EQ(validator(11).error_message, "Value 11 exceeds maximum 10");
+    EXPECT_EQ(validator(3).error_message, "Must be even");
+    EXPECT_TRUE(validator(4));
+}
+
+TEST(ValidatorTest, AndEvaluatesEachOperandOnce)
+{
+    int lhs_calls = 0;
+    int rhs_calls = 0;
+    auto validator = Predicate<int>([&lhs_calls](int v) { return ++lhs_calls > 0 && v > 0; }, "Must be positive")
+        && Predicate<int>([&rhs_calls](int v) { return ++rhs_calls > 0 && v % 2 == 0; }, "Must be even");
+
+    EXPECT_EQ(validator(3).error_message, "Must be even");
+    EXPECT_EQ(lhs_calls, 1);
+    EXPECT_EQ(rhs_calls, 1);
+
+    EXPECT_EQ(validator(-2).error_message, "Must be positive");
+    EXPECT_EQ(lhs_calls, 2);
+    EXPECT_EQ(rhs_calls, 1);
+}
+
+TEST(ValidatorTest, OrSkipsSecondOperandWhenFirstPasses)
+{
+    int calls = 0;
+    auto validator = Min(0) || Predicate<int>([&calls](int /*v*/) { return ++calls > 0; }, "unreachable");
+    EXPECT_TRUE(validator(5));
+    EXPECT_EQ(calls, 0);
+    EXPECT_TRUE(validator(-5));
+    EXPECT_EQ(calls, 1);
+}
+
+TEST(ValidatorTest, ConcreteValidatorConvertsToTypeErased)
+{
+    Validator<std::string> validator = NotEmpty() && MaxLength(5);
+    EXPECT_TRUE(validator("hello"));
+    EXPECT_EQ(validator("").error_message, "Value must not be empty");
+    EXPECT_EQ(validator("hello world").error_message, "String length 11 exceeds maximum 5");
+
+    auto combined = validator && OneOf<std::string>({ "a", "b" });
+    EXPECT_TRUE(combined("a"));
+    EXPECT_FALSE(combined("c"));
+}
+
 struct TestStringSetting {
     static constexpr std::string_view path = "test.string";
     using value_type = std::string;
@@ -269,6 +343,13 @@ struct TestSettingWithValidator {
     static auto validator() -> Validator<int> { return Range(1, 100); }
 };
 
+struct TestSettingWithConcreteValidator {
+    static constexpr std::string_view path = "test.concrete";
+    using value_type = std::string;
+    static auto default_value() -> std::string { return "info"; }
+    static auto validator() { return NotEmpty() && OneOf<std::string>({ "debug", "info" }); }
+};
+
 TEST(SettingTest, SettingConcept)
 {
     static_assert(IsSetting<TestStringSetting>);
@@ -287,6 +368,7 @@ TEST(SettingTest, HasValidatorConcept)
 {
     static_assert(!HasValidator<TestStringSetting>);
     static_assert(HasValidator<TestSettingWithValidator>);
+    static_assert(HasValidator<TestSettingWithConcreteValidator>);
 }
 
 TEST(SettingTest, GetEnvOverrideHelper)
@@ -303,6 +385,16 @@ TEST(SettingTest, GetValidatorHelper)
     auto validator2 = GetSettingValidator<TestSettingWithValidator>();
     EXPECT_TRUE(validator2(50));
     EXPECT_FALSE(validator2(0));
+
+    auto validator3 = GetSettingValidator<TestSettingWithConcreteValidator>();
+    EXPECT_TRUE(validator3("debug"));
+    EXPECT_FALSE(validator3("trace"));
+}
+
+TEST(SettingTest, GetValidatorHelperBuildsOnce)
+{
+    EXPECT_EQ(&GetSettingValidator<TestSettingWithValidator>(), &GetSettingValidator<TestSettingWithValidator>());
+    EXPECT_EQ(&GetSettingValidator<TestSettingWithConcreteValidator>(), &GetSettingValidator<TestSettingWithConcreteValidator>());
 }
 
 using TestSchema = ConfigSchema<TestStringSetting, TestIntSetting, TestSettingWithValidator>;
@@ -335,6 +427,444 @@ TEST(ConfigSchemaTest, ForEachSetting)
     EXPECT_EQ(count, 3);
 }
 
+TEST(ConfigSchemaTest, IndexOf)
+{
+    static_assert(TestSchema::index_of<TestStringSetting> == 0);
+    static_assert(TestSchema::index_of<TestIntSetting> == 1);
+    static_assert(TestSchema::index_of<TestSettingWithValidator> == 2);
+}
+
+TEST(ConfigSchemaTest, FindIndex)
+{
+    static_assert(TestSchema::FindIndex(TestIntSetting::path) == TestSchema::index_of<TestIntSetting>);
+    for (std::size_t i = 0; i < TestSchema::size; ++i) {
+        EXPECT_EQ(TestSchema::FindIndex(TestSchema::GetPaths()[i]), i);
+    }
+    EXPECT_FALSE(TestSchema::FindIndex("test").has_value());
+    EXPECT_FALSE(TestSchema::FindIndex("").has_value());
+    EXPECT_FALSE(TestSchema::FindIndex("test.int.extra").has_value());
+    EXPECT_FALSE(ConfigSchema<>::FindIndex("test.int").has_value());
+}
+
+TEST(SlotTableTest, DefaultsBeforeResolve)
+{
+    const SlotTable<TestSchema> slots;
+    EXPECT_EQ(slots.Get<TestStringSetting>(), "default");
+    EXPECT_EQ(slots.Get<TestIntSetting>(), 42);
+    EXPECT_EQ(slots.Source<TestIntSetting>(), SlotSource::kDefault);
+}
+
+TEST(SlotTableTest, ResolveAllFromTree)
+{
+    auto tree = Value::Object();
+    tree.SetAtPath("test.string", Value("from_file"));
+    tree.SetAtPath("test.int", Value("not_an_int"));
+
+    SlotTable<TestSchema> slots;
+    slots.ResolveAll(tree);
+
+    EXPECT_EQ(slots.Get<TestStringSetting>(), "from_file");
+    EXPECT_EQ(slots.Source<TestStringSetting>(), SlotSource::kFile);
+    EXPECT_EQ(slots.Get<TestIntSetting>(), 42);
+    EXPECT_EQ(slots.Source<TestIntSetting>(), SlotSource::kInvalid);
+    EXPECT_EQ(slots.Get<TestSettingWithValidator>(), 50);
+    EXPECT_EQ(slots.Source<TestSettingWithValidator>(), SlotSource::kDefault);
+}
+
+TEST(SlotTableTest, Assign)
+{
+    SlotTable<TestSchema> slots;
+    slots.Assign<TestIntSetting>(7, SlotSource::kFile);
+    EXPECT_EQ(slots.Get<TestIntSetting>(), 7);
+    EXPECT_EQ(slots.Source<TestIntSetting>(), SlotSource::kFile);
+}
+
+struct TestPortsSetting {
+    static constexpr std::string_view path = "test.ports";
+    using value_type = std::vector<int>;
+    static auto default_value() -> std::vector<int> { return { 80 }; }
+};
+
+TEST(SlotTableTest, DeferredSlotsParseOnFirstRead)
+{
+    using PortsSchema = ConfigSchema<TestIntSetting, TestPortsSetting>;
+    static_assert(detail::kDeferredSlot<std::vector<int>>);
+    static_assert(!detail::kDeferredSlot<int>);
+
+    auto tree = Value::Object();
+    tree.SetAtPath("test.ports", ConfigTraits<std::vector<int>>::Serialize({ 443, 8443 }));
+
+    SlotTable<PortsSchema> slots;
+    EXPECT_FALSE(slots.HasFileValue<TestPortsSetting>());
+    slots.ResolveAll(tree);
+    EXPECT_TRUE(slots.HasFileValue<TestPortsSetting>());
+    EXPECT_FALSE(slots.HasFileValue<TestIntSetting>());
+
+    // The parsed value is memoized and shared by copies of the table
+    const auto copy = slots;
+    const auto& ports = slots.Get<TestPortsSetting>();
+    EXPECT_EQ(ports, (std::vector<int> { 443, 8443 }));
+    EXPECT_EQ(&copy.Get<TestPortsSetting>(), &ports);
+    EXPECT_EQ(slots.Source<TestPortsSetting>(), SlotSource::kFile);
+
+    tree.SetAtPath("test.ports", Value("not_a_list"));
+    slots.ResolveAll(tree);
+    EXPECT_TRUE(slots.HasFileValue<TestPortsSetting>());
+    EXPECT_EQ(slots.Source<TestPortsSetting>(), SlotSource::kInvalid);
+    EXPECT_EQ(slots.Get<TestPortsSetting>(), (std::vector<int> { 80 }));
+    EXPECT_EQ(copy.Get<TestPortsSetting>(), (std::vector<int> { 443, 8443 }));
+
+    slots.Assign<TestPortsSetting>({ 1 }, SlotSource::kFile);
+    EXPECT_EQ(slots.Get<TestPortsSetting>(), (std::vector<int> { 1 }));
+}
+
+TEST(EnvironmentTableTest, ResolvesOverridesOnce)
+{
+    using EnvSchema = ConfigSchema<TestIntSetting, TestSettingWithEnv>;
+    EnvironmentTable<EnvSchema> environment;
+    EXPECT_EQ(environment.Find<TestSettingWithEnv>(), nullptr);
+
+    setenv("TEST_ENV_SETTING", "from_env", 1);
+    environment.ResolveAll();
+    unsetenv("TEST_ENV_SETTING");
+
+    // The snapshot is kept until the next resolve
+    ASSERT_NE(environment.Find<TestSettingWithEnv>(), nullptr);
+    EXPECT_EQ(*environment.Find<TestSettingWithEnv>(), "from_env");
+    EXPECT_EQ(environment.Source<TestSettingWithEnv>(), SlotSource::kEnvironment);
+    EXPECT_EQ(environment.Find<TestIntSetting>(), nullptr);
+    EXPECT_EQ(environment.Source<TestIntSetting>(), SlotSource::kDefault);
+
+    environment.ResolveAll();
+    EXPECT_EQ(environment.Find<TestSettingWithEnv>(), nullptr);
+    EXPECT_EQ(environment.Source<TestSettingWithEnv>(), SlotSource::kDefault);
+}
+
+struct TestIntSettingWithEnv {
+    static constexpr std::string_view path = "test.int_env";
+    static constexpr std::string_view env_override = "TEST_INT_ENV_SETTING";
+    using value_type = int;
+    static auto default_value() -> int { return 1; }
+};
+
+TEST(EnvironmentTableTest, KeepsInvalidText)
+{
+    EnvironmentTable<ConfigSchema<TestIntSettingWithEnv>> environment;
+    setenv("TEST_INT_ENV_SETTING", "twelve", 1);
+    environment.ResolveAll();
+    unsetenv("TEST_INT_ENV_SETTING");
+
+    EXPECT_EQ(environment.Find<TestIntSettingWithEnv>(), nullptr);
+    EXPECT_EQ(environment.Source<TestIntSettingWithEnv>(), SlotSource::kInvalid);
+    EXPECT_EQ(environment.InvalidText<TestIntSettingWithEnv>(), "twelve");
+}
+
+TEST(SubscriptionTableTest, AddRemove)
+{
+    SubscriptionTable<TestSchema> table;
+    EXPECT_EQ(table.Size(), 0U);
+    EXPECT_TRUE(table.Subscribed().none());
+
+    int seen = 0;
+    auto id = table.Add<TestIntSetting>([&seen](const int& value) { seen = value; });
+    EXPECT_EQ(table.Size(), 1U);
+    EXPECT_TRUE(table.Subscribed()[TestSchema::index_of<TestIntSetting>]);
+    EXPECT_FALSE(table.Subscribed()[TestSchema::index_of<TestStringSetting>]);
+
+    for (const auto& callback : table.Callbacks<TestIntSetting>()) {
+        callback(5);
+    }
+    EXPECT_EQ(seen, 5);
+
+    EXPECT_TRUE(table.Remove(id));
+    EXPECT_FALSE(table.Remove(id));
+    EXPECT_EQ(table.Size(), 0U);
+}
+
+TEST(ConfSerializerTest, InfersTypes)
+{
+    auto result = ConfSerializer::ParseString(
+        "# comment\n"
+        "\n"
+        "b.yes = yes\n"
+        "b.off = off\n"
+        "i.neg = -42\n"
+        "i.plus = +7\n"
+        "i.big = 99999999999999999999\n"
+        "d.pi = 3.5\n"
+        "d.exp = -1e3\n"
+        "d.plus = +.25\n"
+        "s.quoted = \" padded \"\n"
+        "s.plain = hello world\n"
+        "s.empty =\n"
+        "s.partial = 12abc\n"
+        "s.sign = +-5\n");
+    ASSERT_TRUE(result.ok()) << result.status().message();
+    const auto& data = *result;
+
+    EXPECT_EQ(data["b"]["yes"], true);
+    EXPECT_EQ(data["b"]["off"], false);
+    EXPECT_EQ(data["i"]["neg"], -42);
+    EXPECT_EQ(data["i"]["plus"], 7);
+    EXPECT_EQ(data["i"]["big"], "99999999999999999999");
+    EXPECT_DOUBLE_EQ(data["d"]["pi"].Get<double>(), 3.5);
+    EXPECT_DOUBLE_EQ(data["d"]["exp"].Get<double>(), -1000.0);
+    EXPECT_DOUBLE_EQ(data["d"]["plus"].Get<double>(), 0.25);
+    EXPECT_EQ(data["s"]["quoted"], " padded ");
+    EXPECT_EQ(data["s"]["plain"], "hello world");
+    EXPECT_EQ(data["s"]["empty"], "");
+    EXPECT_EQ(data["s"]["partial"], "12abc");
+    EXPECT_EQ(data["s"]["sign"], "+-5");
+}
+
+TEST(ConfSerializerTest, BuildsNestedTreeAcrossSections)
+{
+    auto result = ConfSerializer::ParseString(
+        "a.b.x = 1\r\n"
+        "a.b.y = 2\r\n"
+        "a.c = 3\r\n"
+        "a.b.z = 4\r\n"
+        "top = 5\r\n"
+        "a.b.w.deep = 6");
+    ASSERT_TRUE(result.ok());
+    const auto& data = *result;
+
+    EXPECT_EQ(data["a"]["b"]["x"], 1);
+    EXPECT_EQ(data["a"]["b"]["y"], 2);
+    EXPECT_EQ(data["a"]["c"], 3);
+    EXPECT_EQ(data["a"]["b"]["z"], 4);
+    EXPECT_EQ(data["top"], 5);
+    EXPECT_EQ(data["a"]["b"]["w"]["deep"], 6);
+}
+
+TEST(ConfSerializerTest, LaterKeysReplaceLikeSetAtPath)
+{
+    auto result = ConfSerializer::ParseString(
+        "a.b = 1\n"
+        "a.b.c = 2\n"
+        "x.y.z = 3\n"
+        "x.y = 4\n"
+        "x.q = 5\n");
+    ASSERT_TRUE(result.ok());
+
+    auto expected = Value::Object();
+    expected.SetAtPath("a.b", 1);
+    expected.SetAtPath("a.b.c", 2);
+    expected.SetAtPath("x.y.z", 3);
+    expected.SetAtPath("x.y", 4);
+    expected.SetAtPath("x.q", 5);
+    EXPECT_EQ(*result, expected);
+}
+
+TEST(ConfSerializerTest, MissingEqualsReportsLine)
+{
+    auto result = ConfSerializer::ParseString("a = 1\n\nbroken line\n");
+    ASSERT_FALSE(result.ok());
+    EXPECT_TRUE(IsInvalidArgument(result.status()));
+    EXPECT_EQ(result.status().message(), "conf parse error: missing '=' on line 3");
+}
+
+TEST(ConfSerializerTest, RoundTrip)
+{
+    auto data = Value::Object();
+    data.SetAtPath("server.host", "localhost");
+    data.SetAtPath("server.port", 8080);
+    data.SetAtPath("server.ratio", 0.5);
+    data.SetAtPath("logging.enabled", true);
+    data.SetAtPath("logging.prefix", " # ");
+
+    std::istringstream stream(ConfSerializer::Stringify(data));
+    auto parsed = ConfSerializer::Parse(stream);
+    ASSERT_TRUE(parsed.ok());
+    EXPECT_EQ(*parsed, data);
+}
+
+TEST(ConfSerializerTest, StringifyKeepsDoublePrecision)
+{
+    auto data = Value::Object();
+    data.SetAtPath("math.pi", std::numbers::pi);
+    data.SetAtPath("math.one", 1.0);
+    data.SetAtPath("math.tiny", -2.5e-300);
+    data.SetAtPath("math.big", std::numeric_limits<std::int64_t>::min());
+
+    const auto text = ConfSerializer::Stringify(data);
+    EXPECT_EQ(text, "math.big = -9223372036854775808\nmath.one = 1.0\nmath.pi = 3.141592653589793\nmath.tiny = -2.5e-300\n");
+
+    auto parsed = ConfSerializer::ParseString(text);
+    ASSERT_TRUE(parsed.ok());
+    EXPECT_EQ(*parsed, data);
+}
+
+TEST(ConfSerializerTest, RoundTripsLists)
+{
+    auto result = ConfSerializer::ParseString(
+        "upstream.hosts = [a.example.com, \"b, c\", \" padded \"]\n"
+        "upstream.ports = [80, 443]\n"
+        "upstream.weights = [0.5, 1.5]\n"
+        "upstream.matrix = [[1, 2], [], [yes, 2.5]]\n"
+        "upstream.none = []\n"
+        "upstream.unbalanced = [a, [b]\n");
+    ASSERT_TRUE(result.ok());
+
+    const Value& hosts = (*result)["upstream"]["hosts"];
+    ASSERT_EQ(hosts.Size(), 3U);
+    EXPECT_EQ(hosts.At(1), "b, c");
+    EXPECT_EQ(hosts.At(2), " padded ");
+    EXPECT_EQ((*result)["upstream"]["ports"].Integers().size(), 2U);
+    EXPECT_EQ((*result)["upstream"]["weights"].Doubles().size(), 2U);
+    EXPECT_EQ((*result)["upstream"]["matrix"].At(2).At(0), true);
+    EXPECT_TRUE((*result)["upstream"]["none"].IsArray());
+    EXPECT_EQ((*result)["upstream"]["unbalanced"], "[a, [b]");
+
+    auto reparsed = ConfSerializer::ParseString(ConfSerializer::Stringify(*result));
+    ASSERT_TRUE(reparsed.ok());
+    EXPECT_EQ(*reparsed, *result);
+}
+
+TEST(ValueTest, ArraysPackHomogeneousNumbers)
+{
+    const auto integers = Value::Array(Value::ArrayType { 1, 2, 3 });
+    EXPECT_TRUE(integers.IsArray());
+    EXPECT_EQ(integers.Integers().size(), 3U);
+    EXPECT_EQ(integers, Value::Array(Value::IntegerArrayType { 1, 2, 3 }));
+    EXPECT_EQ(integers.Hash(), Value::Array(Value::IntegerArrayType { 1, 2, 3 }).Hash());
+
+    const auto doubles = Value::Array(Value::ArrayType { 0.5, 1.5 });
+    EXPECT_EQ(doubles.Doubles().size(), 2U);
+    EXPECT_TRUE(doubles.Integers().empty());
+
+    // Mixed integers and doubles keep each element's type
+    const auto mixed = Value::Array(Value::ArrayType { 1, 1.5 });
+    EXPECT_TRUE(mixed.Integers().empty());
+    EXPECT_TRUE(mixed.Doubles().empty());
+    EXPECT_TRUE(mixed.At(0).IsInteger());
+    EXPECT_NE(mixed, doubles);
+    EXPECT_EQ(mixed.Dump(), "[1,1.5]");
+
+    EXPECT_EQ(Value::Array(Value::IntegerArrayType {}), Value::Array());
+    EXPECT_EQ(Value(42).Size(), 0U);
+}
+
+TEST(ValueTest, ArrayAppendKeepsCanonicalForm)
+{
+    Value list;
+    list.Append(1);
+    list.Append(2);
+    EXPECT_EQ(list.Integers().size(), 2U);
+
+    const Value copy = list;
+    list.Append("three");
+    EXPECT_TRUE(list.Integers().empty());
+    EXPECT_EQ(list, Value::Array(Value::ArrayType { 1, 2, "three" }));
+    EXPECT_EQ(copy.Integers().size(), 2U);  // copy-on-write
+
+    Value shared = copy;
+    shared.Append(3);
+    EXPECT_EQ(shared.Size(), 3U);
+    EXPECT_EQ(copy.Size(), 2U);
+    EXPECT_FALSE(shared.SharesStorageWith(copy));
+}
+
+TEST(ValueTest, DumpFormatsNumbersAndEscapes)
+{
+    auto data = Value::Object();
+    data["ratio"] = 0.1;
+    data["whole"] = 2.0;
+    data["count"] = -7;
+    data["text"] = "a\"b\n";
+
+    EXPECT_EQ(data.Dump(), R"({"count":-7,"ratio":0.1,"text":"a\"b\n","whole":2.0})");
+    EXPECT_EQ(Value(std::numeric_limits<double>::infinity()).Dump(), "inf");
+}
+
+TEST(BinarySerializerTest, RoundTrip)
+{
+    auto data = Value::Object();
+    data.SetAtPath("server.host", "localhost");
+    data.SetAtPath("server.port", 8080);
+    data.SetAtPath("server.ratio", 0.5);
+    data.SetAtPath("server.offset", std::numeric_limits<std::int64_t>::min());
+    data.SetAtPath("logging.enabled", true);
+    data.SetAtPath("logging.verbose", false);
+    data.SetAtPath("logging.file", Value());
+    data.SetAtPath("backup.host", "localhost");
+    data.SetAtPath("lists.ports", Value::Array(Value::IntegerArrayType { 80, 443, -1 }));
+    data.SetAtPath("lists.weights", Value::Array(Value::DoubleArrayType { 0.5, 1e300 }));
+    data.SetAtPath("lists.mixed", Value::Array(Value::ArrayType { "localhost", 1, Value::Array(Value::IntegerArrayType { 2, 3 }), Value::Object() }));
+    data.SetAtPath("lists.empty", Value::Array());
+
+    auto parsed = BinarySerializer::ParseBuffer(BinarySerializer::Stringify(data));
+    ASSERT_TRUE(parsed.ok());
+    EXPECT_EQ(*parsed, data);
+
+    std::istringstream stream(BinarySerializer::Stringify(data));
+    auto streamed = BinarySerializer::Parse(stream);
+    ASSERT_TRUE(streamed.ok());
+    EXPECT_EQ(*streamed, data);
+}
+
+TEST(BinarySerializerTest, StoresRepeatedStringsOnce)
+{
+    auto data = Value::Object();
+    data.SetAtPath("primary.host", "db.example.com");
+    const auto single = BinarySerializer::Stringify(data);
+    data.SetAtPath("replica.host", "db.example.com");
+    const auto repeated = BinarySerializer::Stringify(data);
+
+    // Two more nodes ("replica" and its "host") and the "replica" key; "host" and the value are shared
+    EXPECT_EQ(repeated.size(), single.size() + (2 * BinarySerializer::k_node_size) + std::string_view("replica").size());
+}
+
+TEST(BinarySerializerTest, RecordsStamp)
+{
+    const SnapshotStamp stamp { .schema_hash = 1, .source_size = 2, .source_mtime = 3 };
+    const auto bytes = BinarySerializer::Stringify(Value::Object(), stamp);
+
+    auto recorded = BinarySerializer::ReadStamp(bytes);
+    ASSERT_TRUE(recorded.ok());
+    EXPECT_EQ(*recorded, stamp);
+
+    auto unstamped = BinarySerializer::ReadStamp(BinarySerializer::Stringify(Value::Object()));
+    ASSERT_TRUE(unstamped.ok());
+    EXPECT_EQ(*unstamped, SnapshotStamp {});
+}
+
+TEST(BinarySerializerTest, RejectsCorruptInput)
+{
+    auto data = Value::Object();
+    data.SetAtPath("server.host", "localhost");
+    const auto bytes = BinarySerializer::Stringify(data);
+
+    auto expect_rejected = [](const std::string& input) {
+        auto result = BinarySerializer::ParseBuffer(input);
+        ASSERT_FALSE(result.ok());
+        EXPECT_TRUE(IsInvalidArgument(result.status()));
+    };
+
+    expect_rejected("");
+    expect_rejected("server.host = localhost\n");
+    expect_rejected(bytes.substr(0, bytes.size() - 1));
+    expect_rejected(bytes + "x");
+
+    auto wrong_version = bytes;
+    wrong_version[4] = static_cast<char>(BinarySerializer::k_version + 1);
+    expect_rejected(wrong_version);
+
+    // String table offset of the "localhost" value pointing past the end
+    auto bad_offset = bytes;
+    bad_offset[BinarySerializer::k_header_size + (2 * BinarySerializer::k_node_size) + 16] = 0x7f;
+    expect_rejected(bad_offset);
+
+    // Root claiming more members than there are nodes
+    auto bad_count = bytes;
+    bad_count[BinarySerializer::k_header_size + 12] = 9;
+    expect_rejected(bad_count);
+
+    auto bad_type = bytes;
+    bad_type[BinarySerializer::k_header_size] = 42;
+    expect_rejected(bad_type);
+}
+
 TEST(JsonSerializerTest, ParseAndStringify)
 {
     const std::string json_str = R"({"key": "value", "number": 42})";
@@ -432,6 +962,97 @@ TEST(JsonSerializerTest, ParseStreamError)
     EXPECT_TRUE(cppfig::IsInvalidArgument(result.status()));
 }
 
+TEST(JsonSerializerTest, ParseMatchesDomConversion)
+{
+    const std::string json_str = R"({
+        "name": "café \"quoted\"\n",
+        "count": -12,
+        "big": 18446744073709551615,
+        "ratio": 0.25,
+        "enabled": false,
+        "missing": null,
+        "dup": 1,
+        "dup": {"replaced": true},
+        "list": [1, {"nested": [2, 3]}, "x"],
+        "server": {"host": "localhost", "limits": {"max": 10, "min": 1e-3}}
+    })";
+
+    auto result = JsonSerializer::ParseString(json_str);
+    ASSERT_TRUE(result.ok());
+    EXPECT_EQ(*result, JsonToValue(nlohmann::json::parse(json_str)));
+    const Value& list = (*result)["list"];
+    ASSERT_EQ(list.Size(), 3U);
+    EXPECT_EQ(list.At(0), 1);
+    EXPECT_EQ(list.At(1)["nested"].Integers().size(), 2U);
+    EXPECT_EQ(list.At(2), "x");
+
+    auto scalar = JsonSerializer::ParseString("  3.5 ");
+    ASSERT_TRUE(scalar.ok());
+    EXPECT_EQ(*scalar, 3.5);
+}
+
+TEST(JsonSerializerTest, ParseErrorMessageMatchesNlohmann)
+{
+    const std::string json_str = R"({"key": })";
+    std::string expected;
+    try {
+        [[maybe_unused]] auto json = nlohmann::json::parse(json_str);
+    }
+    catch (const nlohmann::json::parse_error& e) {
+        expected = std::string("JSON parse error: ") + e.what();
+    }
+
+    auto result = JsonSerializer::ParseString(json_str);
+    ASSERT_FALSE(result.ok());
+    EXPECT_EQ(result.status().message(), expected);
+}
+
+TEST(JsonSerializerTest, TrailingContentOnlyRejectedByParseString)
+{
+    const std::string json_str = R"({"key": 1} trailing)";
+
+    EXPECT_FALSE(JsonSerializer::ParseString(json_str).ok());
+
+    auto buffer = JsonSerializer::ParseBuffer(json_str);
+    ASSERT_TRUE(buffer.ok());
+    EXPECT_EQ((*buffer)["key"], 1);
+
+    std::istringstream stream(json_str);
+    auto streamed = JsonSerializer::Parse(stream);
+    ASSERT_TRUE(streamed.ok());
+    EXPECT_EQ(*streamed, *buffer);
+}
+
+TEST(JsonSerializerTest, StringifyMatchesDump)
+{
+    auto data = Value::Object();
+    data.SetAtPath("text.plain", "hello");
+    data.SetAtPath("text.escaped", std::string("tab\tquote\" back\\ nl\n bell\x07 caf\xc3\xa9"));
+    data.SetAtPath("ints.zero", 0);
+    data.SetAtPath("ints.min", std::numeric_limits<std::int64_t>::min());
+    data.SetAtPath("flags.on", true);
+    data.SetAtPath("flags.off", false);
+    data.SetAtPath("nothing", nullptr);
+    data.SetAtPath("empty", Value::Object());
+    data.SetAtPath("list", Value::Array());
+    data.SetAtPath("ints", Value::Array(Value::IntegerArrayType { 1, -2, 3 }));
+    data.SetAtPath("reals", Value::Array(Value::DoubleArrayType { 0.5, 1e16 }));
+    auto member = Value::Object();
+    member["host"] = "a";
+    data.SetAtPath("nested", Value::Array(Value::ArrayType { member, Value::Array(), Value::Array(Value::ArrayType { true, "x" }) }));
+
+    const std::vector<double> doubles = { 0.0, -0.0, 1.0, -2.5, 0.1, 3.14159, 100.0, 123456.0, 0.0001, 0.00001,
+                                          1e15, 1e16, 1.5e300, -2.5e-300, 123456789012345.6, 1.0 / 3.0 };
+    for (std::size_t i = 0; i < doubles.size(); ++i) {
+        data.SetAtPath("doubles.d" + std::to_string(i), doubles[i]);
+    }
+
+    for (const int indent : { 4, 2, 0, -1 }) {
+        EXPECT_EQ(JsonSerializer::Stringify(data, indent), ValueToJson(data).dump(indent)) << "indent " << indent;
+    }
+    EXPECT_EQ(JsonSerializer::Stringify(Value(std::numeric_limits<double>::infinity())), "null");
+}
+
 TEST(JsonSerializerTest, MergeNonObject)
 {
     // When base is not an object, overlay replaces it entirely
@@ -463,6 +1084,238 @@ TEST(JsonSerializerTest, GetAtPathNotAnObject)
     EXPECT_TRUE(cppfig::IsNotFound(result.status()));
 }
 
+TEST(FlatMapTest, KeepsKeysSorted)
+{
+    FlatMap<std::string, int> map;
+    EXPECT_TRUE(map.empty());
+
+    EXPECT_TRUE(map.try_emplace("b", 2).second);
+    EXPECT_TRUE(map.try_emplace("d", 4).second);
+    EXPECT_TRUE(map.try_emplace("a", 1).second);
+    EXPECT_TRUE(map.emplace("c", 3).second);
+    EXPECT_FALSE(map.try_emplace("b", 20).second);
+
+    std::string keys;
+    for (const auto& [key, value] : map) {
+        keys += key + "=" + std::to_string(value) + ";";
+    }
+    EXPECT_EQ(keys, "a=1;b=2;c=3;d=4;");
+    EXPECT_EQ(map.size(), 4U);
+}
+
+TEST(FlatMapTest, HeterogeneousLookupAndUpdate)
+{
+    FlatMap<std::string, int> map;
+    map["x"] = 1;
+    map[std::string_view("y")] = 2;
+    map["x"] += 10;
+
+    auto iter = map.find(std::string_view("x"));
+    ASSERT_NE(iter, map.end());
+    EXPECT_EQ(iter->second, 11);
+    EXPECT_EQ(map.find("missing"), map.end());
+    EXPECT_TRUE(map.contains("y"));
+
+    EXPECT_FALSE(map.insert_or_assign("y", 5).second);
+    EXPECT_EQ(map["y"], 5);
+
+    EXPECT_EQ(map.erase("x"), 1U);
+    EXPECT_EQ(map.erase("x"), 0U);
+    map.erase(map.begin());
+    EXPECT_TRUE(map.empty());
+}
+
+TEST(FlatMapTest, EqualityComparesEntries)
+{
+    FlatMap<std::string, int> lhs;
+    FlatMap<std::string, int> rhs;
+    lhs["a"] = 1;
+    lhs["b"] = 2;
+    rhs["b"] = 2;
+    rhs["a"] = 1;
+    EXPECT_TRUE(lhs == rhs);
+    rhs["a"] = 3;
+    EXPECT_FALSE(lhs == rhs);
+}
+
+TEST(ValueTest, CopyIsIndependentOfOriginal)
+{
+    auto original = Value::Object();
+    original.SetAtPath("server.host", "localhost");
+    original.SetAtPath("server.port", 8080);
+    original.SetAtPath("logging.level", "info");
+
+    Value copy = original;
+    copy.SetAtPath("server.port", 9090);
+    copy["logging"]["file"] = "app.log";
+
+    EXPECT_EQ(original.GetAtPath("server.port").value(), 8080);
+    EXPECT_FALSE(original.HasPath("logging.file"));
+    EXPECT_EQ(copy.GetAtPath("server.port").value(), 9090);
+    EXPECT_EQ(copy.GetAtPath("server.host").value(), "localhost");
+
+    original.SetAtPath("server.host", "example.com");
+    EXPECT_EQ(copy.GetAtPath("server.host").value(), "localhost");
+}
+
+TEST(ValueTest, CopySharesUntouchedSubtrees)
+{
+    auto original = Value::Object();
+    original.SetAtPath("a.x", 1);
+    original.SetAtPath("b.y", 2);
+
+    Value copy = original;
+    EXPECT_EQ(copy.FindAtPath("a.x"), original.FindAtPath("a.x"));
+
+    // Mutating a.x clones only the root and "a"; "b" stays shared
+    copy.SetAtPath("a.x", 10);
+    EXPECT_NE(copy.FindAtPath("a.x"), original.FindAtPath("a.x"));
+    EXPECT_EQ(copy.FindAtPath("b.y"), original.FindAtPath("b.y"));
+    EXPECT_EQ(original.GetAtPath("a.x").value(), 1);
+}
+
+TEST(ValueTest, MergeLeavesInputsUnchanged)
+{
+    auto base = Value::Object();
+    base.SetAtPath("a.b", 1);
+    auto overlay = Value::Object();
+    overlay.SetAtPath("a.c", 2);
+    const Value base_before = base;
+
+    auto merged = Value::Merge(base, overlay);
+    EXPECT_EQ(merged.GetAtPath("a.b").value(), 1);
+    EXPECT_EQ(merged.GetAtPath("a.c").value(), 2);
+    EXPECT_EQ(base, base_before);
+    EXPECT_FALSE(base.HasPath("a.c"));
+}
+
+TEST(ValueTest, FindAtPathBorrowsNode)
+{
+    auto data = Value::Object();
+    data.SetAtPath("a.b.c", 42);
+
+    const Value* found = data.FindAtPath("a.b.c");
+    ASSERT_NE(found, nullptr);
+    EXPECT_EQ(*found, 42);
+
+    // Object lookups return the node itself, not a copy
+    EXPECT_EQ(data.FindAtPath("a.b"), &data["a"]["b"]);
+    EXPECT_EQ(data.FindAtPath(""), &data);
+}
+
+TEST(ValueTest, FindAtPathMisses)
+{
+    auto data = Value::Object();
+    data.SetAtPath("a.b", 1);
+
+    EXPECT_EQ(data.FindAtPath("a.c"), nullptr);
+    EXPECT_EQ(data.FindAtPath("a.b.c"), nullptr);  // traverses a non-object
+    EXPECT_EQ(data.FindAtPath("x"), nullptr);
+    EXPECT_EQ(Value(5).FindAtPath("a"), nullptr);
+}
+
+TEST(ValueTest, FindKey)
+{
+    auto data = Value::Object();
+    data["key"] = Value("value");
+
+    ASSERT_NE(data.Find("key"), nullptr);
+    EXPECT_EQ(*data.Find("key"), "value");
+    EXPECT_EQ(data.Find("missing"), nullptr);
+    EXPECT_EQ(Value(1).Find("key"), nullptr);
+}
+
+TEST(ValueTest, GetAtPathErrorMessages)
+{
+    auto data = Value::Object();
+    data.SetAtPath("a.b", 1);
+
+    auto missing = data.GetAtPath("a.c");
+    EXPECT_EQ(missing.status().message(), "Path segment 'c' not found");
+
+    auto not_object = data.GetAtPath("a.b.c");
+    EXPECT_EQ(not_object.status().message(), "Path segment 'c' not found: parent is not an object");
+}
+
+TEST(ValueTest, SetAtPathEmptyPathIsNoOp)
+{
+    auto data = Value::Object();
+    data.SetAtPath("", 1);
+    EXPECT_TRUE(data.IsObject());
+    EXPECT_TRUE(data.Items().empty());
+}
+
+TEST(ValueTest, HashEqualForEqualValues)
+{
+    auto a = Value::Object();
+    a.SetAtPath("server.host", "localhost");
+    a.SetAtPath("server.port", 8080);
+    a.SetAtPath("ratio", -0.0);
+    auto b = Value::Object();
+    b.SetAtPath("ratio", 0.0);
+    b.SetAtPath("server.port", 8080);
+    b.SetAtPath("server.host", "localhost");
+
+    ASSERT_EQ(a, b);
+    EXPECT_EQ(a.Hash(), b.Hash());
+    EXPECT_EQ(Value::Object().Hash(), Value::Object().Hash());
+}
+
+TEST(ValueTest, HashDistinguishesStructure)
+{
+    auto swapped_a = Value::Object();
+    swapped_a["a"] = 1;
+    swapped_a["b"] = 2;
+    auto swapped_b = Value::Object();
+    swapped_b["a"] = 2;
+    swapped_b["b"] = 1;
+    EXPECT_NE(swapped_a.Hash(), swapped_b.Hash());
+
+    auto nested = Value::Object();
+    nested.SetAtPath("a.b", 1);
+    auto flat = Value::Object();
+    flat["a"] = 1;
+    flat["b"] = 1;
+    EXPECT_NE(nested.Hash(), flat.Hash());
+
+    auto empty_child = Value::Object();
+    empty_child["a"] = Value::Object();
+    EXPECT_NE(empty_child.Hash(), Value::Object().Hash());
+
+    EXPECT_NE(Value(1).Hash(), Value(1.0).Hash());
+    EXPECT_NE(Value(1).Hash(), Value("1").Hash());
+    EXPECT_NE(Value(true).Hash(), Value(false).Hash());
+    EXPECT_NE(Value("abcdefgh").Hash(), Value("abcdefgh1").Hash());
+    EXPECT_NE(Value(nullptr).Hash(), Value::Object().Hash());
+}
+
+TEST(ValueTest, HashingSetAtPathTracksHash)
+{
+    auto tree = Value::Object();
+    tree.SetAtPath("server.host", "localhost");
+    tree.SetAtPath("server.port", 8080);
+    tree.SetAtPath("flag", true);
+    std::uint64_t hash = tree.Hash();
+
+    const std::vector<std::pair<std::string, Value>> updates = {
+        { "server.port", 9090 },           // replace a scalar
+        { "server.tls.enabled", true },    // create intermediate objects
+        { "flag.nested", 1 },              // replace a scalar blocking the path
+        { "server", "collapsed" },         // replace a whole subtree
+        { "server.port", 8080 },           // rebuild it
+        { "server.port", 8080 },           // no-op write
+    };
+    for (const auto& [path, value] : updates) {
+        tree.SetAtPath(path, value, hash);
+        EXPECT_EQ(hash, tree.Hash()) << path;
+    }
+
+    auto scalar_root = Value(5);
+    hash = scalar_root.Hash();
+    scalar_root.SetAtPath("a.b", 1, hash);
+    EXPECT_EQ(hash, scalar_root.Hash());
+}
+
 TEST(ConfigDiffTest, NoDifferences)
 {
     auto a = Value::Object();
@@ -515,15 +1368,38 @@ TEST(ConfigDiffTest, ModifiedEntry)
     EXPECT_EQ(diff.Modified()[0].path, "a");
 }
 
+TEST(ConfigDiffTest, DiffPathsOnlyComparesGivenPaths)
+{
+    auto base = Value::Object();
+    base.SetAtPath("a.x", 1);
+    base.SetAtPath("a.y", 2);
+    base.SetAtPath("b", 3);
+    auto target = Value::Object();
+    target.SetAtPath("a.x", 10);
+    target.SetAtPath("b", 3);
+    target.SetAtPath("c", 4);
+    target.SetAtPath("ignored", 5);
+
+    const std::array<std::string_view, 4> paths = { "a.x", "a.y", "b", "c" };
+    auto diff = DiffPaths(base, target, paths);
+    ASSERT_EQ(diff.Size(), 3);
+    EXPECT_EQ(diff.entries[0].type, DiffType::Modified);
+    EXPECT_EQ(diff.entries[0].path, "a.x");
+    EXPECT_EQ(diff.entries[1].type, DiffType::Removed);
+    EXPECT_EQ(diff.entries[1].path, "a.y");
+    EXPECT_EQ(diff.entries[2].type, DiffType::Added);
+    EXPECT_EQ(diff.entries[2].path, "c");
+}
+
 TEST(ConfigDiffTest, DiffEntryTypeString)
 {
-    const DiffEntry added { .type = DiffType::Added, .path = "path", .old_value = "", .new_value = "value" };
+    const DiffEntry added { DiffType::Added, "path", Value(), Value("value") };
     EXPECT_EQ(added.TypeString(), "ADDED");
 
-    const DiffEntry removed { .type = DiffType::Removed, .path = "path", .old_value = "value", .new_value = "" };
+    const DiffEntry removed { DiffType::Removed, "path", Value("value"), Value() };
     EXPECT_EQ(removed.TypeString(), "REMOVED");
 
-    const DiffEntry modified { .type = DiffType::Modified, .path = "path", .old_value = "old", .new_value = "new" };
+    const DiffEntry modified { DiffType::Modified, "path", Value("old"), Value("new") };
     EXPECT_EQ(modified.TypeString(), "MODIFIED");
 }
 
@@ -549,7 +1425,7 @@ TEST(ConfigDiffTest, ToStringNoDifferences)
 TEST(ConfigDiffTest, ToStringWithAdded)
 {
     ConfigDiff diff;
-    diff.entries.push_back({ DiffType::Added, "new.setting", "", "42" });
+    diff.entries.push_back({ DiffType::Added, "new.setting", Value(), 42 });
 
     auto str = diff.ToString();
     EXPECT_NE(str.find("ADDED"), std::string::npos);
@@ -560,31 +1436,72 @@ TEST(ConfigDiffTest, ToStringWithAdded)
 TEST(ConfigDiffTest, ToStringWithRemoved)
 {
     ConfigDiff diff;
-    diff.entries.push_back({ DiffType::Removed, "old.setting", "\"value\"", "" });
+    diff.entries.push_back({ DiffType::Removed, "old.setting", Value("value"), Value() });
 
     auto str = diff.ToString();
     EXPECT_NE(str.find("REMOVED"), std::string::npos);
     EXPECT_NE(str.find("old.setting"), std::string::npos);
-    EXPECT_NE(str.find("was:"), std::string::npos);
+    EXPECT_NE(str.find("(was: \"value\")"), std::string::npos);
 }
 
 TEST(ConfigDiffTest, ToStringWithModified)
 {
     ConfigDiff diff;
-    diff.entries.push_back({ DiffType::Modified, "changed.setting", "1", "2" });
+    diff.entries.push_back({ DiffType::Modified, "changed.setting", 1, 2 });
 
     auto str = diff.ToString();
     EXPECT_NE(str.find("MODIFIED"), std::string::npos);
     EXPECT_NE(str.find("changed.setting"), std::string::npos);
-    EXPECT_NE(str.find("->"), std::string::npos);
+    EXPECT_NE(str.find(": 1 -> 2"), std::string::npos);
+}
+
+TEST(ConfigDiffTest, EntriesKeepValuesUnrendered)
+{
+    auto base = Value::Object();
+    base.SetAtPath("a.x", 1);
+    base.SetAtPath("a.y", "same");
+    auto target = base;
+    target.SetAtPath("a.x", 2);
+    target.SetAtPath("b", "new");
+
+    auto diff = DiffValues(base, target);
+    ASSERT_EQ(diff.Size(), 2);
+    EXPECT_EQ(diff.entries[0].path, "a.x");
+    static_assert(!std::is_constructible_v<DiffEntry, DiffType, std::string, const char*, const char*>,
+                  "entries built from rendered strings must not compile");
+    EXPECT_EQ(diff.entries[0].before, Value(1));
+    EXPECT_EQ(diff.entries[0].after, Value(2));
+    EXPECT_EQ(diff.entries[0].OldValue(), "1");
+    EXPECT_EQ(diff.entries[1].path, "b");
+    EXPECT_EQ(diff.entries[1].OldValue(), "");
+    EXPECT_EQ(diff.entries[1].NewValue(), "\"new\"");
+}
+
+TEST(ConfigDiffTest, DiffSchemaIgnoresUnknownPaths)
+{
+    using Schema = ConfigSchema<TestIntSetting>;
+
+    auto base = Value::Object();
+    base.SetAtPath("test.int", 1);
+    auto target = base;
+    target.SetAtPath("unknown", true);
+    EXPECT_FALSE(DiffSchema<Schema>(base, target).HasDifferences());
+    EXPECT_FALSE(PathDiffers(base, target, "test.int"));
+    EXPECT_TRUE(PathDiffers(base, target, "unknown"));
+
+    target.SetAtPath("test.int", 2);
+    auto diff = DiffSchema<Schema>(base, target);
+    ASSERT_EQ(diff.Size(), 1);
+    EXPECT_EQ(diff.entries[0].type, DiffType::Modified);
+    EXPECT_TRUE(PathDiffers(base, target, "test.int"));
 }
 
 TEST(ConfigDiffTest, FilterByType)
 {
     ConfigDiff diff;
-    diff.entries.push_back({ DiffType::Added, "a", "", "1" });
-    diff.entries.push_back({ DiffType::Removed, "b", "2", "" });
-    diff.entries.push_back({ DiffType::Added, "c", "", "3" });
+    diff.entries.push_back({ DiffType::Added, "a", Value(), 1 });
+    diff.entries.push_back({ DiffType::Removed, "b", 2, Value() });
+    diff.entries.push_back({ DiffType::Added, "c", Value(), 3 });
 
     auto added = diff.Filter(DiffType::Added);
     EXPECT_EQ(added.size(), 2);
@@ -807,6 +1724,151 @@ TEST(LoggerTest, ErrorFFormatted)
     EXPECT_NE(output.find("Error code: 500"), std::string::npos);
 }
 
+namespace {
+
+    class CollectingSink final : public LogSink {
+    public:
+        void Write(LogLevel level, std::string_view message) override
+        {
+            const std::lock_guard lock(mutex_);
+            messages_.emplace_back(level, std::string(message));
+        }
+
+        [[nodiscard]] auto Messages() -> std::vector<std::pair<LogLevel, std::string>>
+        {
+            const std::lock_guard lock(mutex_);
+            return messages_;
+        }
+
+    private:
+        std::mutex mutex_;
+        std::vector<std::pair<LogLevel, std::string>> messages_;
+    };
+
+}  // namespace
+
+TEST(LoggerTest, CustomSink)
+{
+    CollectingSink sink;
+    Logger::SetSink(&sink);
+    Logger::Warn("plain");
+    Logger::ErrorF("code %d", 7);
+    Logger::InfoF("%s", std::string(1000, 'x').c_str());
+    Logger::SetSink(nullptr);
+
+    const auto messages = sink.Messages();
+    ASSERT_EQ(messages.size(), 3U);
+    EXPECT_EQ(messages[0], (std::pair<LogLevel, std::string> { LogLevel::Warning, "plain" }));
+    EXPECT_EQ(messages[1], (std::pair<LogLevel, std::string> { LogLevel::Error, "code 7" }));
+    EXPECT_EQ(messages[2].second, std::string(1000, 'x'));
+}
+
+TEST(LoggerTest, SetSinkWaitsForWritersOfThePreviousSink)
+{
+    class CountingSink final : public LogSink {
+    public:
+        void Write(LogLevel /*level*/, std::string_view /*message*/) override
+        {
+            active.fetch_add(1);
+            std::this_thread::yield();
+            writes.fetch_add(1);
+            active.fetch_sub(1);
+        }
+
+        std::atomic<int> active { 0 };
+        std::atomic<int> writes { 0 };
+    };
+
+    std::array<CountingSink, 2> sinks;
+    CountingSink last;
+    std::atomic<bool> stop { false };
+    std::vector<std::jthread> writers;
+    for (int thread = 0; thread < 4; ++thread) {
+        writers.emplace_back([&stop] {
+            while (!stop.load(std::memory_order_relaxed)) {
+                Logger::Warn("message");
+            }
+        });
+    }
+
+    // Once SetSink returns, nobody may still be inside the previous sink
+    int busy = 0;
+    for (int i = 0; i < 200; ++i) {
+        Logger::SetSink(&sinks[static_cast<std::size_t>(i % 2)]);
+        busy += sinks[static_cast<std::size_t>((i + 1) % 2)].active.load();
+    }
+    Logger::SetSink(&last);
+    const int frozen = sinks[0].writes.load() + sinks[1].writes.load();
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    EXPECT_EQ(sinks[0].writes.load() + sinks[1].writes.load(), frozen);
+
+    stop.store(true);
+    writers.clear();
+    Logger::SetSink(nullptr);
+    EXPECT_EQ(busy, 0);
+    EXPECT_GT(last.writes.load(), 0);
+}
+
+TEST(LoggerTest, AsyncSinkForwardsFromManyThreads)
+{
+    constexpr int k_threads = 4;
+    constexpr int k_messages = 500;
+
+    CollectingSink downstream;
+    {
+        AsyncLogSink async(downstream, 4096);
+        std::vector<std::jthread> writers;
+        for (int thread = 0; thread < k_threads; ++thread) {
+            writers.emplace_back([&async, thread] {
+                for (int i = 0; i < k_messages; ++i) {
+                    async.Write(LogLevel::Warning, std::to_string(thread) + ":" + std::to_string(i));
+                }
+            });
+        }
+        writers.clear();
+        async.Flush();
+        EXPECT_EQ(downstream.Messages().size() + async.Dropped(), static_cast<std::size_t>(k_threads * k_messages));
+    }
+
+    // Messages of one producer keep their order
+    int last = -1;
+    for (const auto& [level, message] : downstream.Messages()) {
+        EXPECT_EQ(level, LogLevel::Warning);
+        if (message.starts_with("0:")) {
+            const int index = std::stoi(message.substr(2));
+            EXPECT_GT(index, last);
+            last = index;
+        }
+    }
+}
+
+TEST(LoggerTest, AsyncSinkDropsWhenFullAndTruncates)
+{
+    class BlockingSink final : public LogSink {
+    public:
+        void Write(LogLevel /*level*/, std::string_view message) override
+        {
+            release.wait(false);
+            lengths.push_back(message.size());
+        }
+        std::atomic<bool> release { false };
+        std::vector<std::size_t> lengths;
+    };
+
+    BlockingSink downstream;
+    {
+        AsyncLogSink async(downstream, 4);
+        for (int i = 0; i < 64; ++i) {
+            async.Write(LogLevel::Info, std::string(1000, 'y'));
+        }
+        EXPECT_GT(async.Dropped(), 0U);
+        downstream.release = true;
+        downstream.release.notify_all();
+    }
+    ASSERT_FALSE(downstream.lengths.empty());
+    EXPECT_EQ(downstream.lengths.front(), AsyncLogSink::k_max_message);
+}
+
 TEST(ValidatorTest, MinValidatorDouble)
 {
     auto validator = Min(5.0);
@@ -960,6 +2022,45 @@ TEST(ConfigTraitsTest, Int64FromJson)
     EXPECT_EQ(ConfigTraits<std::int64_t>::Deserialize(Value("invalid")), std::nullopt);
 }
 
+TEST(ConfigTraitsTest, VectorRoundTrip)
+{
+    const std::vector<int> ports = { 80, 443 };
+    const auto serialized = ConfigTraits<std::vector<int>>::Serialize(ports);
+    EXPECT_EQ(serialized.Integers().size(), 2U);
+    EXPECT_EQ(ConfigTraits<std::vector<int>>::Deserialize(serialized), ports);
+    EXPECT_EQ(ConfigTraits<std::vector<std::int64_t>>::Deserialize(serialized), (std::vector<std::int64_t> { 80, 443 }));
+    EXPECT_EQ(ConfigTraits<std::vector<double>>::Deserialize(serialized), (std::vector<double> { 80.0, 443.0 }));
+    EXPECT_EQ(ConfigTraits<std::vector<std::string>>::Deserialize(serialized), std::nullopt);
+    EXPECT_EQ(ConfigTraits<std::vector<int>>::Deserialize(Value(80)), std::nullopt);
+
+    const auto doubles = Value::Array(Value::DoubleArrayType { 0.5, 1.5 });
+    EXPECT_EQ(ConfigTraits<std::vector<float>>::Deserialize(doubles), (std::vector<float> { 0.5F, 1.5F }));
+    EXPECT_EQ(ConfigTraits<std::vector<int>>::Deserialize(doubles), std::nullopt);
+
+    const std::vector<std::vector<std::string>> groups = { { "a", "b" }, {} };
+    using GroupTraits = ConfigTraits<std::vector<std::vector<std::string>>>;
+    EXPECT_EQ(GroupTraits::Deserialize(GroupTraits::Serialize(groups)), groups);
+
+    using Triple = std::array<double, 3>;
+    const Triple weights = { 0.25, 0.5, 0.25 };
+    EXPECT_EQ(ConfigTraits<Triple>::Deserialize(ConfigTraits<Triple>::Serialize(weights)), weights);
+    EXPECT_EQ(ConfigTraits<Triple>::Deserialize(ConfigTraits<std::vector<int>>::Serialize(ports)), std::nullopt);
+}
+
+TEST(ConfigTraitsTest, VectorFromString)
+{
+    EXPECT_EQ(ConfigTraits<std::vector<int>>::FromString("[1, 2, 3]"), (std::vector<int> { 1, 2, 3 }));
+    EXPECT_EQ(ConfigTraits<std::vector<int>>::FromString("1,2"), (std::vector<int> { 1, 2 }));
+    EXPECT_EQ(ConfigTraits<std::vector<int>>::FromString(""), std::vector<int> {});
+    EXPECT_EQ(ConfigTraits<std::vector<int>>::FromString("1,x"), std::nullopt);
+    EXPECT_EQ(ConfigTraits<std::vector<std::string>>::FromString(R"(["a, b", c])"), (std::vector<std::string> { "a, b", "c" }));
+    EXPECT_EQ(ConfigTraits<std::vector<std::vector<int>>>::FromString("[[1], [2, 3]]"), (std::vector<std::vector<int>> { { 1 }, { 2, 3 } }));
+    EXPECT_EQ((ConfigTraits<std::array<int, 2>>::FromString("1, 2, 3")), std::nullopt);
+
+    const std::vector<std::string> hosts = { "a", "b" };
+    EXPECT_EQ(ConfigTraits<std::vector<std::string>>::FromString(ConfigTraits<std::vector<std::string>>::ToString(hosts)), hosts);
+}
+
 TEST(ConfigTraitsTest, Int64ToString)
 {
     EXPECT_EQ(ConfigTraits<std::int64_t>::ToString(123456789LL), "123456789");
@@ -1098,6 +2199,31 @@ TEST(ConfigurationTestFixtureTest, CreateTempFilePathDefault)
     EXPECT_NE(path.find(".conf"), std::string::npos);
 }
 
+TEST(ExecutionTest, ForEachShardRespectsMinimumShardSize)
+{
+    std::mutex mutex;
+    std::vector<std::pair<std::size_t, std::size_t>> shards;
+    auto record = [&mutex, &shards](std::size_t begin, std::size_t end) {
+        const std::lock_guard lock(mutex);
+        shards.emplace_back(begin, end);
+    };
+
+    // Too small for two shards: a single inline call
+    detail::ForEachShard(100, ExecutionPolicy::kParallel, 64, record);
+    ASSERT_EQ(shards.size(), 1U);
+    EXPECT_EQ(shards[0], (std::pair<std::size_t, std::size_t> { 0, 100 }));
+
+    shards.clear();
+    detail::ForEachShard(1000, ExecutionPolicy::kParallel, 64, record);
+    EXPECT_LE(shards.size(), 1000U / 64U);
+    std::size_t covered = 0;
+    for (const auto& [begin, end] : shards) {
+        EXPECT_GE(end - begin, 64U);
+        covered += end - begin;
+    }
+    EXPECT_EQ(covered, 1000U);
+}
+
 TEST(ConfigurationTestFixtureTest, CreateTempFilePathWithPrefix)
 {
     auto path = testing::ConfigurationTestFixture::CreateTempFilePath("my_prefix");